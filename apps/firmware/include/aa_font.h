@@ -0,0 +1,113 @@
+#ifndef AA_FONT_H
+#define AA_FONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "progmem_compat.h"
+
+// 比例寬度、2-bit alpha 的反鋸齒字型（由 tools/aa_font_convert.py 產生）。
+//
+// 每個字元佔 advance 像素寬的字格，墨水範圍 [xOffset, xOffset+width) x [yOffset, yOffset+height)
+// 一定落在字格內，字格之間不重疊，所以每一列都能逐字格直接展開、不需要讀回底圖。
+// 點陣以 2 bits/像素連續存放（高位元先，列與列之間不對齊），每個字形從 byte 邊界開始。
+struct AAGlyph {
+    uint16_t offset;  // 在 bitmap 中的起始 byte
+    uint8_t width;
+    uint8_t height;
+    uint8_t xOffset;
+    uint8_t yOffset;  // 相對行頂端
+    uint8_t advance;
+    uint8_t reserved;
+};
+
+struct AAFont {
+    const uint8_t* bitmap;   // PROGMEM
+    const AAGlyph* glyphs;   // PROGMEM，first..last
+    uint8_t first;
+    uint8_t last;
+    uint8_t lineHeight;
+};
+
+// 字型外的字元以第一個字形（轉檔工具固定為空白）代替
+static inline AAGlyph aaFontGlyph(const AAFont& font, char c) {
+    uint8_t code = (uint8_t)c;
+    if (code < font.first || code > font.last) code = font.first;
+
+    const AAGlyph* src = &font.glyphs[code - font.first];
+    AAGlyph glyph;
+    glyph.offset = pgm_read_word(&src->offset);
+    glyph.width = pgm_read_byte(&src->width);
+    glyph.height = pgm_read_byte(&src->height);
+    glyph.xOffset = pgm_read_byte(&src->xOffset);
+    glyph.yOffset = pgm_read_byte(&src->yOffset);
+    glyph.advance = pgm_read_byte(&src->advance);
+    glyph.reserved = 0;
+    return glyph;
+}
+
+static inline int32_t aaTextWidth(const AAFont& font, const char* str, size_t len) {
+    int32_t width = 0;
+    for (size_t i = 0; i < len; i++) {
+        width += aaFontGlyph(font, str[i]).advance;
+    }
+    return width;
+}
+
+// 把 fg 以 alpha/3 疊在 bg 上（RGB565 各通道分開計算）
+static inline uint16_t aaBlend565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    if (alpha == 0) return bg;
+    if (alpha >= 3) return fg;
+
+    const int32_t r = ((bg >> 11) & 0x1F) + ((int32_t)((fg >> 11) & 0x1F) - ((bg >> 11) & 0x1F)) * alpha / 3;
+    const int32_t g = ((bg >> 5) & 0x3F) + ((int32_t)((fg >> 5) & 0x3F) - ((bg >> 5) & 0x3F)) * alpha / 3;
+    const int32_t b = (bg & 0x1F) + ((int32_t)(fg & 0x1F) - (bg & 0x1F)) * alpha / 3;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// 背景色已知，四個 alpha 等級的顏色整段文字只算一次。
+// fg/bg 與輸出都是一般 RGB565，送往面板前由呼叫端轉成面板順序。
+static inline void aaBuildPalette(uint16_t palette[4], uint16_t fg, uint16_t bg) {
+    for (uint8_t a = 0; a < 4; a++) {
+        palette[a] = aaBlend565(fg, bg, a);
+    }
+}
+
+// 把字串第 row 列、可見欄 [c0, c1) 展開成像素，超過字串寬的部分補 palette[0]
+static inline void aaExpandTextRow(uint16_t* dst, const AAFont& font, const char* str, size_t len,
+                                   uint8_t row, int32_t c0, int32_t c1, const uint16_t palette[4]) {
+    int32_t cellStart = 0;
+    for (size_t i = 0; i < len && cellStart < c1; i++) {
+        const AAGlyph glyph = aaFontGlyph(font, str[i]);
+        const int32_t cellEnd = cellStart + glyph.advance;
+        if (cellEnd <= c0) {
+            cellStart = cellEnd;
+            continue;
+        }
+
+        const int32_t from = cellStart > c0 ? cellStart : c0;
+        const int32_t to = cellEnd < c1 ? cellEnd : c1;
+        const bool inkRow = row >= glyph.yOffset && row < glyph.yOffset + glyph.height;
+        const int32_t inkStart = cellStart + glyph.xOffset;
+        const int32_t inkEnd = inkStart + glyph.width;
+        const uint32_t bit = inkRow ? (uint32_t)(row - glyph.yOffset) * glyph.width * 2 : 0;
+        const uint8_t* bits = font.bitmap + glyph.offset;
+
+        for (int32_t col = from; col < to; col++) {
+            uint8_t alpha = 0;
+            if (inkRow && col >= inkStart && col < inkEnd) {
+                const uint32_t at = bit + (uint32_t)(col - inkStart) * 2;
+                alpha = (pgm_read_byte(&bits[at >> 3]) >> (6 - (at & 7))) & 3;
+            }
+            *dst++ = palette[alpha];
+        }
+        cellStart = cellEnd;
+    }
+
+    // 尾端補白
+    for (int32_t col = cellStart > c0 ? cellStart : c0; col < c1; col++) {
+        *dst++ = palette[0];
+    }
+}
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef AA_FONT_SANS14_H
+#define AA_FONT_SANS14_H
+
+#include "aa_font.h"
+
+// 由 tools/aa_font_convert.py 產生，請勿手動修改
+// 來源：Aileron Regular (CC0, Pillow built-in)，14 px，字元 32..126，行高 18，點陣 1451 bytes
+
+const uint8_t aa_font_sans14_bitmap[] PROGMEM = {
+    0x77,0x77,0x77,0x70,0x23,0x77,0x77,0x77,0x77,0x05,0x50,0x89,0x08,0x86,0xEE,0x19,
+    0x81,0x54,0xFF,0xE2,0x20,0x22,0x05,0x60,0x02,0x00,0x1D,0x02,0xFB,0x0D,0xCA,0x77,
+    0x14,0xEC,0x01,0xF9,0x01,0xED,0x07,0x1E,0x9C,0x77,0x76,0x8B,0xF8,0x07,0x00,0xBD,
+    0x06,0x35,0xC3,0x4D,0x72,0x82,0xF5,0xC0,0x00,0xD0,0x00,0xA7,0x90,0x37,0x5C,0x25,
+    0xC7,0x18,0x35,0xCD,0x07,0xD0,0x0B,0xF0,0x0E,0x00,0x07,0x00,0x40,0xD0,0x70,0x0F,
+    0xFF,0x8A,0x47,0x03,0x01,0xC1,0xC0,0x70,0x38,0x1C,0x06,0xFE,0x00,0x77,0x77,0x01,
+    0x09,0x18,0x24,0x34,0x30,0x70,0x70,0x34,0x34,0x28,0x0C,0x05,0x41,0x83,0x0A,0x18,
+    0x71,0xC7,0x1C,0xA2,0x5C,0x90,0x07,0x00,0x1C,0x06,0xBA,0x42,0xE0,0x18,0x90,0x80,
+    0x40,0x07,0x00,0x1C,0x00,0x70,0x2F,0xFE,0x07,0x00,0x1C,0x00,0x70,0x00,0x1C,0xD7,
+    0x00,0xBD,0xB0,0x02,0x02,0x06,0x09,0x08,0x18,0x24,0x30,0x60,0x90,0xC0,0x07,0xF4,
+    0x1D,0x1D,0x34,0x0A,0x34,0x07,0x70,0x07,0x70,0x07,0x34,0x07,0x34,0x0A,0x1D,0x1D,
+    0x07,0xF4,0x1B,0x7B,0x87,0x07,0x07,0x07,0x07,0x07,0x07,0x07,0x1F,0x87,0x0A,0x90,
+    0x74,0x07,0x00,0xA0,0x28,0x07,0x01,0xC0,0x74,0x0F,0xFF,0x0B,0xE0,0xE0,0xA6,0x01,
+    0xC0,0x0A,0x02,0xE0,0x00,0xA4,0x01,0xE8,0x07,0x74,0x78,0x6F,0x80,0x00,0xB0,0x07,
+    0xC0,0x37,0x02,0x5C,0x28,0x71,0xC1,0xCF,0xFF,0xC0,0x1C,0x00,0x70,0x01,0xC0,0x3F,
+    0xF8,0xC0,0x03,0x00,0x1E,0xF8,0x74,0x79,0x40,0x70,0x01,0xE8,0x07,0x74,0x78,0x6F,
+    0x40,0x06,0xF8,0x1D,0x0A,0x24,0x05,0x36,0xE4,0x79,0x1D,0x74,0x07,0x70,0x07,0x34,
+    0x07,0x2D,0x1D,0x0B,0xE4,0xFF,0xFC,0x00,0xA0,0x07,0x00,0x24,0x01,0xC0,0x0D,0x00,
+    0x70,0x03,0x40,0x1C,0x00,0xD0,0x00,0x1B,0xE0,0xE0,0xA7,0x01,0xCE,0x0A,0x1F,0xF0,
+    0xA0,0x97,0x01,0xCC,0x07,0x38,0x28,0x2F,0x80,0x0B,0xE0,0xA0,0x93,0x01,0x9C,0x07,
+    0x38,0x2C,0x6E,0x71,0x01,0xCD,0x0A,0x28,0x74,0x2F,0x40,0xE0,0x0B,0x32,0x00,0x00,
+    0x06,0x9C,0x01,0x91,0xA4,0xA4,0x0A,0x00,0x1E,0x00,0x1D,0x00,0x10,0xFF,0xF0,0x00,
+    0x00,0x0F,0xFF,0xE0,0x01,0xD0,0x01,0xD0,0x19,0x1A,0x0A,0x40,0x40,0x00,0x2F,0x8A,
+    0x0A,0xC0,0x70,0x0A,0x01,0xC0,0x60,0x08,0x00,0x40,0x08,0x00,0xC0,0x00,0xBF,0x80,
+    0x1E,0x06,0xC1,0xDB,0xA6,0x8A,0xA1,0xD7,0x37,0x47,0x1D,0xDC,0x18,0x77,0x74,0xE2,
+    0x4D,0x79,0xE4,0x28,0x00,0x00,0x38,0x0A,0x00,0x2F,0x90,0x00,0x01,0xE0,0x00,0xAC,
+    0x00,0x32,0x40,0x18,0x60,0x09,0x0C,0x03,0xFF,0x41,0x80,0xA0,0x90,0x1C,0x30,0x03,
+    0x5C,0x00,0xA0,0x7F,0xE0,0x70,0x2C,0x70,0x1C,0x70,0x28,0x7F,0xF0,0x70,0x19,0x70,
+    0x07,0x70,0x07,0x70,0x0A,0x7F,0xF8,0x02,0xF9,0x03,0x81,0xE2,0x80,0x1C,0xD0,0x01,
+    0x70,0x00,0x1C,0x00,0x03,0x40,0x04,0xA0,0x07,0x1E,0x07,0x41,0xBE,0x40,0x7F,0xE8,
+    0x1C,0x06,0x87,0x00,0x39,0xC0,0x07,0x70,0x01,0xDC,0x00,0x77,0x00,0x1D,0xC0,0x0D,
+    0x70,0x1A,0x1F,0xFD,0x00,0x7F,0xFC,0x70,0x00,0x70,0x00,0x70,0x00,0x7F,0xF8,0x70,
+    0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x7F,0xFD,0x7F,0xFD,0xC0,0x07,0x00,0x1C,0x00,
+    0x7F,0xF9,0xC0,0x07,0x00,0x1C,0x00,0x70,0x01,0xC0,0x00,0x02,0xF9,0x03,0x81,0xE2,
+    0x80,0x2C,0xD0,0x01,0x70,0x00,0x1C,0x0B,0xF3,0x40,0x1C,0xA0,0x0B,0x1E,0x06,0xC1,
+    0xBE,0x70,0x70,0x07,0x70,0x07,0x70,0x07,0x70,0x07,0x70,0x07,0x7F,0xFF,0x70,0x07,
+    0x70,0x07,0x70,0x07,0x70,0x07,0x77,0x77,0x77,0x77,0x77,0x00,0x1C,0x00,0x70,0x01,
+    0xC0,0x07,0x00,0x1C,0x00,0x72,0x01,0xDC,0x07,0x38,0x28,0x6F,0x80,0x70,0x0A,0x70,
+    0x28,0x70,0x70,0x71,0xC0,0x77,0x40,0x7F,0x40,0x75,0xD0,0x70,0xB0,0x70,0x28,0x70,
+    0x0E,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,
+    0x00,0x70,0x00,0x7F,0xFD,0x7C,0x00,0xF7,0xD0,0x1F,0x7A,0x02,0xB7,0x60,0x37,0x73,
+    0x06,0x77,0x24,0x97,0x71,0x8D,0x77,0x0D,0xC7,0x70,0xA8,0x77,0x07,0x47,0x7C,0x07,
+    0x7D,0x07,0x76,0x07,0x73,0x47,0x71,0x87,0x70,0xD7,0x70,0x67,0x70,0x37,0x70,0x2F,
+    0x70,0x0F,0x02,0xFE,0x00,0xE0,0x2C,0x28,0x00,0xE3,0x40,0x07,0x70,0x00,0x77,0x00,
+    0x07,0x34,0x00,0x72,0x80,0x0E,0x0E,0x02,0xC0,0x2F,0xE0,0x7F,0xE1,0xC0,0xA7,0x01,
+    0xDC,0x07,0x70,0x29,0xFF,0x87,0x00,0x1C,0x00,0x70,0x01,0xC0,0x00,0x02,0xFE,0x00,
+    0xE0,0x28,0x28,0x00,0xE3,0x40,0x07,0x70,0x00,0x77,0x00,0x07,0x34,0x00,0x72,0x80,
+    0x0E,0x0E,0x02,0x80,0x2F,0xFD,0x00,0x00,0x50,0x7F,0xF8,0x70,0x0A,0x70,0x07,0x70,
+    0x07,0x70,0x09,0x7F,0xF8,0x70,0x1D,0x70,0x0A,0x70,0x0A,0x70,0x07,0x0B,0xE0,0xD0,
+    0xE7,0x01,0x8D,0x00,0x1F,0x90,0x06,0xD0,0x02,0xE8,0x07,0x74,0x28,0x6F,0x80,0xFF,
+    0xFF,0x01,0xC0,0x01,0xC0,0x01,0xC0,0x01,0xC0,0x01,0xC0,0x01,0xC0,0x01,0xC0,0x01,
+    0xC0,0x01,0xC0,0x70,0x07,0x70,0x07,0x70,0x07,0x70,0x07,0x70,0x07,0x70,0x07,0x70,
+    0x07,0x34,0x07,0x28,0x1E,0x0B,0xF4,0x70,0x02,0x8D,0x00,0xD2,0x80,0x70,0x70,0x28,
+    0x0D,0x0D,0x02,0x47,0x00,0x62,0x80,0x0C,0xD0,0x02,0xB0,0x00,0x78,0x00,0xB0,0x0E,
+    0x01,0xDC,0x07,0xC0,0x63,0x42,0x74,0x28,0xA0,0xD9,0x0D,0x18,0x31,0x83,0x07,0x18,
+    0x71,0x80,0xD9,0x0D,0x90,0x27,0x42,0x74,0x06,0xC0,0x6C,0x01,0xE0,0x1E,0x00,0x34,
+    0x03,0x47,0x02,0x80,0xA1,0xC0,0x0D,0xD0,0x01,0xE0,0x00,0xB8,0x00,0x77,0x40,0x34,
+    0x70,0x28,0x0A,0x1C,0x00,0xD0,0x70,0x07,0x4A,0x02,0x81,0xC1,0xC0,0x28,0xA0,0x03,
+    0xB0,0x00,0xB4,0x00,0x1C,0x00,0x07,0x00,0x01,0xC0,0x00,0x70,0x00,0xFF,0xFC,0x00,
+    0xA0,0x0A,0x00,0x70,0x03,0x40,0x28,0x01,0xC0,0x0D,0x00,0x90,0x03,0xFF,0xF0,0x7E,
+    0x70,0x70,0x70,0x70,0x70,0x70,0x70,0x70,0x70,0x70,0x70,0x7E,0xC0,0x90,0x60,0x30,
+    0x24,0x18,0x08,0x09,0x06,0x02,0x02,0xBC,0x71,0xC7,0x1C,0x71,0xC7,0x1C,0x71,0xC7,
+    0xBC,0x0A,0x00,0xA0,0x15,0x82,0x08,0x60,0x99,0x02,0x7F,0xF4,0x49,0x0B,0xE4,0xA0,
+    0xB1,0x41,0xC1,0xAB,0x29,0x1D,0xC0,0x73,0x42,0xC7,0xE7,0x70,0x00,0x70,0x00,0x70,
+    0x00,0x76,0xF4,0x79,0x1D,0x74,0x0B,0x70,0x07,0x70,0x07,0x74,0x0A,0x79,0x1D,0x77,
+    0xE4,0x07,0xE0,0x1C,0x2C,0x34,0x09,0x70,0x00,0x70,0x00,0x34,0x08,0x2C,0x28,0x0B,
+    0xE0,0x00,0x07,0x00,0x07,0x00,0x07,0x07,0xE7,0x2D,0x1F,0x34,0x07,0x70,0x07,0x70,
+    0x07,0x34,0x0B,0x2D,0x1F,0x0B,0xE7,0x0B,0xE0,0x28,0x28,0x30,0x0C,0x7F,0xFD,0x70,
+    0x00,0x34,0x1C,0x28,0x28,0x0B,0xE0,0x2E,0x34,0x70,0xFE,0x70,0x70,0x70,0x70,0x70,
+    0x70,0x70,0x07,0xE7,0x2D,0x1F,0x34,0x07,0x70,0x07,0x70,0x07,0x34,0x0B,0x2D,0x1F,
+    0x0B,0xE7,0x24,0x07,0x28,0x1D,0x0B,0xF4,0x70,0x01,0xC0,0x07,0x00,0x1D,0xB9,0x78,
+    0x29,0xD0,0x77,0x01,0xDC,0x07,0x70,0x1D,0xC0,0x77,0x01,0xC0,0x23,0x07,0x77,0x77,
+    0x77,0x70,0x08,0x30,0x07,0x1C,0x71,0xC7,0x1C,0x71,0xC7,0x1D,0xE0,0x70,0x01,0xC0,
+    0x07,0x00,0x1C,0x0E,0x70,0xA1,0xCA,0x07,0xB0,0x1F,0xD0,0x72,0xC1,0xC2,0x87,0x03,
+    0x80,0x71,0xC7,0x1C,0x71,0xC7,0x1C,0x71,0xC3,0xC0,0x77,0xD7,0xD7,0x8B,0x8B,0x74,
+    0x74,0x77,0x07,0x07,0x70,0x70,0x77,0x07,0x07,0x70,0x70,0x77,0x07,0x07,0x76,0xE5,
+    0xE0,0xA7,0x41,0xDC,0x07,0x70,0x1D,0xC0,0x77,0x01,0xDC,0x07,0x0B,0xF4,0x2D,0x1D,
+    0x34,0x0A,0x70,0x07,0x70,0x07,0x34,0x0A,0x2D,0x1D,0x0B,0xF4,0x76,0xF4,0x79,0x1D,
+    0x74,0x0B,0x70,0x07,0x70,0x07,0x74,0x0A,0x79,0x1D,0x77,0xE4,0x70,0x00,0x70,0x00,
+    0x70,0x00,0x07,0xE7,0x2D,0x1F,0x34,0x07,0x70,0x07,0x70,0x07,0x34,0x0B,0x2D,0x1F,
+    0x0B,0xE7,0x00,0x07,0x00,0x07,0x00,0x07,0x77,0x5E,0x07,0x41,0xC0,0x70,0x1C,0x07,
+    0x01,0xC0,0x1F,0x83,0x4A,0x74,0x12,0xE4,0x06,0xE5,0x07,0x74,0xB1,0xF9,0x08,0x07,
+    0x07,0xF4,0x70,0x1C,0x07,0x01,0xC0,0x70,0x1D,0x02,0xD0,0x70,0x1D,0xC0,0x77,0x01,
+    0xDC,0x07,0x70,0x1D,0xC0,0xB3,0x87,0xC7,0xE7,0xA0,0x1D,0x80,0xA3,0x03,0x49,0x1C,
+    0x18,0xA0,0x33,0x40,0xA8,0x01,0xD0,0xE0,0x74,0x2A,0x82,0xE0,0x97,0x0D,0xC3,0x0D,
+    0x33,0x1C,0x29,0x89,0xA0,0x69,0x2A,0x40,0xF4,0x7C,0x02,0xC0,0xE0,0xA0,0x34,0xD2,
+    0x81,0xDC,0x02,0xD0,0x0B,0x40,0x67,0x03,0x4A,0x28,0x0D,0xA0,0x1D,0xC0,0xA3,0x43,
+    0x4A,0x0C,0x1C,0x60,0x36,0x40,0xAC,0x00,0xE0,0x03,0x40,0x18,0x03,0x80,0x00,0x3F,
+    0xF0,0x0A,0x02,0xC0,0x74,0x0E,0x02,0xC0,0xB4,0x0F,0xFF,0x2D,0xD7,0x1C,0x71,0xCD,
+    0x1C,0x71,0xC7,0x1D,0x2C,0x27,0x77,0x77,0x77,0x77,0x77,0x77,0x70,0xE1,0xC7,0x1C,
+    0x70,0xD2,0xCD,0x71,0xC7,0x1C,0xE0,0x2E,0x5D,0xD6,0xE0,
+};
+
+const AAGlyph aa_font_sans14_glyphs[] PROGMEM = {
+    {0, 0, 0, 0, 0, 3, 0},  // ' '
+    {0, 2, 10, 0, 4, 3, 0},  // '!'
+    {5, 4, 4, 1, 3, 6, 0},  // '"'
+    {9, 6, 10, 1, 4, 8, 0},  // '#'
+    {24, 7, 13, 1, 2, 9, 0},  // '$'
+    {47, 9, 10, 1, 4, 11, 0},  // '%'
+    {70, 9, 10, 0, 4, 9, 0},  // '&'
+    {93, 2, 4, 0, 3, 3, 0},  // "'"
+    {95, 4, 13, 1, 2, 5, 0},  // '('
+    {108, 3, 13, 0, 2, 5, 0},  // ')'
+    {118, 7, 6, 1, 7, 9, 0},  // '*'
+    {129, 7, 7, 1, 6, 9, 0},  // '+'
+    {142, 3, 3, 0, 13, 4, 0},  // ','
+    {145, 4, 1, 0, 9, 4, 0},  // '-'
+    {146, 1, 2, 1, 12, 3, 0},  // '.'
+    {147, 4, 11, 0, 3, 4, 0},  // '/'
+    {158, 8, 10, 0, 4, 8, 0},  // '0'
+    {178, 4, 10, 2, 4, 8, 0},  // '1'
+    {188, 6, 10, 1, 4, 8, 0},  // '2'
+    {203, 7, 10, 0, 4, 8, 0},  // '3'
+    {221, 7, 10, 1, 4, 8, 0},  // '4'
+    {239, 7, 10, 0, 4, 8, 0},  // '5'
+    {257, 8, 10, 0, 4, 8, 0},  // '6'
+    {277, 7, 10, 1, 4, 8, 0},  // '7'
+    {295, 7, 10, 0, 4, 8, 0},  // '8'
+    {313, 7, 10, 0, 4, 8, 0},  // '9'
+    {331, 1, 8, 1, 6, 3, 0},  // ':'
+    {333, 2, 10, 0, 6, 3, 0},  // ';'
+    {338, 6, 7, 1, 7, 8, 0},  // '<'
+    {349, 6, 4, 1, 7, 8, 0},  // '='
+    {355, 6, 7, 1, 7, 8, 0},  // '>'
+    {366, 6, 10, 1, 4, 8, 0},  // '?'
+    {381, 11, 11, 0, 5, 12, 0},  // '@'
+    {412, 9, 10, 0, 4, 9, 0},  // 'A'
+    {435, 8, 10, 1, 4, 10, 0},  // 'B'
+    {455, 9, 10, 0, 4, 10, 0},  // 'C'
+    {478, 9, 10, 1, 4, 11, 0},  // 'D'
+    {501, 8, 10, 1, 4, 9, 0},  // 'E'
+    {521, 7, 10, 1, 4, 8, 0},  // 'F'
+    {539, 9, 10, 0, 4, 10, 0},  // 'G'
+    {562, 8, 10, 1, 4, 10, 0},  // 'H'
+    {582, 2, 10, 1, 4, 4, 0},  // 'I'
+    {587, 7, 10, 0, 4, 8, 0},  // 'J'
+    {605, 8, 10, 1, 4, 9, 0},  // 'K'
+    {625, 8, 10, 1, 4, 9, 0},  // 'L'
+    {645, 10, 10, 1, 4, 12, 0},  // 'M'
+    {670, 8, 10, 1, 4, 10, 0},  // 'N'
+    {690, 10, 10, 0, 4, 11, 0},  // 'O'
+    {715, 7, 10, 1, 4, 9, 0},  // 'P'
+    {733, 10, 11, 0, 4, 11, 0},  // 'Q'
+    {761, 8, 10, 1, 4, 10, 0},  // 'R'
+    {781, 7, 10, 0, 4, 8, 0},  // 'S'
+    {799, 8, 10, 1, 4, 9, 0},  // 'T'
+    {819, 8, 10, 1, 4, 10, 0},  // 'U'
+    {839, 9, 10, 0, 4, 9, 0},  // 'V'
+    {862, 13, 10, 0, 4, 13, 0},  // 'W'
+    {895, 9, 10, 0, 4, 9, 0},  // 'X'
+    {918, 9, 10, 0, 4, 9, 0},  // 'Y'
+    {941, 7, 10, 1, 4, 9, 0},  // 'Z'
+    {959, 4, 13, 1, 2, 5, 0},  // '['
+    {972, 4, 11, 0, 3, 4, 0},  // backslash
+    {983, 3, 13, 0, 2, 4, 0},  // ']'
+    {993, 6, 6, 1, 5, 8, 0},  // '^'
+    {1002, 7, 1, 0, 14, 7, 0},  // '_'
+    {1004, 2, 2, 1, 3, 4, 0},  // '`'
+    {1005, 7, 8, 0, 6, 8, 0},  // 'a'
+    {1019, 8, 11, 0, 3, 9, 0},  // 'b'
+    {1041, 8, 8, 0, 6, 8, 0},  // 'c'
+    {1057, 8, 11, 0, 3, 9, 0},  // 'd'
+    {1079, 8, 8, 0, 6, 8, 0},  // 'e'
+    {1095, 4, 11, 0, 3, 4, 0},  // 'f'
+    {1106, 8, 11, 0, 6, 9, 0},  // 'g'
+    {1128, 7, 11, 0, 3, 8, 0},  // 'h'
+    {1148, 2, 11, 0, 3, 3, 0},  // 'i'
+    {1154, 3, 14, 0, 3, 4, 0},  // 'j'
+    {1165, 7, 11, 0, 3, 7, 0},  // 'k'
+    {1185, 3, 11, 0, 3, 3, 0},  // 'l'
+    {1194, 10, 8, 0, 6, 11, 0},  // 'm'
+    {1214, 7, 8, 0, 6, 8, 0},  // 'n'
+    {1228, 8, 8, 0, 6, 9, 0},  // 'o'
+    {1244, 8, 11, 0, 6, 9, 0},  // 'p'
+    {1266, 8, 11, 0, 6, 9, 0},  // 'q'
+    {1288, 5, 8, 0, 6, 5, 0},  // 'r'
+    {1298, 6, 8, 0, 6, 7, 0},  // 's'
+    {1310, 5, 10, 0, 4, 5, 0},  // 't'
+    {1323, 7, 8, 0, 6, 8, 0},  // 'u'
+    {1337, 7, 8, 0, 6, 7, 0},  // 'v'
+    {1351, 11, 8, 0, 6, 11, 0},  // 'w'
+    {1373, 7, 8, 0, 6, 7, 0},  // 'x'
+    {1387, 7, 11, 0, 6, 7, 0},  // 'y'
+    {1407, 6, 8, 1, 6, 8, 0},  // 'z'
+    {1419, 3, 13, 1, 2, 4, 0},  // '{'
+    {1429, 2, 15, 1, 2, 4, 0},  // '|'
+    {1437, 3, 13, 1, 2, 5, 0},  // '}'
+    {1447, 7, 2, 0, 9, 8, 0},  // '~'
+};
+
+const AAFont AA_FONT_SANS14 = {aa_font_sans14_bitmap, aa_font_sans14_glyphs, 32, 126, 18};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef BAND_RENDERER_H
+#define BAND_RENDERER_H
+
+#include <stdint.h>
+
+#include "damage_region.h"
+#include "tft_core.h"
+
+// 預設帶高：240x8 = 3.75 KB，整頁重畫 30 次 burst
+static const uint8_t TFT_DEFAULT_BAND_HEIGHT = 8;
+
+// 分帶渲染：ESP12 放不下 115 KB 的整頁 framebuffer，
+// 改成在 TFT_WIDTH x StripHeight 的小緩衝裡逐列合成，每滿一條就整條送出。
+// 每個矩形只開一個位址視窗、每個像素只寫一次，整頁重畫不會先清成黑色再補字。
+// StripHeight 越大 RAM 用越多、SPI burst 越長、呼叫次數越少。
+template <typename Tft, uint8_t StripHeight>
+class BandRenderer {
+    static_assert(StripHeight > 0, "StripHeight must be at least one row");
+
+public:
+    static const uint32_t BUFFER_PIXELS = (uint32_t)TFT_WIDTH * StripHeight;
+
+    explicit BandRenderer(Tft& tft) : _tft(tft) {}
+
+    // composeRow(uint16_t* dst, int16_t x0, int16_t x1, int16_t y)
+    // 要在 dst 寫出第 y 列 [x0, x1) 的面板順序像素
+    template <typename RowComposer>
+    void render(const DamageRect& rect, const RowComposer& composeRow) {
+        if (rect.empty()) return;
+
+        const uint16_t w = (uint16_t)(rect.x1 - rect.x0);
+        const uint32_t rowsPerStrip = BUFFER_PIXELS / w;
+
+        _tft.startWrite();
+        _tft.openWindow(rect.x0, rect.y0, w, rect.y1 - rect.y0);
+
+        uint32_t used = 0;
+        uint32_t rows = 0;
+        for (int16_t y = rect.y0; y < rect.y1; y++) {
+            composeRow(_band + used, rect.x0, rect.x1, y);
+            used += w;
+            if (++rows == rowsPerStrip) {
+                flushStrip(used);
+                used = 0;
+                rows = 0;
+            }
+        }
+        if (used > 0) {
+            flushStrip(used);
+        }
+        _tft.endWrite();
+    }
+
+    template <typename RowComposer>
+    void renderScreen(const RowComposer& composeRow) {
+        render(damageRect(0, 0, TFT_WIDTH, TFT_HEIGHT), composeRow);
+    }
+
+private:
+    Tft& _tft;
+    alignas(4) uint16_t _band[BUFFER_PIXELS];
+
+    void flushStrip(uint32_t pixels) {
+        _tft.writePixels(_band, pixels);
+        if (pixels > TFT_YIELD_PIXEL_THRESHOLD) {
+            _tft.bus().yieldCpu();
+        }
+    }
+};
+
+#endif
@@ -21,6 +21,15 @@ static const uint16_t DEVICE_ONLINE_DIRTY_MASK = 1U << 5;
 static const char MQTT_SENDER_TOPIC_PREFIX[] = "sys/agents/";
 static const char MQTT_SENDER_TOPIC_SUFFIX[] = "/metrics/v2";
 static const char MQTT_SENDER_DISCOVERY_TOPIC[] = "sys/agents/+/metrics/v2";
+// 二進位 v3 payload 走平行的 topic，與 v2 只差最後一個字元
+static const char MQTT_SENDER_TOPIC_SUFFIX_V3[] = "/metrics/v3";
+static const char MQTT_SENDER_DISCOVERY_TOPIC_V3[] = "sys/agents/+/metrics/v3";
+// collector 把多台的 v3 frame 打包成一則訊息，<host> 為 collector 名稱，格式見 metrics_batch.h
+static const char MQTT_BATCH_TOPIC_SUFFIX[] = "/metrics/batch";
+static const char MQTT_BATCH_DISCOVERY_TOPIC[] = "sys/agents/+/metrics/batch";
+
+static_assert(sizeof(MQTT_SENDER_TOPIC_SUFFIX) == sizeof(MQTT_SENDER_TOPIC_SUFFIX_V3),
+              "sender topic suffixes must have the same length");
 
 static inline uint32_t computeMqttReconnectDelayMs(uint8_t failureCount) {
     if (failureCount > 31) {
@@ -51,6 +60,16 @@ static inline bool isValidMqttPayloadLength(size_t payloadLen) {
     return payloadLen > 0 && payloadLen <= MQTT_MAX_PAYLOAD_BYTES;
 }
 
+// PubSubClient 的緩衝區（MQTT_MAX_PAYLOAD_BYTES）要放下整個 PUBLISH 封包：fixed header 1、
+// remaining length 最多 4、topic 長度 2 與 topic 本身，放不下的封包會被默默丟掉
+static const size_t MQTT_PUBLISH_HEADER_BYTES = 1U + 4U + 2U;
+
+// 發到 topic 的訊息 payload 最多能用幾個 bytes
+static inline size_t mqttPublishPayloadBudget(const char* topic) {
+    const size_t overhead = MQTT_PUBLISH_HEADER_BYTES + (topic ? strlen(topic) : 0);
+    return overhead < MQTT_MAX_PAYLOAD_BYTES ? MQTT_MAX_PAYLOAD_BYTES - overhead : 0;
+}
+
 static inline bool shouldEnterApModeAfterBootRetries(bool hasSavedWiFiConfig,
                                                      bool storageReady,
                                                      uint8_t recoveryCycles) {
@@ -96,30 +115,94 @@ static inline bool isValidSenderHostname(const char* hostStart, const char* host
     return true;
 }
 
+// sys/agents/<host>/metrics/v2 回傳 2，.../metrics/v3 回傳 3，其他回傳 0
+static inline uint8_t senderMetricsTopicVersion(const char* topic) {
+    if (!topic) {
+        return 0;
+    }
+
+    const size_t topicLen = strlen(topic);
+    const size_t prefixLen = sizeof(MQTT_SENDER_TOPIC_PREFIX) - 1;
+    const size_t suffixLen = sizeof(MQTT_SENDER_TOPIC_SUFFIX) - 1;
+
+    if (topicLen <= prefixLen + suffixLen) {
+        return 0;
+    }
+
+    if (strncmp(topic, MQTT_SENDER_TOPIC_PREFIX, prefixLen) != 0) {
+        return 0;
+    }
+
+    uint8_t version = 0;
+    if (strcmp(topic + topicLen - suffixLen, MQTT_SENDER_TOPIC_SUFFIX) == 0) {
+        version = 2;
+    } else if (strcmp(topic + topicLen - suffixLen, MQTT_SENDER_TOPIC_SUFFIX_V3) == 0) {
+        version = 3;
+    } else {
+        return 0;
+    }
+
+    const char* hostStart = topic + prefixLen;
+    const char* hostEnd = topic + topicLen - suffixLen;
+    return isValidSenderHostname(hostStart, hostEnd) ? version : 0;
+}
+
 static inline bool isValidSenderMetricsTopic(const char* topic) {
+    return senderMetricsTopicVersion(topic) != 0;
+}
+
+static inline bool isValidBatchMetricsTopic(const char* topic) {
     if (!topic) {
         return false;
     }
 
     const size_t topicLen = strlen(topic);
     const size_t prefixLen = sizeof(MQTT_SENDER_TOPIC_PREFIX) - 1;
-    const size_t suffixLen = sizeof(MQTT_SENDER_TOPIC_SUFFIX) - 1;
+    const size_t suffixLen = sizeof(MQTT_BATCH_TOPIC_SUFFIX) - 1;
 
     if (topicLen <= prefixLen + suffixLen) {
         return false;
     }
 
-    if (strncmp(topic, MQTT_SENDER_TOPIC_PREFIX, prefixLen) != 0) {
+    if (strncmp(topic, MQTT_SENDER_TOPIC_PREFIX, prefixLen) != 0 ||
+        strcmp(topic + topicLen - suffixLen, MQTT_BATCH_TOPIC_SUFFIX) != 0) {
         return false;
     }
 
-    if (strcmp(topic + topicLen - suffixLen, MQTT_SENDER_TOPIC_SUFFIX) != 0) {
+    return isValidSenderHostname(topic + prefixLen, topic + topicLen - suffixLen);
+}
+
+// sender topic 的 host 段是否剛好是 hostname（batch 內的設備比對 allowlist 用）
+static inline bool isSenderTopicForHost(const char* topic, const char* hostname) {
+    if (!hostname || !isValidSenderMetricsTopic(topic)) {
         return false;
     }
+    const size_t prefixLen = sizeof(MQTT_SENDER_TOPIC_PREFIX) - 1;
+    const size_t hostLen = strlen(topic) - prefixLen - (sizeof(MQTT_SENDER_TOPIC_SUFFIX) - 1);
+    return strlen(hostname) == hostLen && strncmp(topic + prefixLen, hostname, hostLen) == 0;
+}
 
-    const char* hostStart = topic + prefixLen;
-    const char* hostEnd = topic + topicLen - suffixLen;
-    return isValidSenderHostname(hostStart, hostEnd);
+// 同一台 sender 的 v2 與 v3 topic 視為相同（allowlist 只存 v2 的那一個）
+static inline bool isSameSenderMetricsHost(const char* a, const char* b) {
+    if (!isValidSenderMetricsTopic(a) || !isValidSenderMetricsTopic(b)) {
+        return false;
+    }
+    const size_t len = strlen(a);
+    return len == strlen(b) && strncmp(a, b, len - 1) == 0;
+}
+
+// 把合法的 sender topic 換成指定版本的 topic
+static inline bool senderMetricsTopicForVersion(const char* topic, uint8_t version, char* out, size_t outSize) {
+    if (!isValidSenderMetricsTopic(topic) || (version != 2 && version != 3)) {
+        return false;
+    }
+    const size_t len = strlen(topic);
+    if (!out || outSize <= len) {
+        return false;
+    }
+    memcpy(out, topic, len + 1);
+    out[len - 1] = (char)('0' + version);
+    return true;
 }
 
 static inline bool isValidSenderWildcardMetricsTopic(const char* topic) {
@@ -0,0 +1,126 @@
+#ifndef DAMAGE_REGION_H
+#define DAMAGE_REGION_H
+
+#include <stdint.h>
+
+#include "tft_core.h"
+
+// 合併兩個矩形時，允許多畫的（兩者都沒覆蓋到的）像素數。
+// 約等於多開一個視窗的成本（CASET/RASET/RAMWR 共 11 bytes）再加一點餘裕。
+static const int32_t DAMAGE_MERGE_SLACK_PIXELS = 32;
+
+// 半開區間 [x0, x1) x [y0, y1)
+struct DamageRect {
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+
+    int32_t area() const {
+        return empty() ? 0 : (int32_t)(x1 - x0) * (y1 - y0);
+    }
+};
+
+static inline DamageRect damageRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    DamageRect r = {x, y, (int16_t)(x + w), (int16_t)(y + h)};
+    return r;
+}
+
+static inline DamageRect damageUnion(const DamageRect& a, const DamageRect& b) {
+    DamageRect r = {
+        a.x0 < b.x0 ? a.x0 : b.x0,
+        a.y0 < b.y0 ? a.y0 : b.y0,
+        a.x1 > b.x1 ? a.x1 : b.x1,
+        a.y1 > b.y1 ? a.y1 : b.y1,
+    };
+    return r;
+}
+
+static inline DamageRect damageIntersect(const DamageRect& a, const DamageRect& b) {
+    DamageRect r = {
+        a.x0 > b.x0 ? a.x0 : b.x0,
+        a.y0 > b.y0 ? a.y0 : b.y0,
+        a.x1 < b.x1 ? a.x1 : b.x1,
+        a.y1 < b.y1 ? a.y1 : b.y1,
+    };
+    return r;
+}
+
+// 合併後多畫的像素數：union 減去兩者實際覆蓋的面積
+static inline int32_t damageMergeWaste(const DamageRect& a, const DamageRect& b) {
+    return damageUnion(a, b).area() - (a.area() + b.area() - damageIntersect(a, b).area());
+}
+
+// 一個畫面週期內的受損區域：最多 MaxRects 個矩形，
+// 重疊或相鄰（合併幾乎不多畫）的矩形會併成一個，滿了就併入代價最小的那個。
+template <uint8_t MaxRects>
+class DamageRegion {
+public:
+    void clear() { _count = 0; }
+
+    void addAll() {
+        _rects[0] = damageRect(0, 0, TFT_WIDTH, TFT_HEIGHT);
+        _count = 1;
+    }
+
+    void add(int16_t x, int16_t y, int16_t w, int16_t h) {
+        add(damageRect(x, y, w, h));
+    }
+
+    void add(DamageRect r) {
+        r = damageIntersect(r, damageRect(0, 0, TFT_WIDTH, TFT_HEIGHT));
+        if (r.empty()) return;
+
+        // 合併後的矩形可能又碰到別的矩形，所以重新掃一次
+        for (uint8_t i = 0; i < _count;) {
+            if (damageMergeWaste(r, _rects[i]) <= DAMAGE_MERGE_SLACK_PIXELS) {
+                r = damageUnion(r, _rects[i]);
+                removeAt(i);
+                i = 0;
+                continue;
+            }
+            i++;
+        }
+
+        if (_count == MaxRects) {
+            uint8_t best = 0;
+            int32_t bestWaste = damageMergeWaste(r, _rects[0]);
+            for (uint8_t i = 1; i < _count; i++) {
+                int32_t waste = damageMergeWaste(r, _rects[i]);
+                if (waste < bestWaste) {
+                    bestWaste = waste;
+                    best = i;
+                }
+            }
+            DamageRect merged = damageUnion(r, _rects[best]);
+            removeAt(best);
+            add(merged);
+            return;
+        }
+
+        _rects[_count++] = r;
+    }
+
+    uint8_t count() const { return _count; }
+    const DamageRect& rect(uint8_t index) const { return _rects[index]; }
+
+    int32_t area() const {
+        int32_t total = 0;
+        for (uint8_t i = 0; i < _count; i++) {
+            total += _rects[i].area();
+        }
+        return total;
+    }
+
+private:
+    DamageRect _rects[MaxRects];
+    uint8_t _count = 0;
+
+    void removeAt(uint8_t index) {
+        _rects[index] = _rects[--_count];
+    }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef DEVICE_VISIBILITY_H
+#define DEVICE_VISIBILITY_H
+
+#include <stdint.h>
+
+template <bool Wide>
+struct DeviceMaskType {
+    typedef uint32_t type;
+};
+
+template <>
+struct DeviceMaskType<true> {
+    typedef uint64_t type;
+};
+
+// 設備槽位的線上/啟用狀態位元圖，以及「線上且啟用」槽位依序排好的索引。
+// 狀態只在轉換時改位元，索引在下次查詢時才重建一次，輪播每圈的 count()/at() 都是 O(1)。
+template <uint8_t Slots>
+class DeviceVisibility {
+    static_assert(Slots > 0 && Slots <= 64, "DeviceVisibility supports up to 64 slots");
+
+public:
+    typedef typename DeviceMaskType<(Slots > 32)>::type Mask;
+
+    void clear() {
+        _online = 0;
+        _enabled = 0;
+        _count = 0;
+        _dirty = false;
+    }
+
+    void setOnline(uint8_t slot, bool online) { setBit(_online, slot, online); }
+    void setEnabled(uint8_t slot, bool enabled) { setBit(_enabled, slot, enabled); }
+
+    void setEnabledMask(Mask mask) {
+        if (mask == _enabled) return;
+        _enabled = mask;
+        _dirty = true;
+    }
+
+    bool isOnline(uint8_t slot) const { return (_online >> slot) & 1; }
+    Mask onlineMask() const { return _online; }
+    Mask enabledMask() const { return _enabled; }
+
+    uint8_t count() {
+        rebuildIfDirty();
+        return _count;
+    }
+
+    // 第 index 個可見的槽位（依槽位順序），超出範圍回傳 -1
+    int16_t at(uint8_t index) {
+        rebuildIfDirty();
+        return index < _count ? _order[index] : -1;
+    }
+
+    static Mask bit(uint8_t slot) { return (Mask)1 << slot; }
+
+    // 最低位的槽位，mask 不可為 0
+    static uint8_t lowestSlot(Mask mask) {
+        uint8_t slot = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            slot++;
+        }
+        return slot;
+    }
+
+private:
+    Mask _online = 0;
+    Mask _enabled = 0;
+    uint8_t _order[Slots] = {};
+    uint8_t _count = 0;
+    bool _dirty = false;
+
+    void setBit(Mask& mask, uint8_t slot, bool value) {
+        const Mask next = value ? (mask | bit(slot)) : (mask & ~bit(slot));
+        if (next == mask) return;
+        mask = next;
+        _dirty = true;
+    }
+
+    void rebuildIfDirty() {
+        if (!_dirty) return;
+        _count = 0;
+        for (Mask visible = _online & _enabled; visible; visible &= visible - 1) {
+            _order[_count++] = lowestSlot(visible);
+        }
+        _dirty = false;
+    }
+};
+
+#endif
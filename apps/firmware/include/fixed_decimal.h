@@ -0,0 +1,141 @@
+#ifndef FIXED_DECIMAL_H
+#define FIXED_DECIMAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "metrics_v2.h"
+
+// 純整數的十進位數字解析：從 ASCII 直接得到 x10 或四捨五入後的整數，不經過 float。
+// ESP8266 沒有 FPU，舊的 as<float>() + lroundf(value * 10.0f) 每個欄位都是軟體浮點運算。
+// 捨入為遠離 0 的四捨五入，以十進位字面值為準，不受 float 表示誤差影響。
+
+// 數字 token：尾數最多保留 19 位有效數字，其餘位數只影響 exponent
+struct FixedDecimal {
+    bool negative;
+    bool integral;       // 沒有小數點與指數
+    uint64_t mantissa;
+    int16_t exponent;    // 值 = mantissa * 10^exponent
+};
+
+static inline bool isDecimalDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// 超過 19 位有效數字時捨去：整數部分的位數改記在 exponent，小數部分直接丟掉
+static inline void appendDecimalDigit(FixedDecimal& n, uint8_t d, uint8_t& digits, int32_t& exponent, bool fraction) {
+    if (digits < 19) {
+        if (n.mantissa != 0 || d != 0) digits++;
+        n.mantissa = n.mantissa * 10 + d;
+        if (fraction) exponent--;
+    } else if (!fraction) {
+        exponent++;
+    }
+}
+
+// JSON 數字：-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+// 從 p 開始讀，不超過 end；回傳讀掉的字元數，不是數字時回傳 0
+static inline size_t scanFixedDecimal(const char* p, const char* end, FixedDecimal& n) {
+    const char* const start = p;
+    n.negative = p < end && *p == '-';
+    if (n.negative) p++;
+    n.integral = true;
+    n.mantissa = 0;
+    int32_t exponent = 0;
+    uint8_t digits = 0;
+
+    if (p >= end || !isDecimalDigit(*p)) return 0;
+    if (*p == '0') {
+        p++;
+    } else {
+        while (p < end && isDecimalDigit(*p)) {
+            appendDecimalDigit(n, (uint8_t)(*p++ - '0'), digits, exponent, false);
+        }
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        n.integral = false;
+        if (p >= end || !isDecimalDigit(*p)) return 0;
+        while (p < end && isDecimalDigit(*p)) {
+            appendDecimalDigit(n, (uint8_t)(*p++ - '0'), digits, exponent, true);
+        }
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        n.integral = false;
+        bool negativeExp = false;
+        if (p < end && (*p == '+' || *p == '-')) negativeExp = *p++ == '-';
+        if (p >= end || !isDecimalDigit(*p)) return 0;
+        int32_t e = 0;
+        while (p < end && isDecimalDigit(*p)) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+            p++;
+        }
+        exponent += negativeExp ? -e : e;
+    }
+
+    if (exponent < -1000) exponent = -1000;
+    if (exponent > 1000) exponent = 1000;
+    n.exponent = (int16_t)exponent;
+    return (size_t)(p - start);
+}
+
+// round(value * 10^scale)，遠離 0；結果夾在 ±1e9，兩種欄位的範圍都遠小於此
+static inline long roundFixedDecimal(const FixedDecimal& n, int8_t scale) {
+    const int32_t e = (int32_t)n.exponent + scale;
+    uint64_t magnitude;
+    if (n.mantissa == 0) {
+        magnitude = 0;
+    } else if (e >= 0) {
+        magnitude = n.mantissa;
+        for (int32_t i = 0; i < e; i++) {
+            if (magnitude > 100000000000ULL) {
+                magnitude = 1000000000000ULL;
+                break;
+            }
+            magnitude *= 10;
+        }
+    } else if (e < -19) {
+        magnitude = 0;
+    } else {
+        uint64_t divisor = 1;
+        for (int32_t i = 0; i < -e; i++) divisor *= 10;
+        magnitude = n.mantissa / divisor;
+        const uint64_t rem = n.mantissa % divisor;
+        if (rem >= divisor - rem) magnitude++;
+    }
+
+    if (magnitude > 1000000000ULL) magnitude = 1000000000ULL;
+    return n.negative ? -(long)magnitude : (long)magnitude;
+}
+
+static inline int16_t fixedDecimalToX10(const FixedDecimal& n) {
+    return clampI16(roundFixedDecimal(n, 1));
+}
+
+static inline uint16_t fixedDecimalToU16(const FixedDecimal& n) {
+    return clampU16(roundFixedDecimal(n, 0));
+}
+
+// text 整段必須是一個數字（不需 '\0' 結尾），否則回傳 false 且 out 不變
+inline bool parseScaledX10(const char* text, size_t length, int16_t& out) {
+    FixedDecimal n;
+    if (!text || length == 0 || scanFixedDecimal(text, text + length, n) != length) {
+        return false;
+    }
+    out = fixedDecimalToX10(n);
+    return true;
+}
+
+inline bool parseU16Value(const char* text, size_t length, uint16_t& out) {
+    FixedDecimal n;
+    if (!text || length == 0 || scanFixedDecimal(text, text + length, n) != length) {
+        return false;
+    }
+    out = fixedDecimalToU16(n);
+    return true;
+}
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef FONT_8X16_H
 #define FONT_8X16_H
 
-#include <Arduino.h>
+#include "progmem_compat.h"
 
 // 8x16 點陣字型 (ASCII 32-127)
 // 每個字元 16 bytes，每 byte 代表一行的 8 個像素
@@ -11,7 +11,8 @@
 #define FONT_FIRST_CHAR 32
 #define FONT_LAST_CHAR 127
 
-const uint8_t font_8x16[] PROGMEM = {
+// constexpr：讓 font_atlas_2x.h 能在編譯期由這份點陣產生放大字形
+constexpr uint8_t font_8x16[] PROGMEM = {
     // Space (32)
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
     // ! (33)
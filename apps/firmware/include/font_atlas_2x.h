@@ -0,0 +1,65 @@
+#ifndef FONT_ATLAS_2X_H
+#define FONT_ATLAS_2X_H
+
+#include <stdint.h>
+
+#include "font_8x16.h"
+#include "progmem_compat.h"
+
+// 2 倍字（16x32）預先放大的字形表，-DTFT_FONT_ATLAS_2X=0 可關閉以省下 flash
+#ifndef TFT_FONT_ATLAS_2X
+#define TFT_FONT_ATLAS_2X 1
+#endif
+
+// 監控畫面大字實際會用到的字元：數值、百分比、溫度與 CPU/RAM/GPU 標籤。
+// 其他字元（主機名稱、訊息）仍走一般的逐位元放大。
+static const char FONT_2X_CHARSET[] = " %-./0123456789:ACGMPRU";
+static const uint8_t FONT_2X_GLYPHS = sizeof(FONT_2X_CHARSET) - 1;
+static const uint8_t FONT_2X_NONE = 0xFF;
+
+// 每個位元複製成相鄰兩個位元：0b1011'0000 -> 0b11001111'00000000
+static inline constexpr uint16_t font2xStretchBits(uint8_t bits) {
+    uint16_t out = 0;
+    for (uint8_t b = 0; b < 8; b++) {
+        if (bits & (0x80 >> b)) {
+            out |= (uint16_t)(0xC000 >> (b * 2));
+        }
+    }
+    return out;
+}
+
+// 垂直放大只是每列重複兩次，所以每個字形存 FONT_HEIGHT 列 16 位元遮罩（32 bytes）
+struct Font2xAtlas {
+    uint16_t rows[FONT_2X_GLYPHS][FONT_HEIGHT];
+    uint8_t index[FONT_LAST_CHAR - FONT_FIRST_CHAR + 1];  // 字元 -> 字形編號，FONT_2X_NONE 表示不在表內
+};
+
+static inline constexpr Font2xAtlas makeFont2xAtlas() {
+    Font2xAtlas atlas = {};
+    for (uint16_t c = 0; c <= FONT_LAST_CHAR - FONT_FIRST_CHAR; c++) {
+        atlas.index[c] = FONT_2X_NONE;
+    }
+    for (uint8_t g = 0; g < FONT_2X_GLYPHS; g++) {
+        const uint16_t glyph = (uint8_t)FONT_2X_CHARSET[g] - FONT_FIRST_CHAR;
+        atlas.index[glyph] = g;
+        for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
+            atlas.rows[g][row] = font2xStretchBits(font_8x16[glyph * FONT_HEIGHT + row]);
+        }
+    }
+    return atlas;
+}
+
+// constexpr 保證在編譯期產生，直接放在 flash
+constexpr Font2xAtlas FONT_2X_ATLAS PROGMEM = makeFont2xAtlas();
+
+static inline uint8_t font2xGlyph(char c) {
+    const uint8_t code = (uint8_t)c;
+    if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR) return FONT_2X_NONE;
+    return pgm_read_byte(&FONT_2X_ATLAS.index[code - FONT_FIRST_CHAR]);
+}
+
+static inline uint16_t font2xRow(uint8_t glyph, uint8_t glyphRow) {
+    return pgm_read_word(&FONT_2X_ATLAS.rows[glyph][glyphRow]);
+}
+
+#endif
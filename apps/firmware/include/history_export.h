@@ -0,0 +1,97 @@
+#ifndef HISTORY_EXPORT_H
+#define HISTORY_EXPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "metric_history.h"
+
+// /api/v2/history 的二進位格式（little-endian，長度固定，見 docs/protocol/history-export.md）：
+//
+//   0  'M' 'H'
+//   2  版本 (1)
+//   3  指標數 (2：CPU、GPU 使用率)
+//   4  層數 (3)
+//   5  每層桶數
+//   6  每個代碼代表的 x10 百分比 (5 = 0.5%)
+//   7  保留 0
+//   8  每層 8 bytes：uint32 桶長 ms、uint32 目前這一桶開始至今的 ms（沒有資料為 0xFFFFFFFF）
+//   32 每層、每個指標各 桶數 x {min, max, mean}，舊到新；空桶為 {0xFF, 0, 0}
+//
+// 內容由 offset 直接算出，不需要暫存整份回應；AsyncWebServer 分段呼叫時各段彼此獨立。
+static const uint8_t HISTORY_EXPORT_VERSION = 1;
+static const uint8_t HISTORY_EXPORT_CHANNELS = 2;
+static const uint8_t HISTORY_EXPORT_TIERS = 3;
+static const size_t HISTORY_EXPORT_TIER_HEADER_BYTES = 8;
+static const size_t HISTORY_EXPORT_HEADER_BYTES = 8 + HISTORY_EXPORT_TIERS * HISTORY_EXPORT_TIER_HEADER_BYTES;
+static const size_t HISTORY_EXPORT_SECTION_BYTES = (size_t)DEVICE_HISTORY_TIER_BUCKETS * 3;
+static const size_t HISTORY_EXPORT_BYTES =
+    HISTORY_EXPORT_HEADER_BYTES + (size_t)HISTORY_EXPORT_TIERS * HISTORY_EXPORT_CHANNELS * HISTORY_EXPORT_SECTION_BYTES;
+
+template <typename Tier>
+static inline uint8_t historyExportTierHeaderByte(const Tier& tier, uint32_t nowMs, size_t at) {
+    const uint32_t value = at < 4 ? Tier::periodMs()
+                                  : (tier.size() ? nowMs - tier.openedAtMs() : 0xFFFFFFFFUL);
+    return (uint8_t)(value >> (8 * (at & 3)));
+}
+
+// 第 at 個 byte 落在某層某指標的桶區；桶數不足整層時前面補空桶
+template <typename Tier>
+static inline uint8_t historyExportBucketByte(const Tier& tier, size_t at) {
+    const uint8_t slot = (uint8_t)(at / 3);
+    const uint8_t pad = (uint8_t)(Tier::capacity() - tier.size());
+    if (slot < pad) return (at % 3) == 0 ? 0xFF : 0;
+
+    const HistoryBucket b = tier.bucket(slot - pad);
+    if (b.empty()) return (at % 3) == 0 ? 0xFF : 0;
+    switch (at % 3) {
+        case 0: return b.min;
+        case 1: return b.max;
+        default: return b.mean;
+    }
+}
+
+template <typename Fn>
+static inline uint8_t historyExportVisitTier(const HistoryTiers<PercentX10Codec>& tiers, uint8_t index, Fn fn) {
+    if (index == 0) return fn(tiers.seconds);
+    if (index == 1) return fn(tiers.tenSeconds);
+    return fn(tiers.minutes);
+}
+
+// 把從 offset 開始的內容寫入 buf，回傳寫入的 bytes；offset 超過結尾時回傳 0
+static inline size_t historyExportRead(const DeviceHistory& history, uint32_t nowMs,
+                                       size_t offset, uint8_t* buf, size_t maxLen) {
+    const HistoryTiers<PercentX10Codec>* channels[HISTORY_EXPORT_CHANNELS] = {
+        &history.cpuTiers, &history.gpuTiers};
+
+    size_t written = 0;
+    while (written < maxLen && offset < HISTORY_EXPORT_BYTES) {
+        uint8_t value = 0;
+        if (offset < 8) {
+            static const uint8_t fixed[8] = {'M', 'H', HISTORY_EXPORT_VERSION, HISTORY_EXPORT_CHANNELS,
+                                             HISTORY_EXPORT_TIERS, DEVICE_HISTORY_TIER_BUCKETS, 5, 0};
+            value = fixed[offset];
+        } else if (offset < HISTORY_EXPORT_HEADER_BYTES) {
+            const size_t at = offset - 8;
+            // 各層的起點以 CPU 為準，GPU 與 CPU 同一筆 frame 寫入
+            value = historyExportVisitTier(history.cpuTiers, (uint8_t)(at / HISTORY_EXPORT_TIER_HEADER_BYTES),
+                                           [&](const auto& tier) {
+                                               return historyExportTierHeaderByte(
+                                                   tier, nowMs, at % HISTORY_EXPORT_TIER_HEADER_BYTES);
+                                           });
+        } else {
+            const size_t at = offset - HISTORY_EXPORT_HEADER_BYTES;
+            const size_t section = at / HISTORY_EXPORT_SECTION_BYTES;
+            const uint8_t tierIndex = (uint8_t)(section / HISTORY_EXPORT_CHANNELS);
+            const uint8_t channel = (uint8_t)(section % HISTORY_EXPORT_CHANNELS);
+            value = historyExportVisitTier(*channels[channel], tierIndex, [&](const auto& tier) {
+                return historyExportBucketByte(tier, at % HISTORY_EXPORT_SECTION_BYTES);
+            });
+        }
+        buf[written++] = value;
+        offset++;
+    }
+    return written;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef HOSTNAME_INDEX_H
+#define HOSTNAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// 每則 MQTT 訊息只算一次 hostname 的 hash，之後設備與設定各查一次表
+struct HostKey {
+    const char* name;
+    uint32_t hash;
+};
+
+// FNV-1a 32-bit
+static inline uint32_t hostnameHash(const char* name) {
+    uint32_t h = 2166136261UL;
+    if (!name) return h;
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+static inline HostKey hostKey(const char* name) {
+    return HostKey{name, hostnameHash(name)};
+}
+
+// 從不以 '\0' 結尾的位元組複製 hostname 到 out（至少 length + 1 bytes），複製時順便算 hash
+static inline HostKey copyHostKey(char* out, const char* src, size_t length) {
+    uint32_t h = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        out[i] = src[i];
+        h ^= (uint8_t)src[i];
+        h *= 16777619UL;
+    }
+    out[length] = '\0';
+    return HostKey{out, h};
+}
+
+// 大於等於 2 * capacity 的 2 的冪，負載不超過一半，探測長度短
+static constexpr uint16_t hostnameIndexSlots(uint16_t capacity, uint16_t slots = 4) {
+    return slots >= capacity * 2 ? slots : hostnameIndexSlots(capacity, (uint16_t)(slots * 2));
+}
+
+// hostname -> 陣列位置的開放定址表（線性探測）。
+// 表內只存 hash 與位置，字串仍放在原陣列，由 nameOf(item) 取回比對，hash 不同時不做 strcmp。
+// 不支援單筆刪除：陣列內容整批換掉時 clear() 後重新 insert。
+template <uint8_t Capacity>
+class HostnameIndex {
+public:
+    static const uint16_t SLOTS = hostnameIndexSlots(Capacity);
+    static const uint8_t EMPTY = 0xFF;
+
+    static_assert(Capacity < EMPTY, "HostnameIndex capacity must leave 0xFF as the empty marker");
+
+    HostnameIndex() { clear(); }
+
+    void clear() {
+        memset(_items, EMPTY, sizeof(_items));
+        _count = 0;
+    }
+
+    uint8_t size() const { return _count; }
+
+    // item 已存在同名的項目時由呼叫端先 find 避免重複；表滿時回傳 false
+    bool insert(uint32_t hash, uint8_t item) {
+        if (_count >= Capacity || item == EMPTY) return false;
+        uint16_t pos = (uint16_t)(hash & (SLOTS - 1));
+        while (_items[pos] != EMPTY) {
+            pos = (uint16_t)((pos + 1) & (SLOTS - 1));
+        }
+        _hashes[pos] = hash;
+        _items[pos] = item;
+        _count++;
+        return true;
+    }
+
+    // 找不到回傳 -1
+    template <typename NameOf>
+    int16_t find(const HostKey& key, NameOf nameOf) const {
+        if (!key.name) return -1;
+        uint16_t pos = (uint16_t)(key.hash & (SLOTS - 1));
+        while (_items[pos] != EMPTY) {
+            if (_hashes[pos] == key.hash && strcmp(nameOf(_items[pos]), key.name) == 0) {
+                return _items[pos];
+            }
+            pos = (uint16_t)((pos + 1) & (SLOTS - 1));
+        }
+        return -1;
+    }
+
+private:
+    uint32_t _hashes[SLOTS];
+    uint8_t _items[SLOTS];
+    uint8_t _count = 0;
+};
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef METRIC_HISTORY_H
+#define METRIC_HISTORY_H
+
+#include <stdint.h>
+
+#include "metrics_v2.h"
+
+// 每台設備每個指標保留的取樣數（每收到一筆 frame 一筆），也是 sparkline 的欄數。
+// 每個指標約佔 3 * DEVICE_HISTORY_SAMPLES bytes（取樣 + 最小/最大值佇列）
+#ifndef DEVICE_HISTORY_SAMPLES
+#define DEVICE_HISTORY_SAMPLES 32
+#endif
+
+static_assert(DEVICE_HISTORY_SAMPLES > 0 && DEVICE_HISTORY_SAMPLES <= 255,
+              "DEVICE_HISTORY_SAMPLES must fit the uint8_t ring indices");
+
+// 8-bit 量化：每個指標一種 codec，encode 必須單調遞增，最小/最大值才能直接比較代碼
+
+// x10 百分比 -> 0.5% 一階，0..200
+struct PercentX10Codec {
+    static const uint8_t MAX_CODE = 200;
+
+    static uint8_t encode(int32_t x10) {
+        if (x10 <= 0) return 0;
+        int32_t code = (x10 + 2) / 5;
+        return code > MAX_CODE ? MAX_CODE : (uint8_t)code;
+    }
+
+    static int32_t decode(uint8_t code) { return (int32_t)code * 5; }
+};
+
+// x10 攝氏 -> 0.5°C 一階，0..127.5°C
+struct TempX10Codec {
+    static const uint8_t MAX_CODE = 255;
+
+    static uint8_t encode(int32_t x10) {
+        if (x10 <= 0) return 0;
+        int32_t code = (x10 + 2) / 5;
+        return code > MAX_CODE ? MAX_CODE : (uint8_t)code;
+    }
+
+    static int32_t decode(uint8_t code) { return (int32_t)code * 5; }
+};
+
+// 0..65535 的流量 -> 4-bit 指數 + 4-bit 尾數的小浮點，誤差約 3%；16 以下精確
+struct RateCodec {
+    static const uint8_t MAX_CODE = 207;
+
+    static uint8_t encode(int32_t value) {
+        if (value <= 0) return 0;
+        if (value > 65535) value = 65535;
+        if (value < 16) return (uint8_t)value;
+
+        uint8_t exponent = 0;
+        while ((value >> exponent) > 31) exponent++;
+        return (uint8_t)(((exponent + 1) << 4) | ((value >> exponent) & 0x0F));
+    }
+
+    // 回傳區間中點
+    static int32_t decode(uint8_t code) {
+        if (code < 16) return code;
+        const uint8_t exponent = (uint8_t)((code >> 4) - 1);
+        const int32_t base = (int32_t)((code & 0x0F) | 0x10) << exponent;
+        return exponent == 0 ? base : base + (1 << (exponent - 1));
+    }
+};
+
+// 固定容量的量化取樣窗：滿了覆蓋最舊的一筆，不配置記憶體。
+// 最小/最大值用單調佇列、平均用累加和，push 攤提 O(1)，查詢 O(1)。
+template <uint8_t Window, typename Codec>
+class MetricSeries {
+    static_assert(Window > 0, "MetricSeries needs at least one sample");
+
+public:
+    void clear() {
+        _head = 0;
+        _count = 0;
+        _minFront = _minLen = 0;
+        _maxFront = _maxLen = 0;
+        _sum = 0;
+    }
+
+    void push(int32_t raw) {
+        const uint8_t code = Codec::encode(raw);
+
+        if (_count == Window) {
+            // _head 是最舊的一筆，先移出窗外
+            if (_minLen && _minQ[_minFront] == _head) popFront(_minFront, _minLen);
+            if (_maxLen && _maxQ[_maxFront] == _head) popFront(_maxFront, _maxLen);
+            _sum -= (uint32_t)Codec::decode(_codes[_head]);
+        } else {
+            _count++;
+        }
+
+        _codes[_head] = code;
+        _sum += (uint32_t)Codec::decode(code);
+
+        // 佇列裡比新值差的舊值不可能再成為最小/最大值
+        while (_minLen && _codes[back(_minFront, _minLen, _minQ)] >= code) _minLen--;
+        pushBack(_minQ, _minFront, _minLen, _head);
+        while (_maxLen && _codes[back(_maxFront, _maxLen, _maxQ)] <= code) _maxLen--;
+        pushBack(_maxQ, _maxFront, _maxLen, _head);
+
+        _head = (uint8_t)((_head + 1) % Window);
+    }
+
+    uint8_t size() const { return _count; }
+    static uint8_t capacity() { return Window; }
+    static uint8_t maxCode() { return Codec::MAX_CODE; }
+
+    // 0 為最舊的一筆，size()-1 為最新
+    uint8_t at(uint8_t index) const {
+        const uint8_t start = _count < Window ? 0 : _head;
+        return _codes[(uint8_t)((start + index) % Window)];
+    }
+
+    int32_t value(uint8_t index) const { return Codec::decode(at(index)); }
+    int32_t latest() const { return _count ? value(_count - 1) : 0; }
+
+    // 以下在沒有取樣時回傳 0
+    int32_t min() const { return _minLen ? Codec::decode(_codes[_minQ[_minFront]]) : 0; }
+    int32_t max() const { return _maxLen ? Codec::decode(_codes[_maxQ[_maxFront]]) : 0; }
+
+    int32_t mean() const {
+        return _count ? (int32_t)((_sum + _count / 2) / _count) : 0;
+    }
+
+private:
+    uint8_t _codes[Window] = {};
+    uint8_t _minQ[Window] = {};  // 取樣位置，代碼嚴格遞增
+    uint8_t _maxQ[Window] = {};  // 取樣位置，代碼嚴格遞減
+    uint32_t _sum = 0;           // 窗內解碼值的總和
+    uint8_t _head = 0;
+    uint8_t _count = 0;
+    uint8_t _minFront = 0;
+    uint8_t _minLen = 0;
+    uint8_t _maxFront = 0;
+    uint8_t _maxLen = 0;
+
+    static uint8_t back(uint8_t front, uint8_t len, const uint8_t* queue) {
+        return queue[(uint8_t)((front + len - 1) % Window)];
+    }
+
+    static void popFront(uint8_t& front, uint8_t& len) {
+        front = (uint8_t)((front + 1) % Window);
+        len--;
+    }
+
+    static void pushBack(uint8_t* queue, uint8_t front, uint8_t& len, uint8_t pos) {
+        queue[(uint8_t)((front + len) % Window)] = pos;
+        len++;
+    }
+};
+
+typedef MetricSeries<DEVICE_HISTORY_SAMPLES, PercentX10Codec> PercentSeries;
+typedef MetricSeries<DEVICE_HISTORY_SAMPLES, TempX10Codec> TempSeries;
+typedef MetricSeries<DEVICE_HISTORY_SAMPLES, RateCodec> RateSeries;
+
+// 分層歷史每層的桶數；預設 60 x 1s、60 x 10s、60 x 1min，最長涵蓋一小時
+#ifndef DEVICE_HISTORY_TIER_BUCKETS
+#define DEVICE_HISTORY_TIER_BUCKETS 60
+#endif
+
+// 一個時間桶內取樣的最小/最大/平均代碼；min > max 表示這段時間沒有取樣
+struct HistoryBucket {
+    uint8_t min;
+    uint8_t max;
+    uint8_t mean;
+
+    bool empty() const { return min > max; }
+};
+
+// 以時間切桶的環形緩衝：目前這一桶隨每筆取樣就地更新，跨過 PeriodMs 才前進。
+// 桶邊界對齊 PeriodMs 的整數倍，各層的桶彼此對得上；只用時間差計算，millis() 溢位也正確。
+template <uint8_t Buckets, uint32_t PeriodMs, typename Codec>
+class HistoryTier {
+    static_assert(Buckets > 0 && PeriodMs > 0, "HistoryTier needs buckets and a period");
+
+public:
+    void clear() {
+        _head = 0;
+        _count = 0;
+        _startMs = 0;
+        _sum = 0;
+        _samples = 0;
+    }
+
+    void add(uint8_t code, uint32_t nowMs) {
+        if (_count == 0) {
+            _count = 1;
+            _head = 0;
+            _startMs = nowMs - nowMs % PeriodMs;
+            resetOpenBucket();
+        } else {
+            const uint32_t steps = (nowMs - _startMs) / PeriodMs;
+            if (steps > 0) {
+                // 中間沒有收到 frame 的時段補空桶；超過整層就等於整層都是空桶
+                const uint32_t gaps = steps - 1 < Buckets ? steps - 1 : Buckets;
+                for (uint32_t i = 0; i <= gaps; i++) advance();
+                _startMs += steps * PeriodMs;
+            }
+        }
+
+        HistoryBucket& bucket = _buckets[_head];
+        if (code < bucket.min) bucket.min = code;
+        if (code > bucket.max) bucket.max = code;
+        _sum += code;
+        _samples++;
+        bucket.mean = (uint8_t)((_sum + _samples / 2) / _samples);
+    }
+
+    uint8_t size() const { return _count; }
+    static uint8_t capacity() { return Buckets; }
+    static uint8_t maxCode() { return Codec::MAX_CODE; }
+    static uint32_t periodMs() { return PeriodMs; }
+
+    // 0 為最舊的桶，size()-1 為目前正在累積的桶
+    HistoryBucket bucket(uint8_t index) const {
+        const uint8_t start = _count < Buckets ? 0 : (uint8_t)((_head + 1) % Buckets);
+        return _buckets[(uint8_t)((start + index) % Buckets)];
+    }
+
+    // 給 Sparkline 用的平均代碼，空桶為 0
+    uint8_t at(uint8_t index) const {
+        const HistoryBucket b = bucket(index);
+        return b.empty() ? 0 : b.mean;
+    }
+
+    // 目前這一桶的起點（millis()）
+    uint32_t openedAtMs() const { return _startMs; }
+
+private:
+    HistoryBucket _buckets[Buckets] = {};
+    uint32_t _startMs = 0;
+    uint32_t _sum = 0;       // 目前這一桶的代碼總和
+    uint16_t _samples = 0;   // 目前這一桶的取樣數
+    uint8_t _head = 0;       // 目前這一桶
+    uint8_t _count = 0;
+
+    void advance() {
+        _head = (uint8_t)((_head + 1) % Buckets);
+        if (_count < Buckets) _count++;
+        resetOpenBucket();
+    }
+
+    void resetOpenBucket() {
+        _buckets[_head].min = 0xFF;
+        _buckets[_head].max = 0;
+        _buckets[_head].mean = 0;
+        _sum = 0;
+        _samples = 0;
+    }
+};
+
+// 同一個指標的三層歷史，每筆取樣只量化一次
+template <typename Codec>
+struct HistoryTiers {
+    HistoryTier<DEVICE_HISTORY_TIER_BUCKETS, 1000UL, Codec> seconds;
+    HistoryTier<DEVICE_HISTORY_TIER_BUCKETS, 10000UL, Codec> tenSeconds;
+    HistoryTier<DEVICE_HISTORY_TIER_BUCKETS, 60000UL, Codec> minutes;
+
+    void clear() {
+        seconds.clear();
+        tenSeconds.clear();
+        minutes.clear();
+    }
+
+    void add(int32_t raw, uint32_t nowMs) {
+        const uint8_t code = Codec::encode(raw);
+        seconds.add(code, nowMs);
+        tenSeconds.add(code, nowMs);
+        minutes.add(code, nowMs);
+    }
+};
+
+// 一台設備的所有歷史：百分比與溫度為 x10，流量為 kbps / KB/s，與 MetricsFrameV2 相同單位。
+// 每個指標都有最近 DEVICE_HISTORY_SAMPLES 筆的原始取樣；CPU/GPU 使用率另有一小時的分層歷史
+struct DeviceHistory {
+    PercentSeries cpuPct;
+    TempSeries cpuTemp;
+    PercentSeries ramPct;
+    PercentSeries gpuPct;
+    TempSeries gpuTemp;
+    RateSeries netRx;
+    RateSeries netTx;
+    RateSeries diskRead;
+    RateSeries diskWrite;
+    HistoryTiers<PercentX10Codec> cpuTiers;
+    HistoryTiers<PercentX10Codec> gpuTiers;
+
+    void clear() {
+        cpuPct.clear();
+        cpuTemp.clear();
+        ramPct.clear();
+        gpuPct.clear();
+        gpuTemp.clear();
+        netRx.clear();
+        netTx.clear();
+        diskRead.clear();
+        diskWrite.clear();
+        cpuTiers.clear();
+        gpuTiers.clear();
+    }
+
+    void record(const MetricsFrameV2& frame, uint32_t nowMs) {
+        cpuPct.push(frame.cpuPctX10);
+        cpuTemp.push(frame.cpuTempCX10);
+        ramPct.push(frame.ramPctX10);
+        gpuPct.push(frame.gpuPctX10);
+        gpuTemp.push(frame.gpuTempCX10);
+        netRx.push(frame.netRxKbps);
+        netTx.push(frame.netTxKbps);
+        diskRead.push(frame.diskReadKBps);
+        diskWrite.push(frame.diskWriteKBps);
+        cpuTiers.add(frame.cpuPctX10, nowMs);
+        gpuTiers.add(frame.gpuPctX10, nowMs);
+    }
+};
+
+#endif
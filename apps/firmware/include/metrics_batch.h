@@ -0,0 +1,153 @@
+#ifndef METRICS_BATCH_H
+#define METRICS_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "connection_policy.h"
+#include "hostname_index.h"
+#include "metrics_v3.h"
+
+// sys/agents/<collector>/metrics/batch：一則訊息帶多台設備的 metrics v3 frame。
+//
+//   [0]      header  0x38（版本 3、batch 旗標 0x8）
+//   [1]      count   u8，1..METRICS_BATCH_MAX_HOSTS
+//   每筆     u8 hostLen（1..31）、hostname、v3 frame 去掉 CRC（長度由 frame header 推得）
+//   最後 2B  CRC-16/CCITT-FALSE，涵蓋前面全部 bytes
+//
+// 每台省下一則 MQTT 訊息的 framing、callback、topic 檢查與 hostname 擷取，也省下各自的 CRC。
+// 整則訊息連同 topic 必須放得進接收端的 MQTT 緩衝區：writer 的輸出大小請用
+// mqttPublishPayloadBudget(topic)，放不下時 collector 分成多則送。
+#ifndef METRICS_BATCH_MAX_HOSTS
+#define METRICS_BATCH_MAX_HOSTS 32
+#endif
+
+static const uint8_t METRICS_BATCH_FLAG = 0x8;
+static const uint8_t METRICS_BATCH_HEADER = (uint8_t)((METRICS_SCHEMA_V3 << 4) | METRICS_BATCH_FLAG);
+static const size_t METRICS_BATCH_HEADER_BYTES = 2;
+static const size_t METRICS_BATCH_MAX_HOSTNAME = 31;
+
+struct MetricsBatchEntry {
+    char hostname[METRICS_BATCH_MAX_HOSTNAME + 1];
+    HostKey key;  // 指向 hostname
+    MetricsFrameV2 frame;
+    MetricsV3Info info;
+};
+
+// 只走訪結構：header、數量、每筆 hostname 與 frame header、總長與 CRC 都對才算合法
+static inline bool isValidMetricsBatch(const uint8_t* payload, size_t length) {
+    if (!payload || length < METRICS_BATCH_HEADER_BYTES + METRICS_V3_CRC_BYTES || payload[0] != METRICS_BATCH_HEADER) {
+        return false;
+    }
+    const uint8_t count = payload[1];
+    if (count == 0 || count > METRICS_BATCH_MAX_HOSTS) {
+        return false;
+    }
+
+    const size_t body = length - METRICS_V3_CRC_BYTES;
+    size_t offset = METRICS_BATCH_HEADER_BYTES;
+    for (uint8_t i = 0; i < count; i++) {
+        if (offset >= body) {
+            return false;
+        }
+        const uint8_t hostLen = payload[offset++];
+        if (hostLen == 0 || hostLen > METRICS_BATCH_MAX_HOSTNAME || body - offset < hostLen) {
+            return false;
+        }
+        const char* host = (const char*)payload + offset;
+        if (!isValidSenderHostname(host, host + hostLen)) {
+            return false;
+        }
+        offset += hostLen;
+
+        const size_t frameLength = metricsV3BodyLength(payload + offset, body - offset);
+        if (frameLength == 0) {
+            return false;
+        }
+        offset += frameLength;
+    }
+    return offset == body && readLe16(payload + body) == metricsV3Crc(payload, body);
+}
+
+// 整則合法才開始解碼，逐筆交給 visit(const MetricsBatchEntry&)；回傳筆數，不合法時回傳 -1 且不呼叫 visit。
+// 每筆的 frame 都從新的 MetricsFrameV2 開始，沒送的欄位為 0，與單台 topic 相同
+template <typename Visitor>
+inline int16_t forEachMetricsBatchEntry(const uint8_t* payload, size_t length, Visitor&& visit) {
+    if (!isValidMetricsBatch(payload, length)) {
+        return -1;
+    }
+
+    const uint8_t count = payload[1];
+    size_t offset = METRICS_BATCH_HEADER_BYTES;
+    MetricsBatchEntry entry;
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t hostLen = payload[offset++];
+        entry.key = copyHostKey(entry.hostname, (const char*)payload + offset, hostLen);
+        offset += hostLen;
+
+        // 結構已檢查過，這裡只依 header 算長度後直接複製
+        const uint8_t* frame = payload + offset;
+        entry.frame = MetricsFrameV2{};
+        copyMetricsV3Body(frame, entry.frame, &entry.info);
+        offset += metricsV3FrameBytes(readLe16(frame + 1), frame[0] & 0x0F) - METRICS_V3_CRC_BYTES;
+        visit(entry);
+    }
+    return count;
+}
+
+// collector 端：依序 add，最後 finish 補上 CRC
+class MetricsBatchWriter {
+public:
+    MetricsBatchWriter(uint8_t* out, size_t outSize) : _out(out), _size(outSize) {
+        _length = out && outSize >= METRICS_BATCH_HEADER_BYTES + METRICS_V3_CRC_BYTES ? METRICS_BATCH_HEADER_BYTES : 0;
+    }
+
+    // 放不下、hostname 不合法或已滿時回傳 false，之前加入的資料不受影響
+    bool add(const char* hostname, const MetricsFrameV2& frame, uint16_t present = METRICS_V3_ALL_FIELDS,
+             uint8_t flags = 0, uint8_t seq = 0, uint8_t keySeq = 0) {
+        const size_t hostLen = hostname ? strlen(hostname) : 0;
+        if (_length == 0 || _count >= METRICS_BATCH_MAX_HOSTS || hostLen == 0 ||
+            hostLen > METRICS_BATCH_MAX_HOSTNAME || !isValidSenderHostname(hostname, hostname + hostLen)) {
+            return false;
+        }
+        const size_t room = _size - METRICS_V3_CRC_BYTES - _length;
+        if (room < 1 + hostLen) {
+            return false;
+        }
+        uint8_t* p = _out + _length;
+        const size_t frameLength = encodeMetricsV3Body(frame, present, p + 1 + hostLen, room - 1 - hostLen, flags,
+                                                       seq, keySeq);
+        if (frameLength == 0) {
+            return false;
+        }
+        p[0] = (uint8_t)hostLen;
+        memcpy(p + 1, hostname, hostLen);
+        _length += 1 + hostLen + frameLength;
+        _count++;
+        return true;
+    }
+
+    uint8_t count() const {
+        return _count;
+    }
+
+    // 回傳整則長度；沒有任何一筆時回傳 0
+    size_t finish() {
+        if (_length == 0 || _count == 0) {
+            return 0;
+        }
+        _out[0] = METRICS_BATCH_HEADER;
+        _out[1] = _count;
+        writeLe16(_out + _length, metricsV3Crc(_out, _length));
+        return _length + METRICS_V3_CRC_BYTES;
+    }
+
+private:
+    uint8_t* _out;
+    size_t _size;
+    size_t _length;
+    uint8_t _count = 0;
+};
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef METRICS_DELTA_H
+#define METRICS_DELTA_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "metrics_v2.h"
+#include "metrics_v3.h"
+
+// metrics v3 keyframe / delta：sender 每 N 個 frame 送一次完整 keyframe，中間只送與該 keyframe
+// 不同的欄位。delta 都相對於 keyframe 而非前一個 frame，掉一個 delta 不影響下一個；
+// 掉了 keyframe 則之後 keySeq 對不上，全部丟掉直到下一個 keyframe。
+
+// 每個 dirty 群組對應的 v3 欄位 bits
+static const uint16_t METRICS_V3_CPU_FIELDS = (1U << V3_CPU_PCT) | (1U << V3_CPU_TEMP);
+static const uint16_t METRICS_V3_RAM_FIELDS = (1U << V3_RAM_PCT) | (1U << V3_RAM_USED) | (1U << V3_RAM_TOTAL);
+static const uint16_t METRICS_V3_GPU_FIELDS = (1U << V3_GPU_PCT) | (1U << V3_GPU_TEMP) | (1U << V3_GPU_MEM_PCT) |
+                                              (1U << V3_GPU_HOTSPOT) | (1U << V3_GPU_MEM_TEMP);
+static const uint16_t METRICS_V3_NET_FIELDS = (1U << V3_NET_RX) | (1U << V3_NET_TX);
+static const uint16_t METRICS_V3_DISK_FIELDS = (1U << V3_DISK_READ) | (1U << V3_DISK_WRITE);
+
+static_assert((METRICS_V3_CPU_FIELDS | METRICS_V3_RAM_FIELDS | METRICS_V3_GPU_FIELDS | METRICS_V3_NET_FIELDS |
+               METRICS_V3_DISK_FIELDS) == METRICS_V3_ALL_FIELDS,
+              "every metrics v3 field must belong to a dirty group");
+
+static inline uint16_t metricsDirtyMaskForFields(uint16_t fields) {
+    uint16_t dirty = DIRTY_NONE;
+    if (fields & METRICS_V3_CPU_FIELDS) dirty |= DIRTY_CPU;
+    if (fields & METRICS_V3_RAM_FIELDS) dirty |= DIRTY_RAM;
+    if (fields & METRICS_V3_GPU_FIELDS) dirty |= DIRTY_GPU;
+    if (fields & METRICS_V3_NET_FIELDS) dirty |= DIRTY_NET;
+    if (fields & METRICS_V3_DISK_FIELDS) dirty |= DIRTY_DISK;
+    return dirty;
+}
+
+// 只比對 candidates 內的欄位，回傳值真的不同的那些 bits
+static inline uint16_t metricsChangedFields(const MetricsFrameV2& from, const MetricsFrameV2& to,
+                                            uint16_t candidates) {
+    const uint8_t* a = metricsV3FieldBytes(from);
+    const uint8_t* b = metricsV3FieldBytes(to);
+    uint16_t changed = 0;
+    for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT; i++) {
+        if ((candidates & (1U << i)) && memcmp(a + i * 2, b + i * 2, 2) != 0) changed |= (uint16_t)(1U << i);
+    }
+    return changed;
+}
+
+// 只帶與 keyframe 不同的欄位
+static inline uint16_t metricsDeltaFields(const MetricsFrameV2& keyframe, const MetricsFrameV2& frame) {
+    return metricsChangedFields(keyframe, frame, METRICS_V3_ALL_FIELDS);
+}
+
+// 接收端每台設備一份
+struct MetricsDeltaState {
+    MetricsFrameV2 keyframe;
+    uint16_t lastPresent = 0;  // 上一個 delta 帶的欄位；這次沒帶就是回到 keyframe 的值
+    uint8_t keySeq = 0;
+    uint8_t lastSeq = 0;
+    bool synced = false;       // 有可用的 keyframe
+    uint16_t gapCount = 0;     // seq 不連續的次數，只做統計
+
+    void reset() {
+        synced = false;
+        lastPresent = 0;
+    }
+};
+
+enum MetricsDeltaResult : uint8_t {
+    DELTA_APPLIED = 0,
+    DELTA_NEED_KEYFRAME
+};
+
+// decoded / info 來自 decodeMetricsV3。成功時 out 為重建後的完整 frame，
+// candidates 為相對於上一個 out 可能改變的欄位，其餘欄位保證沒變
+static inline MetricsDeltaResult applyMetricsV3Frame(MetricsDeltaState& state, const MetricsV3Info& info,
+                                                     const MetricsFrameV2& decoded, MetricsFrameV2& out,
+                                                     uint16_t& candidates) {
+    if (!isSequencedMetricsV3(info.flags)) {
+        state.reset();
+        out = decoded;
+        candidates = METRICS_V3_ALL_FIELDS;
+        return DELTA_APPLIED;
+    }
+
+    if (state.synced && info.seq != (uint8_t)(state.lastSeq + 1)) {
+        state.gapCount++;
+    }
+
+    if (info.flags == METRICS_V3_FLAG_KEYFRAME) {
+        state.keyframe = decoded;
+        state.keySeq = info.seq;
+        state.lastSeq = info.seq;
+        state.lastPresent = 0;
+        state.synced = true;
+        out = decoded;
+        candidates = METRICS_V3_ALL_FIELDS;
+        return DELTA_APPLIED;
+    }
+
+    if (!state.synced || info.keySeq != state.keySeq) {
+        state.reset();
+        return DELTA_NEED_KEYFRAME;
+    }
+
+    out = state.keyframe;
+    out.version = decoded.version;
+    out.senderTsMs = decoded.senderTsMs;
+    uint8_t* dst = metricsV3FieldBytes(out);
+    const uint8_t* src = metricsV3FieldBytes(decoded);
+    for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT; i++) {
+        if (info.present & (1U << i)) memcpy(dst + i * 2, src + i * 2, 2);
+    }
+    candidates = info.present | state.lastPresent;
+    state.lastPresent = info.present;
+    state.lastSeq = info.seq;
+    return DELTA_APPLIED;
+}
+
+// sender 端：keyframeInterval 個 frame 裡第一個是 keyframe，其餘是 delta；interval <= 1 時全送一般 frame
+class MetricsV3DeltaEncoder {
+public:
+    explicit MetricsV3DeltaEncoder(uint8_t keyframeInterval = 10) : _interval(keyframeInterval) {}
+
+    // 下一個 frame 強制為 keyframe（例如重新連線後）
+    void forceKeyframe() {
+        _sinceKeyframe = 0;
+    }
+
+    size_t encode(const MetricsFrameV2& frame, uint8_t* out, size_t outSize) {
+        if (_interval <= 1) {
+            return encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, out, outSize);
+        }
+
+        const uint8_t seq = _nextSeq;
+        size_t length;
+        if (_sinceKeyframe == 0) {
+            length = encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, out, outSize, METRICS_V3_FLAG_KEYFRAME, seq, seq);
+            if (length) {
+                _keyframe = frame;
+                _keySeq = seq;
+            }
+        } else {
+            length = encodeMetricsV3(frame, metricsDeltaFields(_keyframe, frame), out, outSize, METRICS_V3_FLAG_DELTA,
+                                     seq, _keySeq);
+        }
+        if (length) {
+            _nextSeq++;
+            _sinceKeyframe = (uint8_t)((_sinceKeyframe + 1) % _interval);
+        }
+        return length;
+    }
+
+private:
+    MetricsFrameV2 _keyframe;
+    uint8_t _interval;
+    uint8_t _sinceKeyframe = 0;
+    uint8_t _nextSeq = 0;
+    uint8_t _keySeq = 0;
+};
+
+#endif
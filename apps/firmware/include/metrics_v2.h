@@ -1,7 +1,8 @@
 #ifndef METRICS_V2_H
 #define METRICS_V2_H
 
-#include <Arduino.h>
+#include <math.h>
+#include <stdint.h>
 
 static const uint8_t METRICS_SCHEMA_V2 = 2;
 
@@ -0,0 +1,273 @@
+#ifndef METRICS_V2_STREAM_H
+#define METRICS_V2_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fixed_decimal.h"
+#include "metrics_v2.h"
+
+// metrics v2 payload 的專用解析器：直接從 MQTT 緩衝區（不需 '\0' 結尾）逐字掃描，
+// 不配置記憶體，數字由 fixed_decimal.h 直接轉成 x10/整數。
+// 只認得固定的 v2 形狀，其餘 key 驗證語法後略過。
+//
+// 與原本 ArduinoJson + float 的行為一致：
+// - 非 JSON、最外層不是 object、巢狀超過 METRICS_V2_MAX_NESTING、或 v 不是整數 2 時失敗
+// - 陣列元素為 null 或陣列太短時該欄位不變；true/false 視為 1/0，內容是數字的字串照數字解析，
+//   其他元素視為 0
+// - 數值四捨五入（遠離 0）到 x10 或整數後再夾到欄位範圍
+// 不同處：ts 取整數的低 32 位元（原本超過 int 範圍時為 0）；含跳脫字元的 key 視為未知 key。
+static const uint8_t METRICS_V2_MAX_NESTING = 10;
+
+class MetricsV2Scanner {
+public:
+    MetricsV2Scanner(const uint8_t* data, size_t length)
+        : _p((const char*)data), _end((const char*)data + length) {}
+
+    bool parse(MetricsFrameV2& frame) {
+        bool versionSeen = false;
+        skipWs();
+        if (!consume('{')) return false;
+        skipWs();
+        if (!consume('}')) {
+            while (true) {
+                const char* key;
+                size_t keyLen;
+                bool escaped;
+                if (!scanString(key, keyLen, escaped)) return false;
+                skipWs();
+                if (!consume(':')) return false;
+                skipWs();
+                if (!parseMember(escaped ? "" : key, escaped ? 0 : keyLen, frame, versionSeen)) return false;
+                skipWs();
+                if (consume(',')) {
+                    skipWs();
+                    continue;
+                }
+                if (consume('}')) break;
+                return false;
+            }
+        }
+        skipWs();
+        // ArduinoJson 讀完第一個值就停，後面的內容不檢查
+        return versionSeen;
+    }
+
+private:
+    const char* _p;
+    const char* _end;
+
+    enum ValueKind : uint8_t { VALUE_NUMBER, VALUE_NULL, VALUE_OTHER, VALUE_INVALID };
+
+    bool atEnd() const { return _p >= _end; }
+
+    bool consume(char c) {
+        if (_p < _end && *_p == c) {
+            _p++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeLiteral(const char* lit) {
+        const size_t n = strlen(lit);
+        if ((size_t)(_end - _p) < n || memcmp(_p, lit, n) != 0) return false;
+        _p += n;
+        return true;
+    }
+
+    void skipWs() {
+        while (_p < _end && (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')) _p++;
+    }
+
+    static bool keyIs(const char* key, size_t len, const char* name) {
+        return strlen(name) == len && memcmp(key, name, len) == 0;
+    }
+
+    bool parseMember(const char* key, size_t len, MetricsFrameV2& frame, bool& versionSeen) {
+        if (keyIs(key, len, "v")) {
+            FixedDecimal n;
+            if (scanValue(n, 1) != VALUE_NUMBER || !n.integral || n.negative || n.mantissa != METRICS_SCHEMA_V2) {
+                return false;
+            }
+            frame.version = METRICS_SCHEMA_V2;
+            versionSeen = true;
+            return true;
+        }
+        if (keyIs(key, len, "ts")) {
+            FixedDecimal n;
+            const ValueKind kind = scanValue(n, 1);
+            if (kind == VALUE_INVALID) return false;
+            frame.senderTsMs = (kind == VALUE_NUMBER && n.integral && !n.negative) ? (uint32_t)n.mantissa : 0;
+            return true;
+        }
+
+        int16_t* x10[5] = {};
+        uint16_t* u16[5] = {};
+        if (keyIs(key, len, "cpu")) {
+            x10[0] = &frame.cpuPctX10;
+            x10[1] = &frame.cpuTempCX10;
+        } else if (keyIs(key, len, "ram")) {
+            x10[0] = &frame.ramPctX10;
+            u16[1] = &frame.ramUsedMB;
+            u16[2] = &frame.ramTotalMB;
+        } else if (keyIs(key, len, "gpu")) {
+            x10[0] = &frame.gpuPctX10;
+            x10[1] = &frame.gpuTempCX10;
+            x10[2] = &frame.gpuMemPctX10;
+            x10[3] = &frame.gpuHotspotCX10;
+            x10[4] = &frame.gpuMemTempCX10;
+        } else if (keyIs(key, len, "net")) {
+            u16[0] = &frame.netRxKbps;
+            u16[1] = &frame.netTxKbps;
+        } else if (keyIs(key, len, "disk")) {
+            u16[0] = &frame.diskReadKBps;
+            u16[1] = &frame.diskWriteKBps;
+        } else {
+            return skipValue(1);
+        }
+
+        // 不是陣列時整個值略過，與 as<JsonArrayConst>() 為 null 相同
+        if (atEnd() || *_p != '[') return skipValue(1);
+        _p++;
+        skipWs();
+        if (consume(']')) return true;
+        for (uint8_t i = 0;; i++) {
+            FixedDecimal n;
+            const ValueKind kind = (!atEnd() && *_p == '"') ? scanNumericString(n) : scanValue(n, 2);
+            if (kind == VALUE_INVALID) return false;
+            if (i < 5 && kind != VALUE_NULL) {
+                if (x10[i]) *x10[i] = kind == VALUE_NUMBER ? fixedDecimalToX10(n) : 0;
+                if (u16[i]) *u16[i] = kind == VALUE_NUMBER ? fixedDecimalToU16(n) : 0;
+            }
+            skipWs();
+            if (consume(',')) {
+                skipWs();
+                continue;
+            }
+            return consume(']');
+        }
+    }
+
+    // 讀一個值；數字填入 n，其他型別驗證語法後略過。depth 為這個值所在的巢狀層數
+    ValueKind scanValue(FixedDecimal& n, uint8_t depth) {
+        if (atEnd()) return VALUE_INVALID;
+        const char c = *_p;
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            return scanNumber(n) ? VALUE_NUMBER : VALUE_INVALID;
+        }
+        if (c == 'n') {
+            return consumeLiteral("null") ? VALUE_NULL : VALUE_INVALID;
+        }
+        if (c == 't' || c == 'f') {
+            n = FixedDecimal{false, true, (uint64_t)(c == 't'), 0};
+            return consumeLiteral(c == 't' ? "true" : "false") ? VALUE_NUMBER : VALUE_INVALID;
+        }
+        return skipValue(depth) ? VALUE_OTHER : VALUE_INVALID;
+    }
+
+    // 陣列裡的字串：ArduinoJson 的 as<float>() 會把字串當數字解析，失敗時為 0
+    ValueKind scanNumericString(FixedDecimal& n) {
+        const char* s;
+        size_t len;
+        bool escaped;
+        if (!scanString(s, len, escaped)) return VALUE_INVALID;
+        if (escaped || len == 0 || scanFixedDecimal(s, s + len, n) != len) {
+            n = FixedDecimal{false, true, 0, 0};
+        }
+        return VALUE_NUMBER;
+    }
+
+    bool skipValue(uint8_t depth) {
+        if (atEnd()) return false;
+        const char c = *_p;
+        if (c == '"') {
+            const char* s;
+            size_t len;
+            bool escaped;
+            return scanString(s, len, escaped);
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            FixedDecimal n;
+            return scanNumber(n);
+        }
+        if (c == 't') return consumeLiteral("true");
+        if (c == 'f') return consumeLiteral("false");
+        if (c == 'n') return consumeLiteral("null");
+        if (c != '[' && c != '{') return false;
+        if (depth >= METRICS_V2_MAX_NESTING) return false;
+
+        const bool object = c == '{';
+        const char close = object ? '}' : ']';
+        _p++;
+        skipWs();
+        if (consume(close)) return true;
+        while (true) {
+            if (object) {
+                const char* s;
+                size_t len;
+                bool escaped;
+                if (!scanString(s, len, escaped)) return false;
+                skipWs();
+                if (!consume(':')) return false;
+                skipWs();
+            }
+            if (!skipValue(depth + 1)) return false;
+            skipWs();
+            if (consume(',')) {
+                skipWs();
+                continue;
+            }
+            return consume(close);
+        }
+    }
+
+    bool scanString(const char*& start, size_t& len, bool& escaped) {
+        escaped = false;
+        if (!consume('"')) return false;
+        start = _p;
+        while (_p < _end) {
+            const char c = *_p++;
+            if (c == '"') {
+                len = (size_t)(_p - 1 - start);
+                return true;
+            }
+            if ((uint8_t)c < 0x20) return false;
+            if (c != '\\') continue;
+
+            escaped = true;
+            if (atEnd()) return false;
+            const char e = *_p++;
+            if (e == 'u') {
+                for (uint8_t i = 0; i < 4; i++) {
+                    if (atEnd() || !isHex(*_p++)) return false;
+                }
+            } else if (!strchr("\"\\/bfnrt", e) || e == '\0') {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    static bool isHex(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    bool scanNumber(FixedDecimal& n) {
+        const size_t used = scanFixedDecimal(_p, _end, n);
+        _p += used;
+        return used != 0;
+    }
+};
+
+// payload 只需 length 個 bytes，不要求 '\0' 結尾
+static inline bool parseMetricsV2Stream(const uint8_t* payload, size_t length, MetricsFrameV2& frame) {
+    if (!payload) {
+        return false;
+    }
+    MetricsV2Scanner scanner(payload, length);
+    return scanner.parse(frame);
+}
+
+#endif
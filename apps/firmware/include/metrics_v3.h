@@ -0,0 +1,247 @@
+#ifndef METRICS_V3_H
+#define METRICS_V3_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "metrics_v2.h"
+
+// metrics v3：little-endian 固定版面的二進位 frame，欄位一對一對應 MetricsFrameV2。
+//
+//   [0]      header  高 4 bits 為版本 3，低 4 bits 為旗標（見下）
+//   [1..2]   present u16，bit i 表示第 i 個欄位有送，順序同 MetricsFrameV2
+//   [3..6]   ts      u32，sender epoch ms 的低 32 位元
+//   [7..8]   seq u8、keySeq u8，只有 keyframe / delta frame 才有
+//   [...]    每個有送的欄位 2 bytes（x10 欄位為 int16，其餘為 uint16），依 bit 順序緊接
+//   最後 2B  CRC-16/CCITT-FALSE（poly 0x1021、init 0xFFFF），涵蓋前面全部 bytes
+//
+// 欄位全送時 37 bytes，解碼只是一次 memcpy。沒送的欄位保持 frame 原值（新 frame 即為 0），
+// 與 v2 陣列太短時相同。
+//
+// 旗標：KEYFRAME 帶全部欄位；DELTA 只帶與 keySeq 那個 keyframe 不同的欄位（見 metrics_delta.h）。
+// seq 每個 frame 加 1，keyframe 的 keySeq 等於自己的 seq。兩個旗標不能同時設。
+static const uint8_t METRICS_SCHEMA_V3 = 3;
+static const uint8_t METRICS_V3_FIELD_COUNT = 14;
+static const uint16_t METRICS_V3_ALL_FIELDS = (1U << METRICS_V3_FIELD_COUNT) - 1;
+static const uint8_t METRICS_V3_FLAG_KEYFRAME = 0x1;
+static const uint8_t METRICS_V3_FLAG_DELTA = 0x2;
+static const size_t METRICS_V3_HEADER_BYTES = 7;
+static const size_t METRICS_V3_SEQ_BYTES = 2;
+static const size_t METRICS_V3_CRC_BYTES = 2;
+static const size_t METRICS_V3_MAX_BYTES =
+    METRICS_V3_HEADER_BYTES + METRICS_V3_SEQ_BYTES + METRICS_V3_FIELD_COUNT * 2 + METRICS_V3_CRC_BYTES;
+
+// 解碼時的 frame 外資訊；一般 frame 的 flags 為 0，seq / keySeq 無意義
+struct MetricsV3Info {
+    uint8_t flags = 0;
+    uint8_t seq = 0;
+    uint8_t keySeq = 0;
+    uint16_t present = 0;
+};
+
+enum MetricsV3Field : uint8_t {
+    V3_CPU_PCT = 0,
+    V3_CPU_TEMP,
+    V3_RAM_PCT,
+    V3_RAM_USED,
+    V3_RAM_TOTAL,
+    V3_GPU_PCT,
+    V3_GPU_TEMP,
+    V3_GPU_MEM_PCT,
+    V3_GPU_HOTSPOT,
+    V3_GPU_MEM_TEMP,
+    V3_NET_RX,
+    V3_NET_TX,
+    V3_DISK_READ,
+    V3_DISK_WRITE
+};
+
+// 欄位在 MetricsFrameV2 裡必須是連續的 16-bit 值，位元組序與線上格式相同，才能直接 memcpy
+static_assert(offsetof(MetricsFrameV2, diskWriteKBps) - offsetof(MetricsFrameV2, cpuPctX10) ==
+                  (METRICS_V3_FIELD_COUNT - 1) * 2,
+              "MetricsFrameV2 fields must stay contiguous for metrics v3");
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "metrics v3 decoding assumes a little-endian target");
+#endif
+
+static inline uint8_t* metricsV3FieldBytes(MetricsFrameV2& frame) {
+    return (uint8_t*)&frame.cpuPctX10;
+}
+
+static inline const uint8_t* metricsV3FieldBytes(const MetricsFrameV2& frame) {
+    return (const uint8_t*)&frame.cpuPctX10;
+}
+
+static inline uint8_t metricsV3FieldCount(uint16_t present) {
+    uint8_t count = 0;
+    for (; present; present &= present - 1) count++;
+    return count;
+}
+
+static inline bool isSequencedMetricsV3(uint8_t flags) {
+    return flags != 0;
+}
+
+static inline size_t metricsV3FrameBytes(uint16_t present, uint8_t flags = 0) {
+    return METRICS_V3_HEADER_BYTES + (isSequencedMetricsV3(flags) ? METRICS_V3_SEQ_BYTES : 0) +
+           (size_t)metricsV3FieldCount(present) * 2 + METRICS_V3_CRC_BYTES;
+}
+
+// 只接受一般、keyframe 或 delta；keyframe 必須帶全部欄位
+static inline bool isValidMetricsV3Flags(uint8_t flags, uint16_t present) {
+    if (flags == 0 || flags == METRICS_V3_FLAG_DELTA) return true;
+    return flags == METRICS_V3_FLAG_KEYFRAME && present == METRICS_V3_ALL_FIELDS;
+}
+
+// 每次處理 4 bits 的查表版，表只有 32 bytes
+static inline uint16_t metricsV3Crc(const uint8_t* data, size_t length) {
+    static const uint16_t NIBBLE_TABLE[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc << 4) ^ NIBBLE_TABLE[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ NIBBLE_TABLE[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static inline void writeLe16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline uint16_t readLe16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// 寫入 out，回傳 CRC 以外的長度（batch 內的 frame 共用外層 CRC）；out 不夠大、present 含未定義的 bit
+// 或旗標不合法時回傳 0
+static inline size_t encodeMetricsV3Body(const MetricsFrameV2& frame, uint16_t present, uint8_t* out,
+                                         size_t outSize, uint8_t flags = 0, uint8_t seq = 0, uint8_t keySeq = 0) {
+    if (!out || (present & ~METRICS_V3_ALL_FIELDS) != 0 || !isValidMetricsV3Flags(flags, present)) {
+        return 0;
+    }
+    const size_t total = metricsV3FrameBytes(present, flags) - METRICS_V3_CRC_BYTES;
+    if (outSize < total) {
+        return 0;
+    }
+
+    out[0] = (uint8_t)((METRICS_SCHEMA_V3 << 4) | flags);
+    writeLe16(out + 1, present);
+    writeLe16(out + 3, (uint16_t)frame.senderTsMs);
+    writeLe16(out + 5, (uint16_t)(frame.senderTsMs >> 16));
+
+    const uint8_t* fields = metricsV3FieldBytes(frame);
+    uint8_t* p = out + METRICS_V3_HEADER_BYTES;
+    if (isSequencedMetricsV3(flags)) {
+        *p++ = seq;
+        *p++ = flags == METRICS_V3_FLAG_KEYFRAME ? seq : keySeq;
+    }
+    for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT; i++) {
+        if (!(present & (1U << i))) continue;
+        uint16_t value;
+        memcpy(&value, fields + i * 2, 2);
+        writeLe16(p, value);
+        p += 2;
+    }
+    return total;
+}
+
+// 寫入 out，回傳 frame 長度；失敗時回傳 0
+static inline size_t encodeMetricsV3(const MetricsFrameV2& frame, uint16_t present, uint8_t* out, size_t outSize,
+                                     uint8_t flags = 0, uint8_t seq = 0, uint8_t keySeq = 0) {
+    if (outSize < METRICS_V3_CRC_BYTES) {
+        return 0;
+    }
+    const size_t body = encodeMetricsV3Body(frame, present, out, outSize - METRICS_V3_CRC_BYTES, flags, seq, keySeq);
+    if (body == 0) {
+        return 0;
+    }
+    writeLe16(out + body, metricsV3Crc(out, body));
+    return body + METRICS_V3_CRC_BYTES;
+}
+
+// 只看 header：合法時回傳 CRC 以外的 frame 長度（不超過 available），否則回傳 0
+static inline size_t metricsV3BodyLength(const uint8_t* p, size_t available) {
+    if (!p || available < METRICS_V3_HEADER_BYTES || (p[0] >> 4) != METRICS_SCHEMA_V3) {
+        return 0;
+    }
+    const uint8_t flags = p[0] & 0x0F;
+    const uint16_t present = readLe16(p + 1);
+    if ((present & ~METRICS_V3_ALL_FIELDS) != 0 || !isValidMetricsV3Flags(flags, present)) {
+        return 0;
+    }
+    const size_t length = metricsV3FrameBytes(present, flags) - METRICS_V3_CRC_BYTES;
+    if (available < length) {
+        return 0;
+    }
+    if (flags == METRICS_V3_FLAG_KEYFRAME && p[METRICS_V3_HEADER_BYTES] != p[METRICS_V3_HEADER_BYTES + 1]) {
+        return 0;
+    }
+    return length;
+}
+
+// p 已經過 metricsV3BodyLength 檢查，直接寫入 frame 與 info
+static inline void copyMetricsV3Body(const uint8_t* p, MetricsFrameV2& frame, MetricsV3Info* info) {
+    const uint8_t flags = p[0] & 0x0F;
+    const uint16_t present = readLe16(p + 1);
+    const uint8_t* src = p + METRICS_V3_HEADER_BYTES;
+
+    frame.version = METRICS_SCHEMA_V3;
+    frame.senderTsMs = (uint32_t)readLe16(p + 3) | ((uint32_t)readLe16(p + 5) << 16);
+
+    if (info) {
+        info->flags = flags;
+        info->present = present;
+        info->seq = isSequencedMetricsV3(flags) ? src[0] : 0;
+        info->keySeq = isSequencedMetricsV3(flags) ? src[1] : 0;
+    }
+    if (isSequencedMetricsV3(flags)) {
+        src += METRICS_V3_SEQ_BYTES;
+    }
+    uint8_t* fields = metricsV3FieldBytes(frame);
+    if (present == METRICS_V3_ALL_FIELDS) {
+        memcpy(fields, src, METRICS_V3_FIELD_COUNT * 2);
+        return;
+    }
+    for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT; i++) {
+        if (!(present & (1U << i))) continue;
+        memcpy(fields + i * 2, src, 2);
+        src += 2;
+    }
+}
+
+// CRC 以外的部分，length 必須剛好是一個 frame；失敗時 frame 不變。
+// 沒給 info 時只接受一般 frame，keyframe / delta 需要呼叫端處理序號。
+static inline bool decodeMetricsV3Body(const uint8_t* p, size_t length, MetricsFrameV2& frame,
+                                       MetricsV3Info* info = nullptr) {
+    if (metricsV3BodyLength(p, length) != length) {
+        return false;
+    }
+    if (isSequencedMetricsV3(p[0] & 0x0F) && !info) {
+        return false;
+    }
+    copyMetricsV3Body(p, frame, info);
+    return true;
+}
+
+// 長度、header、present 與 CRC 都檢查過才寫入 frame；失敗時 frame 不變
+static inline bool decodeMetricsV3(const uint8_t* payload, size_t length, MetricsFrameV2& frame,
+                                   MetricsV3Info* info = nullptr) {
+    if (!payload || length < METRICS_V3_HEADER_BYTES + METRICS_V3_CRC_BYTES || length > METRICS_V3_MAX_BYTES) {
+        return false;
+    }
+    const size_t body = length - METRICS_V3_CRC_BYTES;
+    if (metricsV3BodyLength(payload, body) != body) {
+        return false;
+    }
+    if (readLe16(payload + body) != metricsV3Crc(payload, body)) {
+        return false;
+    }
+    return decodeMetricsV3Body(payload, body, frame, info);
+}
+
+#endif
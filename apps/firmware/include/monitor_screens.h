@@ -0,0 +1,262 @@
+#ifndef MONITOR_SCREENS_H
+#define MONITOR_SCREENS_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include "metric_history.h"
+#include "metrics_v2.h"
+#include "scene_compositor.h"
+#include "tft_core.h"
+#include "threshold_config.h"
+#include "ui_components.h"
+
+// 監控頁面的分帶高度（列），可用 -DMONITOR_BAND_HEIGHT=16 在 RAM 與 SPI burst 長度之間取捨
+#ifndef MONITOR_BAND_HEIGHT
+#define MONITOR_BAND_HEIGHT TFT_DEFAULT_BAND_HEIGHT
+#endif
+
+// 監控頁面的版面描述，與 WiFi/MQTT/設定狀態無關，由 MonitorDisplay 決定何時畫什麼。
+// 各 draw* 只更新 SceneCompositor 裡的元素，present() 才把受損區域送到面板；
+// native 環境可直接畫進虛擬面板。
+template <typename Tft>
+class MonitorScreens {
+public:
+    explicit MonitorScreens(Tft& tft)
+        : _scene(tft),
+          _cpuHistory(tft, HISTORY_X, 142, HISTORY_COLUMN_WIDTH, HISTORY_HEIGHT, COLOR_GREEN),
+          _gpuHistory(tft, HISTORY_X, 158, HISTORY_COLUMN_WIDTH, HISTORY_HEIGHT, COLOR_MAGENTA) {}
+
+    // 面板被其他畫面蓋過，下次 present() 整個重畫
+    void invalidate() {
+        _scene.invalidate();
+    }
+
+    // 設備頁面：標題列 + 輪播位置，之後接 drawDeviceRows(DIRTY_ALL) 與 drawFooter
+    void drawDeviceFrame(const char* alias, uint8_t index, uint8_t onlineCount) {
+        _scene.beginScene();
+        setHeader(alias, true);
+
+        if (onlineCount > 1) {
+            char indicator[16];
+            snprintf(indicator, sizeof(indicator), "%d/%d", index + 1, onlineCount);
+            _scene.setText(ITEM_INDICATOR, 200, 8, indicator, COLOR_GRAY, HEADER_BG_ONLINE, 1);
+        }
+
+        // 歷史圖的底色；離開設備頁時這個元素被移除，合成器會把長條圖一起清掉
+        const DamageRect area = damageUnion(_cpuHistory.bounds(), _gpuHistory.bounds());
+        _scene.setFill(ITEM_HISTORY_AREA, area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0, COLOR_BLACK);
+    }
+
+    void drawDeviceRows(const MetricsFrameV2& frame, const ThresholdConfig& th, uint16_t dirty) {
+        if (dirty & DIRTY_CPU) {
+            drawCpuRow(frame, th);
+        }
+        if (dirty & DIRTY_RAM) {
+            drawRamRow(frame, th);
+        }
+        if (dirty & DIRTY_GPU) {
+            drawGpuRows(frame, th);
+        }
+        if (dirty & DIRTY_NET) {
+            drawNetRow(frame);
+        }
+        if (dirty & DIRTY_DISK) {
+            drawDiskRow(frame);
+        }
+    }
+
+    void drawFooter(const char* ip, bool mqttOk, unsigned long ageSec) {
+        char buf[20];
+
+        _scene.setTextCentered(ITEM_FOOTER_IP, 204, ip, COLOR_YELLOW, COLOR_BLACK, 1);
+        setMqttStatus(mqttOk);
+
+        snprintf(buf, sizeof(buf), "%lus ago", ageSec);
+        _scene.setText(ITEM_FOOTER_RIGHT, 168, 222, buf, COLOR_GRAY, COLOR_BLACK, 1, 70);
+    }
+
+    void drawNoDevice(const char* ip, bool mqttOk) {
+        _scene.beginScene();
+        setHeader("Monitor", true);
+        _scene.setTextCentered(ITEM_MESSAGE_TITLE, 100, "Waiting", COLOR_CYAN, COLOR_BLACK, 2);
+        _scene.setTextCentered(ITEM_MESSAGE_DETAIL, 130, "for metrics v2", COLOR_GRAY, COLOR_BLACK, 1);
+
+        if (!mqttOk) {
+            _scene.setTextCentered(ITEM_MESSAGE_WARNING, 160, "MQTT not connected", COLOR_RED, COLOR_BLACK, 1);
+        }
+
+        _scene.setTextCentered(ITEM_FOOTER_IP, 204, ip, COLOR_YELLOW, COLOR_BLACK, 1);
+    }
+
+    void drawOfflineDevice(const char* alias, bool mqttOk) {
+        _scene.beginScene();
+
+        setHeader(alias, false);
+        _scene.setTextCentered(ITEM_MESSAGE_TITLE, 96, "OFFLINE", COLOR_RED, COLOR_BLACK, 2);
+        _scene.setTextCentered(ITEM_MESSAGE_DETAIL, 128, "No updates", COLOR_GRAY, COLOR_BLACK, 1);
+
+        setMqttStatus(mqttOk);
+        _scene.setText(ITEM_FOOTER_RIGHT, 168, 222, "OFFLINE", COLOR_RED, COLOR_BLACK, 1, 70);
+    }
+
+    // 把這一輪的變動送到面板。
+    // 合成器重畫到歷史圖的區域時會蓋掉長條，下一次 drawHistory 改成整塊重畫
+    void present() {
+        const DamageRegion<12>& damage = _scene.damage();
+        for (uint8_t i = 0; i < damage.count(); i++) {
+            if (!damageIntersect(damage.rect(i), _cpuHistory.bounds()).empty()) _cpuHistory.invalidate();
+            if (!damageIntersect(damage.rect(i), _gpuHistory.bounds()).empty()) _gpuHistory.invalidate();
+        }
+        _scene.flush();
+    }
+
+    // 設備頁的 CPU/GPU 使用率歷史，須在 present() 之後呼叫；只補畫與面板上不同的部分
+    template <typename History>
+    void drawHistory(const History& cpu, const History& gpu) {
+        _cpuHistory.draw(cpu);
+        _gpuHistory.draw(gpu);
+    }
+
+private:
+    static const uint16_t HEADER_BG_ONLINE = 0x1082;  // 深藍
+    // 歷史圖放在 HSP/MEM 與 VRAM 兩行的右側：預設 32 欄 x 2 像素 = 64 像素寬
+    static const int16_t HISTORY_X = 168;
+    static const uint8_t HISTORY_COLUMN_WIDTH = 2;
+    static const uint8_t HISTORY_HEIGHT = 12;
+    static_assert(HISTORY_X + DEVICE_HISTORY_SAMPLES * HISTORY_COLUMN_WIDTH <= TFT_WIDTH,
+                  "DEVICE_HISTORY_SAMPLES too wide for the device page sparklines");
+
+    // 畫面元素，數字越大疊在越上層；不同頁面同位置的元素共用 id，
+    // 切換頁面時只重畫內容不同的字元格
+    enum SceneItemId : uint8_t {
+        ITEM_HEADER_BAR = 0,
+        ITEM_HEADER_TITLE,
+        ITEM_INDICATOR,
+        ITEM_CPU_LABEL,
+        ITEM_CPU_PCT,
+        ITEM_CPU_TEMP,
+        ITEM_RAM_LABEL,
+        ITEM_RAM_PCT,
+        ITEM_RAM_USAGE,
+        ITEM_GPU_LABEL,
+        ITEM_GPU_PCT,
+        ITEM_GPU_TEMP,
+        ITEM_GPU_HOTSPOT,
+        ITEM_GPU_MEM_TEMP,
+        ITEM_GPU_VRAM,
+        ITEM_HISTORY_AREA,
+        ITEM_NET_LABEL,
+        ITEM_NET_RX,
+        ITEM_NET_TX,
+        ITEM_DISK_LABEL,
+        ITEM_DISK_READ,
+        ITEM_DISK_WRITE,
+        ITEM_MESSAGE_TITLE,
+        ITEM_MESSAGE_DETAIL,
+        ITEM_MESSAGE_WARNING,
+        ITEM_FOOTER_IP,
+        ITEM_FOOTER_MQTT,
+        ITEM_FOOTER_RIGHT,
+        ITEM_COUNT
+    };
+
+    SceneCompositor<Tft, ITEM_COUNT, 12, MONITOR_BAND_HEIGHT> _scene;
+    Sparkline<Tft, DEVICE_HISTORY_SAMPLES> _cpuHistory;
+    Sparkline<Tft, DEVICE_HISTORY_SAMPLES> _gpuHistory;
+
+    void setHeader(const char* name, bool isOnline) {
+        uint16_t bgColor = isOnline ? HEADER_BG_ONLINE : COLOR_RED;
+        _scene.setFill(ITEM_HEADER_BAR, 0, 0, TFT_WIDTH, 28, bgColor);
+        _scene.setTextCentered(ITEM_HEADER_TITLE, 6, name, COLOR_WHITE, bgColor, 2);
+    }
+
+    void setMqttStatus(bool mqttOk) {
+        if (mqttOk) {
+            _scene.setText(ITEM_FOOTER_MQTT, 8, 222, "MQTT OK", COLOR_GREEN, COLOR_BLACK, 1);
+        } else {
+            _scene.setText(ITEM_FOOTER_MQTT, 8, 222, "MQTT --", COLOR_RED, COLOR_BLACK, 1);
+        }
+    }
+
+    void drawCpuRow(const MetricsFrameV2& frame, const ThresholdConfig& th) {
+        int y = 36;
+        char buf[20];
+        int cpuPct = roundedPercent(frame.cpuPctX10);
+        int cpuTemp = roundedTempC(frame.cpuTempCX10);
+
+        _scene.setText(ITEM_CPU_LABEL, 8, y, "CPU", COLOR_WHITE, COLOR_BLACK, 2);
+        snprintf(buf, sizeof(buf), "%3d%%", cpuPct);
+        uint16_t cpuColor = (cpuPct >= th.cpuCrit) ? COLOR_RED : (cpuPct >= th.cpuWarn) ? COLOR_YELLOW : COLOR_GREEN;
+        _scene.setText(ITEM_CPU_PCT, 64, y, buf, cpuColor, COLOR_BLACK, 2, 80);
+
+        snprintf(buf, sizeof(buf), "%2dC", cpuTemp);
+        uint16_t tempColor = (cpuTemp >= th.tempCrit) ? COLOR_RED : (cpuTemp >= th.tempWarn) ? COLOR_YELLOW : COLOR_CYAN;
+        _scene.setText(ITEM_CPU_TEMP, 152, y, buf, tempColor, COLOR_BLACK, 2, 80);
+    }
+
+    void drawRamRow(const MetricsFrameV2& frame, const ThresholdConfig& th) {
+        int y = 72;
+        char buf[24];
+        int ramPct = roundedPercent(frame.ramPctX10);
+
+        _scene.setText(ITEM_RAM_LABEL, 8, y, "RAM", COLOR_WHITE, COLOR_BLACK, 2);
+        snprintf(buf, sizeof(buf), "%3d%%", ramPct);
+        uint16_t ramColor = (ramPct >= th.ramCrit) ? COLOR_RED : (ramPct >= th.ramWarn) ? COLOR_YELLOW : COLOR_GREEN;
+        _scene.setText(ITEM_RAM_PCT, 64, y, buf, ramColor, COLOR_BLACK, 2, 70);
+
+        snprintf(buf, sizeof(buf), "%u/%uM", frame.ramUsedMB, frame.ramTotalMB);
+        _scene.setText(ITEM_RAM_USAGE, 136, y, buf, COLOR_GRAY, COLOR_BLACK, 1, 100);
+    }
+
+    void drawGpuRows(const MetricsFrameV2& frame, const ThresholdConfig& th) {
+        int y = 108;
+        char buf[24];
+
+        _scene.setText(ITEM_GPU_LABEL, 8, y, "GPU", COLOR_WHITE, COLOR_BLACK, 2);
+
+        int gpuPct = roundedPercent(frame.gpuPctX10);
+        snprintf(buf, sizeof(buf), "%3d%%", gpuPct);
+        uint16_t gpuColor = (gpuPct >= th.gpuCrit) ? COLOR_RED : (gpuPct >= th.gpuWarn) ? COLOR_YELLOW : COLOR_GREEN;
+        _scene.setText(ITEM_GPU_PCT, 64, y, buf, gpuColor, COLOR_BLACK, 2, 80);
+
+        int gpuTemp = roundedTempC(frame.gpuTempCX10);
+        snprintf(buf, sizeof(buf), "%2dC", gpuTemp);
+        uint16_t tempColor = (gpuTemp >= th.tempCrit) ? COLOR_RED : (gpuTemp >= th.tempWarn) ? COLOR_YELLOW : COLOR_CYAN;
+        _scene.setText(ITEM_GPU_TEMP, 152, y, buf, tempColor, COLOR_BLACK, 2, 80);
+
+        y += 32;
+        int hspTemp = roundedTempC(frame.gpuHotspotCX10);
+        int memTemp = roundedTempC(frame.gpuMemTempCX10);
+        snprintf(buf, sizeof(buf), "HSP:%dC", hspTemp);
+        _scene.setText(ITEM_GPU_HOTSPOT, 8, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 72);
+        snprintf(buf, sizeof(buf), "MEM:%dC", memTemp);
+        _scene.setText(ITEM_GPU_MEM_TEMP, 88, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 72);
+
+        y += 16;
+        snprintf(buf, sizeof(buf), "VRAM: %d%%", roundedPercent(frame.gpuMemPctX10));
+        _scene.setText(ITEM_GPU_VRAM, 8, y, buf, COLOR_GRAY, COLOR_BLACK, 1, 120);
+    }
+
+    void drawNetRow(const MetricsFrameV2& frame) {
+        int y = 172;
+        char buf[20];
+        _scene.setText(ITEM_NET_LABEL, 8, y, "NET", COLOR_GRAY, COLOR_BLACK, 1);
+        snprintf(buf, sizeof(buf), "v%.1fM", kbpsToMbps(frame.netRxKbps));
+        _scene.setText(ITEM_NET_RX, 40, y, buf, COLOR_GREEN, COLOR_BLACK, 1, 70);
+        snprintf(buf, sizeof(buf), "^%.1fM", kbpsToMbps(frame.netTxKbps));
+        _scene.setText(ITEM_NET_TX, 112, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 70);
+    }
+
+    void drawDiskRow(const MetricsFrameV2& frame) {
+        int y = 188;
+        char buf[20];
+        _scene.setText(ITEM_DISK_LABEL, 8, y, "DISK", COLOR_GRAY, COLOR_BLACK, 1);
+        snprintf(buf, sizeof(buf), "R:%.1fM", kbpsToMBps(frame.diskReadKBps));
+        _scene.setText(ITEM_DISK_READ, 48, y, buf, COLOR_WHITE, COLOR_BLACK, 1, 78);
+        snprintf(buf, sizeof(buf), "W:%.1fM", kbpsToMBps(frame.diskWriteKBps));
+        _scene.setText(ITEM_DISK_WRITE, 128, y, buf, COLOR_WHITE, COLOR_BLACK, 1, 78);
+    }
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef PROGMEM_COMPAT_H
+#define PROGMEM_COMPAT_H
+
+// 讓 PROGMEM 常數表可同時在 ESP8266 與 native 測試環境編譯
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <stdint.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#endif
+
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#endif
+#endif
+
+#endif
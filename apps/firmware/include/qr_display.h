@@ -0,0 +1,136 @@
+#ifndef QR_DISPLAY_H
+#define QR_DISPLAY_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include "qr_layout.h"
+#include "qrcode.h"
+#include "tft_core.h"
+
+static const uint8_t QR_TEXT_MAX = 128;
+
+template <typename Tft>
+class QRDisplay {
+public:
+    QRDisplay(Tft& tft) : _tft(tft) {}
+
+    // 在 [top, bottom) 的整列寬度內置中繪製 QR Code，回傳是否有畫出來。
+    // 版本與 ECC 依內容長度挑選，模組大小取能放進這個區域的最大值。
+    // 編碼結果依文字快取，同一段文字再次顯示時不重新編碼；
+    // 留白框與所有模組在同一個位址視窗內逐列送出，每列先把模組合併成同色的水平區段再展開。
+    bool draw(const char* text, int16_t top = 0, int16_t bottom = TFT_HEIGHT) {
+        if (top < 0) top = 0;
+        if (bottom > TFT_HEIGHT) bottom = TFT_HEIGHT;
+        if (!text || !encode(text)) return false;
+
+        const uint8_t moduleSize = fitQrModuleSize(_qrcode.version, TFT_WIDTH, bottom - top);
+        if (moduleSize == 0) return false;
+        _moduleSize = moduleSize;
+
+        const uint16_t qrSize = _qrcode.size * moduleSize;
+        const int16_t padding = moduleSize * QR_QUIET_MODULES;
+        const int16_t totalSize = qrSize + padding * 2;
+
+        // 置中位置（含留白框）
+        const int16_t x0 = (TFT_WIDTH - totalSize) / 2;
+        const int16_t y0 = top + (bottom - top - totalSize) / 2;
+
+        uint16_t* row = _tft.lineBuffer();
+        const uint16_t white = tftPanelOrder(COLOR_WHITE);
+        const uint16_t black = tftPanelOrder(COLOR_BLACK);
+
+        _tft.startWrite();
+        _tft.openWindow(x0, y0, totalSize, totalSize);
+
+        // 上方留白
+        for (int16_t i = 0; i < totalSize; i++) {
+            row[i] = white;
+        }
+        for (int16_t r = 0; r < padding; r++) {
+            _tft.writePixels(row, totalSize);
+        }
+
+        for (uint8_t y = 0; y < _qrcode.size; y++) {
+            uint16_t* out = row + padding;
+            uint8_t x = 0;
+            while (x < _qrcode.size) {
+                const bool dark = qrcode_getModule(&_qrcode, x, y);
+                uint8_t run = 1;
+                while (x + run < _qrcode.size && qrcode_getModule(&_qrcode, x + run, y) == dark) {
+                    run++;
+                }
+                const uint16_t color = dark ? black : white;
+                for (uint16_t i = 0; i < (uint16_t)run * moduleSize; i++) {
+                    *out++ = color;
+                }
+                x += run;
+            }
+            // 左右留白保持白色，同一列像素重複 moduleSize 次
+            for (uint8_t r = 0; r < moduleSize; r++) {
+                _tft.writePixels(row, totalSize);
+            }
+            _tft.bus().yieldCpu();
+        }
+
+        // 下方留白
+        for (int16_t i = padding; i < padding + (int16_t)qrSize; i++) {
+            row[i] = white;
+        }
+        for (int16_t r = 0; r < padding; r++) {
+            _tft.writePixels(row, totalSize);
+        }
+        _tft.endWrite();
+        return true;
+    }
+
+    // 繪製 WiFi 連線用 QR Code
+    bool drawWiFiQR(const char* ssid, const char* password = nullptr,
+                    int16_t top = 0, int16_t bottom = TFT_HEIGHT) {
+        char qrText[QR_TEXT_MAX];
+        if (password && strlen(password) > 0) {
+            snprintf(qrText, sizeof(qrText), "WIFI:T:WPA;S:%s;P:%s;;", ssid, password);
+        } else {
+            snprintf(qrText, sizeof(qrText), "WIFI:T:nopass;S:%s;;", ssid);
+        }
+        return draw(qrText, top, bottom);
+    }
+
+    // 繪製 URL QR Code
+    bool drawURLQR(const char* url, int16_t top = 0, int16_t bottom = TFT_HEIGHT) {
+        return draw(url, top, bottom);
+    }
+
+    // 最後一次編碼的文字；沒有快取時為空字串
+    const char* cachedText() const { return _text; }
+    uint8_t version() const { return _text[0] != '\0' ? _qrcode.version : 0; }
+    uint8_t ecc() const { return _qrcode.ecc; }
+    uint8_t moduleSize() const { return _moduleSize; }
+
+private:
+    Tft& _tft;
+    QRCode _qrcode = {};
+    // 依最大版本配置的靜態緩衝，較小的版本共用同一塊，不在堆疊上開陣列
+    uint8_t _qrcodeData[QR_MAX_BUFFER_BYTES];
+    char _text[QR_TEXT_MAX] = {};
+    uint8_t _moduleSize = 0;
+
+    bool encode(const char* text) {
+        if (_text[0] != '\0' && strncmp(_text, text, sizeof(_text)) == 0) {
+            return true;
+        }
+
+        _text[0] = '\0';
+        const size_t len = strlen(text);
+        if (len >= sizeof(_text)) return false;
+
+        const QrSymbol symbol = selectQrSymbol(len);
+        if (symbol.version == 0) return false;
+        if (qrcode_initText(&_qrcode, _qrcodeData, symbol.version, symbol.ecc, text) < 0) return false;
+
+        memcpy(_text, text, len + 1);
+        return true;
+    }
+};
+
+#endif
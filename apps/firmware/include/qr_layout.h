@@ -0,0 +1,83 @@
+#ifndef QR_LAYOUT_H
+#define QR_LAYOUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 支援的最大 QR 版本：45x45 模組，byte 模式 ECC_LOW 可放 154 字元，
+// 足以容納最長的 WiFi 字串（32 字元 SSID + 63 字元密碼）
+static const uint8_t QR_MAX_VERSION = 7;
+// 四周留白的模組數
+static const uint8_t QR_QUIET_MODULES = 2;
+// 模組最大像素數，避免很短的內容撐滿整個畫面
+static const uint8_t QR_MAX_MODULE_SIZE = 8;
+
+// 與 QRCode 函式庫相同的 ECC 等級編號（ECC_LOW..ECC_HIGH）
+static const uint8_t QR_ECC_LEVELS = 4;
+
+static inline constexpr uint8_t qrModuleCount(uint8_t version) {
+    return (uint8_t)(4 * version + 17);
+}
+
+// qrcode_getBufferSize 在函式庫中不是常數運算式，靜態緩衝的大小在這裡算
+static inline constexpr uint16_t qrBufferBytes(uint8_t version) {
+    return (uint16_t)(((uint16_t)qrModuleCount(version) * qrModuleCount(version) + 7) / 8);
+}
+
+static const uint16_t QR_MAX_BUFFER_BYTES = qrBufferBytes(QR_MAX_VERSION);
+
+// byte 模式容量（字元數），列：版本 1..QR_MAX_VERSION，欄：ECC_LOW, MEDIUM, QUARTILE, HIGH。
+// 函式庫遇到純數字/英數字會自動改用更緊湊的模式，因此以 byte 模式判斷一定放得下
+static const uint8_t QR_BYTE_CAPACITY[QR_MAX_VERSION][QR_ECC_LEVELS] = {
+    {17, 14, 11, 7},
+    {32, 26, 20, 14},
+    {53, 42, 32, 24},
+    {78, 62, 46, 34},
+    {106, 84, 60, 44},
+    {134, 106, 74, 58},
+    {154, 122, 86, 64},
+};
+
+static inline uint8_t qrByteCapacity(uint8_t version, uint8_t ecc) {
+    if (version < 1 || version > QR_MAX_VERSION || ecc >= QR_ECC_LEVELS) return 0;
+    return QR_BYTE_CAPACITY[version - 1][ecc];
+}
+
+struct QrSymbol {
+    uint8_t version;  // 0 表示放不下
+    uint8_t ecc;
+};
+
+// 選放得下的最小版本（模組越少、每個模組越大越好掃）；
+// 同一版本內再把 ECC 提到仍放得下的最高等級，不增加模組數就多一點容錯
+static inline QrSymbol selectQrSymbol(size_t length, uint8_t maxVersion = QR_MAX_VERSION) {
+    QrSymbol symbol = {0, 0};
+    if (maxVersion > QR_MAX_VERSION) maxVersion = QR_MAX_VERSION;
+
+    for (uint8_t version = 1; version <= maxVersion; version++) {
+        if (length > qrByteCapacity(version, 0)) continue;
+
+        symbol.version = version;
+        for (uint8_t ecc = QR_ECC_LEVELS - 1; ecc > 0; ecc--) {
+            if (length <= qrByteCapacity(version, ecc)) {
+                symbol.ecc = ecc;
+                break;
+            }
+        }
+        return symbol;
+    }
+    return symbol;
+}
+
+// 含留白框在 width x height 區域內能用的最大模組像素數；放不下時回傳 0
+static inline uint8_t fitQrModuleSize(uint8_t version, int16_t width, int16_t height) {
+    if (version < 1 || width <= 0 || height <= 0) return 0;
+
+    const int16_t span = qrModuleCount(version) + QR_QUIET_MODULES * 2;
+    const int16_t side = width < height ? width : height;
+    int16_t moduleSize = side / span;
+    if (moduleSize > QR_MAX_MODULE_SIZE) moduleSize = QR_MAX_MODULE_SIZE;
+    return (uint8_t)moduleSize;
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef SCENE_COMPOSITOR_H
+#define SCENE_COMPOSITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aa_font.h"
+#include "band_renderer.h"
+#include "damage_region.h"
+#include "tft_core.h"
+
+static const uint8_t SCENE_TEXT_MAX_CHARS = 31;
+
+enum SceneItemKind : uint8_t {
+    SCENE_ITEM_NONE = 0,
+    SCENE_ITEM_FILL,
+    SCENE_ITEM_TEXT,
+    SCENE_ITEM_AA_TEXT
+};
+
+// 畫面上的一個元素：實心矩形、帶背景的固定寬度文字（等同 drawStringPadded），
+// 或比例寬度的反鋸齒文字（等同 drawAAText）
+struct SceneItem {
+    uint8_t kind;
+    bool stale;
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    int16_t minWidth;
+    uint16_t color;
+    uint16_t bg;
+    uint8_t size;
+    uint8_t len;
+    const AAFont* font;
+    char text[SCENE_TEXT_MAX_CHARS + 1];
+};
+
+// 保留模式的畫面合成：呼叫端以固定 id 描述畫面元素，
+// 合成器比對上一次的內容記下受損矩形（文字只記變動的字元格），
+// flush 時每個受損矩形開一個視窗，逐列由下而上合成所有元素，
+// 再透過 BandRenderer 以 StripHeight 列為一條送出。
+// 版面相同的頁面切換只會重畫數值，不需要先清掉 57,600 個像素。
+template <typename Tft, uint8_t Slots, uint8_t MaxRects = 12, uint8_t StripHeight = TFT_DEFAULT_BAND_HEIGHT>
+class SceneCompositor {
+public:
+    explicit SceneCompositor(Tft& tft, uint16_t background = COLOR_BLACK)
+        : _tft(tft), _bands(tft), _background(background) {
+        _damage.addAll();
+    }
+
+    // 面板內容未知（開機或被其他畫面蓋過）：下次 flush 重畫整個畫面
+    void invalidate() {
+        _damage.addAll();
+    }
+
+    // 開始描述新的一頁：之後沒有再設定的元素會在 flush 時移除
+    void beginScene() {
+        for (uint8_t i = 0; i < Slots; i++) {
+            _items[i].stale = _items[i].kind != SCENE_ITEM_NONE;
+        }
+    }
+
+    void setFill(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (id >= Slots) return;
+
+        SceneItem& item = _items[id];
+        item.stale = false;
+        if (item.kind == SCENE_ITEM_FILL && item.x == x && item.y == y &&
+            item.w == w && item.h == h && item.color == color) {
+            return;
+        }
+
+        damageItem(item);
+        item.kind = SCENE_ITEM_FILL;
+        item.x = x;
+        item.y = y;
+        item.w = w;
+        item.h = h;
+        item.color = color;
+        damageItem(item);
+    }
+
+    // 寬度為 max(minWidth, 字串寬)，超過 SCENE_TEXT_MAX_CHARS 的部分截斷
+    void setText(uint8_t id, int16_t x, int16_t y, const char* text,
+                 uint16_t color, uint16_t bg, uint8_t size, int16_t minWidth = 0) {
+        if (id >= Slots || !text || size == 0) return;
+
+        size_t len = strlen(text);
+        if (len > SCENE_TEXT_MAX_CHARS) len = SCENE_TEXT_MAX_CHARS;
+
+        SceneItem& item = _items[id];
+        item.stale = false;
+        const int32_t cellW = (int32_t)FONT_WIDTH * size;
+        const int32_t textW = (int32_t)len * cellW;
+        const int16_t w = (int16_t)(textW > minWidth ? textW : minWidth);
+
+        if (item.kind == SCENE_ITEM_TEXT && item.x == x && item.y == y && item.size == size &&
+            item.minWidth == minWidth && item.color == color && item.bg == bg) {
+            damageChangedCells(item, text, len, w);
+        } else {
+            damageItem(item);
+            item.kind = SCENE_ITEM_TEXT;
+            item.x = x;
+            item.y = y;
+            item.h = (int16_t)(FONT_HEIGHT * size);
+            item.minWidth = minWidth;
+            item.color = color;
+            item.bg = bg;
+            item.size = size;
+            item.w = w;
+            damageItem(item);
+        }
+
+        memcpy(item.text, text, len);
+        item.text[len] = '\0';
+        item.len = (uint8_t)len;
+        item.w = w;
+    }
+
+    // 反鋸齒文字，寬度為 max(minWidth, 字串寬)。同位置同字型同顏色時，只重畫第一個不同的字元之後的部分
+    void setAAText(uint8_t id, int16_t x, int16_t y, const char* text, const AAFont& font,
+                   uint16_t color, uint16_t bg, int16_t minWidth = 0) {
+        if (id >= Slots || !text) return;
+
+        size_t len = strlen(text);
+        if (len > SCENE_TEXT_MAX_CHARS) len = SCENE_TEXT_MAX_CHARS;
+
+        SceneItem& item = _items[id];
+        item.stale = false;
+        const int32_t textW = aaTextWidth(font, text, len);
+        const int16_t w = (int16_t)(textW > minWidth ? textW : minWidth);
+
+        if (item.kind == SCENE_ITEM_AA_TEXT && item.x == x && item.y == y && item.font == &font &&
+            item.minWidth == minWidth && item.color == color && item.bg == bg) {
+            size_t same = 0;
+            while (same < len && same < item.len && text[same] == item.text[same]) same++;
+            if (same < len || same < item.len || w != item.w) {
+                const int32_t from = aaTextWidth(font, text, same);
+                const int16_t wider = w > item.w ? w : item.w;
+                _damage.add((int16_t)(x + from), y, (int16_t)(wider - from), item.h);
+            }
+        } else {
+            damageItem(item);
+            item.kind = SCENE_ITEM_AA_TEXT;
+            item.x = x;
+            item.y = y;
+            item.h = font.lineHeight;
+            item.minWidth = minWidth;
+            item.color = color;
+            item.bg = bg;
+            item.size = 1;
+            item.font = &font;
+            item.w = w;
+            damageItem(item);
+        }
+
+        memcpy(item.text, text, len);
+        item.text[len] = '\0';
+        item.len = (uint8_t)len;
+        item.w = w;
+    }
+
+    // 水平置中，位置算法與 TFTCore::drawStringCentered 相同
+    void setTextCentered(uint8_t id, int16_t y, const char* text, uint16_t color, uint16_t bg, uint8_t size) {
+        if (!text) return;
+        int16_t len = strlen(text);
+        int16_t x = (TFT_WIDTH - len * FONT_WIDTH * size) / 2;
+        setText(id, x, y, text, color, bg, size);
+    }
+
+    void remove(uint8_t id) {
+        if (id >= Slots) return;
+        damageItem(_items[id]);
+        _items[id].kind = SCENE_ITEM_NONE;
+        _items[id].stale = false;
+    }
+
+    // 移除這一頁沒有用到的元素，然後把受損區域合成送出
+    void flush() {
+        for (uint8_t i = 0; i < Slots; i++) {
+            if (_items[i].stale) {
+                remove(i);
+            }
+        }
+
+        if (_damage.count() == 0) return;
+
+        // 所有受損矩形在同一段 CS 內送出
+        _tft.startWrite();
+        for (uint8_t i = 0; i < _damage.count(); i++) {
+            _bands.render(_damage.rect(i), [this](uint16_t* dst, int16_t x0, int16_t x1, int16_t y) {
+                composeRow(dst, x0, x1, y);
+            });
+        }
+        _tft.endWrite();
+        _damage.clear();
+    }
+
+    const DamageRegion<MaxRects>& damage() const { return _damage; }
+
+private:
+    Tft& _tft;
+    BandRenderer<Tft, StripHeight> _bands;
+    uint16_t _background;
+    SceneItem _items[Slots] = {};
+    DamageRegion<MaxRects> _damage;
+
+    void damageItem(const SceneItem& item) {
+        if (item.kind != SCENE_ITEM_NONE) {
+            _damage.add(item.x, item.y, item.w, item.h);
+        }
+    }
+
+    // 同位置同顏色的文字：只記錄內容不同的字元格，以及新舊寬度差出來的部分
+    void damageChangedCells(const SceneItem& item, const char* text, size_t len, int16_t newW) {
+        const int32_t cellW = (int32_t)FONT_WIDTH * item.size;
+        const int32_t common = newW < item.w ? newW : item.w;
+        const int32_t wider = newW > item.w ? newW : item.w;
+
+        int32_t runStart = -1;
+        for (int32_t cell = 0; cell * cellW < common; cell++) {
+            bool changed = cellChar(text, len, cell) != cellChar(item.text, item.len, cell);
+            if (changed && runStart < 0) {
+                runStart = cell * cellW;
+            } else if (!changed && runStart >= 0) {
+                _damage.add((int16_t)(item.x + runStart), item.y, (int16_t)(cell * cellW - runStart), item.h);
+                runStart = -1;
+            }
+        }
+        if (runStart >= 0) {
+            _damage.add((int16_t)(item.x + runStart), item.y, (int16_t)(common - runStart), item.h);
+        }
+
+        if (wider > common) {
+            _damage.add((int16_t)(item.x + common), item.y, (int16_t)(wider - common), item.h);
+        }
+    }
+
+    static char cellChar(const char* text, size_t len, int32_t index) {
+        return (size_t)index < len ? text[index] : ' ';
+    }
+
+    // 依 id 順序由下往上疊：背景色 -> 各元素在這一列 [x0, x1) 的部分
+    void composeRow(uint16_t* dst, int16_t x0, int16_t x1, int16_t y) {
+        const uint16_t bgp = tftPanelOrder(_background);
+        for (int16_t x = x0; x < x1; x++) {
+            dst[x - x0] = bgp;
+        }
+
+        for (uint8_t i = 0; i < Slots; i++) {
+            const SceneItem& item = _items[i];
+            if (item.kind == SCENE_ITEM_NONE || y < item.y || y >= item.y + item.h) {
+                continue;
+            }
+
+            const int32_t c0 = x0 > item.x ? x0 - item.x : 0;
+            const int32_t c1 = x1 < item.x + item.w ? x1 - item.x : item.w;
+            if (c0 >= c1) continue;
+
+            uint16_t* out = dst + (item.x + c0 - x0);
+            if (item.kind == SCENE_ITEM_FILL) {
+                const uint16_t color = tftPanelOrder(item.color);
+                for (int32_t c = c0; c < c1; c++) {
+                    *out++ = color;
+                }
+            } else if (item.kind == SCENE_ITEM_AA_TEXT) {
+                uint16_t palette[4];
+                aaBuildPalette(palette, item.color, item.bg);
+                for (uint8_t a = 0; a < 4; a++) {
+                    palette[a] = tftPanelOrder(palette[a]);
+                }
+                aaExpandTextRow(out, *item.font, item.text, item.len, (uint8_t)(y - item.y), c0, c1, palette);
+            } else {
+                Tft::expandTextRow(out, item.text, item.len, (uint8_t)((y - item.y) / item.size),
+                                   c0, c1, item.size, tftPanelOrder(item.color), tftPanelOrder(item.bg));
+            }
+        }
+    }
+};
+
+#endif
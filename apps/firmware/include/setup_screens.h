@@ -0,0 +1,42 @@
+#ifndef SETUP_SCREENS_H
+#define SETUP_SCREENS_H
+
+#include <stdio.h>
+
+#include "qr_display.h"
+#include "tft_core.h"
+
+// 開機/設定流程中帶 QR Code 的畫面
+
+// QR 可用的區域：第 45 列的小字（高 16）之下、第 210 列的 IP 之上，各留 2 像素
+static const int16_t SETUP_QR_TOP = 63;
+static const int16_t SETUP_QR_BOTTOM = 208;
+
+// AP 設定模式：掃描 QR 連上設定熱點
+template <typename Tft>
+void drawApSetupScreen(Tft& tft, QRDisplay<Tft>& qr, const char* apSsid, const char* ip) {
+    tft.fillScreen(COLOR_BLACK);
+
+    tft.drawStringCentered(10, "WiFi Setup", COLOR_CYAN, COLOR_BLACK, 2);
+    tft.drawStringCentered(45, apSsid, COLOR_WHITE, COLOR_BLACK, 1);
+
+    qr.drawWiFiQR(apSsid, nullptr, SETUP_QR_TOP, SETUP_QR_BOTTOM);
+
+    tft.drawStringCentered(210, ip, COLOR_YELLOW, COLOR_BLACK, 1);
+}
+
+// WiFi 已連線：掃描 QR 開啟 WebUI
+template <typename Tft>
+void drawWifiConnectedScreen(Tft& tft, QRDisplay<Tft>& qr, const char* ssid, const char* ip) {
+    tft.fillScreen(COLOR_BLACK);
+    tft.drawStringCentered(10, "Connected", COLOR_GREEN, COLOR_BLACK, 2);
+    tft.drawStringCentered(45, ssid, COLOR_WHITE, COLOR_BLACK, 1);
+
+    char url[64];
+    snprintf(url, sizeof(url), "http://%s/monitor", ip);
+    qr.drawURLQR(url, SETUP_QR_TOP, SETUP_QR_BOTTOM);
+
+    tft.drawStringCentered(210, ip, COLOR_YELLOW, COLOR_BLACK, 1);
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SPI_CLOCK_POLICY_H
+#define SPI_CLOCK_POLICY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 保守時脈：任何面板都能穩定運作，也是讀回不可用時的預設值
+static const uint32_t TFT_SPI_SAFE_HZ = 10000000UL;
+
+// 校正時嘗試的最高時脈，可用 -DTFT_SPI_MAX_HZ=40000000 限制
+#ifndef TFT_SPI_MAX_HZ
+#define TFT_SPI_MAX_HZ 80000000UL
+#endif
+
+// ESP8266 HSPI 由 80 MHz 整數分頻，只列實際能產生的頻率（由快到慢）
+static const uint32_t TFT_SPI_CLOCK_STEPS_HZ[] = {
+    80000000UL, 40000000UL, 26666666UL, 20000000UL, 16000000UL, 13333333UL, TFT_SPI_SAFE_HZ};
+static const uint8_t TFT_SPI_CLOCK_STEP_COUNT = sizeof(TFT_SPI_CLOCK_STEPS_HZ) / sizeof(TFT_SPI_CLOCK_STEPS_HZ[0]);
+
+// 每個候選時脈需連續通過的寫入/讀回次數
+static const uint8_t TFT_SPI_CALIBRATION_TRIALS = 3U;
+// 執行中重新驗證目前時脈的間隔
+static const uint32_t TFT_SPI_HEALTH_CHECK_MS = 30000UL;
+
+enum SpiClockStatus : uint8_t {
+    SPI_CLOCK_DEFAULT = 0,   // 尚未校正
+    SPI_CLOCK_VERIFIED,      // 寫入/讀回驗證通過
+    SPI_CLOCK_UNVERIFIED,    // 面板無法讀回，使用保守時脈
+    SPI_CLOCK_FAILED,        // 連保守時脈都驗證失敗
+    SPI_CLOCK_DEGRADED       // 執行中發現資料錯誤，已降速
+};
+
+struct SpiClockState {
+    uint32_t hz;
+    uint8_t status;
+    uint8_t fallbacks;  // 校正或執行中降速的次數
+};
+
+static inline const char* spiClockStatusToString(uint8_t status) {
+    switch (status) {
+        case SPI_CLOCK_VERIFIED:
+            return "verified";
+        case SPI_CLOCK_UNVERIFIED:
+            return "unverified";
+        case SPI_CLOCK_FAILED:
+            return "failed";
+        case SPI_CLOCK_DEGRADED:
+            return "degraded";
+        default:
+            return "default";
+    }
+}
+
+// 比 hz 慢一階的時脈；已在保守時脈（或更慢）則回傳 0
+static inline uint32_t nextLowerSpiClockHz(uint32_t hz) {
+    for (uint8_t i = 0; i < TFT_SPI_CLOCK_STEP_COUNT; i++) {
+        if (TFT_SPI_CLOCK_STEPS_HZ[i] < hz) {
+            return TFT_SPI_CLOCK_STEPS_HZ[i];
+        }
+    }
+    return 0;
+}
+
+// 由快到慢嘗試每個不超過 maxHz 的時脈，選第一個連續通過 trials 次驗證的。
+// Probe 需提供：
+//   bool canReadBack();              // 面板是否能讀回（板子沒有 MISO 時由 SDA 讀）
+//   bool verifyClock(uint32_t hz);   // 以 hz 寫入測試圖樣後讀回比對
+template <typename Probe>
+SpiClockState calibrateSpiClock(Probe& probe, uint32_t maxHz = TFT_SPI_MAX_HZ,
+                                uint8_t trials = TFT_SPI_CALIBRATION_TRIALS) {
+    SpiClockState state = {TFT_SPI_SAFE_HZ, SPI_CLOCK_UNVERIFIED, 0};
+    if (!probe.canReadBack()) {
+        return state;
+    }
+
+    for (uint8_t i = 0; i < TFT_SPI_CLOCK_STEP_COUNT; i++) {
+        const uint32_t hz = TFT_SPI_CLOCK_STEPS_HZ[i];
+        if (hz > maxHz) {
+            continue;
+        }
+
+        bool stable = true;
+        for (uint8_t t = 0; t < trials && stable; t++) {
+            stable = probe.verifyClock(hz);
+        }
+        if (stable) {
+            state.hz = hz;
+            state.status = SPI_CLOCK_VERIFIED;
+            return state;
+        }
+        state.fallbacks++;
+    }
+
+    state.status = SPI_CLOCK_FAILED;
+    return state;
+}
+
+// 執行中驗證失敗：降一階。已在保守時脈則維持不變並回傳 false
+static inline bool applySpiClockFault(SpiClockState& state) {
+    uint32_t lower = nextLowerSpiClockHz(state.hz);
+    if (lower == 0) {
+        state.status = SPI_CLOCK_FAILED;
+        return false;
+    }
+
+    state.hz = lower;
+    state.status = SPI_CLOCK_DEGRADED;
+    state.fallbacks++;
+    return true;
+}
+
+#endif
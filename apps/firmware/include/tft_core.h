@@ -0,0 +1,382 @@
+#ifndef TFT_CORE_H
+#define TFT_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aa_font.h"
+#include "font_8x16.h"
+#include "font_atlas_2x.h"
+
+#define TFT_WIDTH  240
+#define TFT_HEIGHT 240
+
+// 顏色定義 (RGB565)
+#define COLOR_BLACK   0x0000
+#define COLOR_WHITE   0xFFFF
+#define COLOR_RED     0xF800
+#define COLOR_GREEN   0x07E0
+#define COLOR_BLUE    0x001F
+#define COLOR_YELLOW  0xFFE0
+#define COLOR_CYAN    0x07FF
+#define COLOR_MAGENTA 0xF81F
+#define COLOR_GRAY    0x8410
+
+// ST7789 指令
+static const uint8_t TFT_CMD_CASET = 0x2A;
+static const uint8_t TFT_CMD_RASET = 0x2B;
+static const uint8_t TFT_CMD_RAMWR = 0x2C;
+
+// 大面積填充後讓出 CPU 的像素門檻
+static const uint32_t TFT_YIELD_PIXEL_THRESHOLD = 512U;
+
+// 文字掃描線緩衝（像素數），一次可容納一整列螢幕寬度
+static const uint16_t TFT_LINE_BUFFER_PIXELS = TFT_WIDTH;
+
+// 像素緩衝區以面板位元組順序（高位元組在前）存放，
+// 在 little-endian 的 ESP8266 上可直接整塊送進 SPI FIFO。
+static inline uint16_t tftPanelOrder(uint16_t color) {
+    return (uint16_t)((color << 8) | (color >> 8));
+}
+
+// 與硬體無關的繪圖核心。Bus 需提供：
+//   void startWrite();                                        // 拉低 CS（可巢狀）
+//   void endWrite();                                          // 最外層結束時放開 CS
+//   void writeCommand(uint8_t cmd);
+//   void writeData(const uint8_t* data, uint16_t len);
+//   void writeColor(uint16_t color, uint32_t count);          // 重複同一顏色
+//   void writePixels(const uint16_t* pixels, uint32_t count); // 面板順序像素
+//   void yieldCpu();
+// write* 只能在 startWrite/endWrite 之間呼叫；每個繪圖函式整段只拉一次 CS。
+// ESP8266 使用 SPI FIFO 實作（tft_driver.h），native 測試可替換成計數或虛擬面板。
+template <typename Bus>
+class TFTCore {
+public:
+    Bus& bus() { return _bus; }
+
+    // 因視窗快取而省下的 CASET/RASET 指令數（每個含 4 bytes 參數）
+    uint32_t addrCommandsElided() const { return _addrCommandsElided; }
+    void resetAddrCommandsElided() { _addrCommandsElided = 0; }
+
+    // 面板重設、或 SPI 可能送錯位址時呼叫，下一次視窗兩軸都重送
+    void invalidateAddrWindow() { _winValid = false; }
+
+    void fillScreen(uint16_t color) {
+        _bus.startWrite();
+        setAddrWindow(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
+        _bus.writeColor(color, (uint32_t)TFT_WIDTH * TFT_HEIGHT);
+        _bus.endWrite();
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (!clipRect(x, y, w, h)) return;
+
+        _bus.startWrite();
+        setAddrWindow(x, y, x + w - 1, y + h - 1);
+        uint32_t total = (uint32_t)w * h;
+        _bus.writeColor(color, total);
+        _bus.endWrite();
+        if (total > TFT_YIELD_PIXEL_THRESHOLD) _bus.yieldCpu();  // 大面積填充後讓出 CPU
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x < 0 || x >= TFT_WIDTH || y < 0 || y >= TFT_HEIGHT) return;
+
+        _bus.startWrite();
+        setAddrWindow(x, y, x, y);
+        _bus.writeColor(color, 1);
+        _bus.endWrite();
+    }
+
+    // 將 w*h 面板順序像素以單一視窗送出，超出螢幕的部分逐列裁切
+    void pushPixels(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+        if (!pixels) return;
+
+        int16_t cx = x, cy = y, cw = w, ch = h;
+        if (!clipRect(cx, cy, cw, ch)) return;
+
+        _bus.startWrite();
+        setAddrWindow(cx, cy, cx + cw - 1, cy + ch - 1);
+        const uint16_t* src = pixels + (int32_t)(cy - y) * w + (cx - x);
+        if (cw == w) {
+            _bus.writePixels(src, (uint32_t)cw * ch);
+        } else {
+            for (int16_t row = 0; row < ch; row++) {
+                _bus.writePixels(src, cw);
+                src += w;
+            }
+        }
+        _bus.endWrite();
+        if ((uint32_t)cw * ch > TFT_YIELD_PIXEL_THRESHOLD) _bus.yieldCpu();
+    }
+
+    // SPI 時脈驗證用：CASET/RASET 也必須以受測時脈送出，所以不走視窗快取
+    void pushPixelsUncached(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+        invalidateAddrWindow();
+        pushPixels(x, y, w, h, pixels);
+    }
+
+    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        if (!isFontChar(c)) return;
+
+        drawTextRun(x, y, &c, 1, color, bg, size);
+    }
+
+    // 整個字串共用一個位址視窗，逐掃描線串流
+    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        drawTextRun(x, y, str, strlen(str), color, bg, size);
+        _bus.yieldCpu();  // 讓 WiFi/TCP stack 處理封包
+    }
+
+    // 繪製固定寬度字串：文字與尾端背景補白組成同一個視窗一次送出，無閃爍
+    void drawStringPadded(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size, int16_t totalWidth) {
+        drawTextRun(x, y, str, strlen(str), color, bg, size, totalWidth);
+        _bus.yieldCpu();
+    }
+
+    void drawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        int16_t len = strlen(str);
+        int16_t x = (TFT_WIDTH - len * FONT_WIDTH * size) / 2;
+        drawString(x, y, str, color, bg, size);
+    }
+
+    // 以單一位址視窗畫出 len 個字元：每條掃描線把字形展開進 _line，
+    // 放大倍率靠重複像素與複製整列完成，緩衝區滿了才送出。
+    // 文字不足 minWidth 時右側以背景色補滿；字型外的字元畫成背景色。
+    void drawTextRun(int16_t x, int16_t y, const char* str, size_t len,
+                     uint16_t color, uint16_t bg, uint8_t size, int16_t minWidth = 0) {
+        if (!str || size == 0) return;
+
+        const int32_t cellW = (int32_t)FONT_WIDTH * size;
+        const int32_t textW = (int32_t)len * cellW;
+        const int32_t runW = textW > minWidth ? textW : minWidth;
+        const int32_t runH = (int32_t)FONT_HEIGHT * size;
+
+        // 可見範圍（相對於字串左上角）
+        const int32_t c0 = x < 0 ? -x : 0;
+        const int32_t c1 = runW < TFT_WIDTH - x ? runW : TFT_WIDTH - x;
+        const int32_t r0 = y < 0 ? -y : 0;
+        const int32_t r1 = runH < TFT_HEIGHT - y ? runH : TFT_HEIGHT - y;
+        if (c0 >= c1 || r0 >= r1) return;
+
+        _bus.startWrite();
+        setAddrWindow(x + c0, y + r0, x + c1 - 1, y + r1 - 1);
+
+        const uint16_t fg = tftPanelOrder(color);
+        const uint16_t bgp = tftPanelOrder(bg);
+        const uint16_t visW = (uint16_t)(c1 - c0);
+        uint16_t used = 0;
+
+        for (int32_t r = r0; r < r1;) {
+            const uint8_t glyphRow = (uint8_t)(r / size);
+            int32_t rowEnd = (int32_t)(glyphRow + 1) * size;
+            if (rowEnd > r1) rowEnd = r1;
+
+            if (used + visW > TFT_LINE_BUFFER_PIXELS) {
+                _bus.writePixels(_line, used);
+                used = 0;
+            }
+            uint16_t* row = _line + used;
+            expandTextRow(row, str, len, glyphRow, c0, c1, size, fg, bgp);
+            used += visW;
+
+            // 放大時同一字形列重複 size 次
+            for (int32_t k = r + 1; k < rowEnd; k++) {
+                if (used + visW <= TFT_LINE_BUFFER_PIXELS) {
+                    memcpy(_line + used, row, visW * sizeof(uint16_t));
+                    used += visW;
+                    continue;
+                }
+                // 緩衝區已滿：送出後把來源列搬到開頭，當作這一次的重複
+                _bus.writePixels(_line, used);
+                memmove(_line, row, visW * sizeof(uint16_t));
+                row = _line;
+                used = visW;
+            }
+            r = rowEnd;
+        }
+
+        if (used > 0) {
+            _bus.writePixels(_line, used);
+        }
+        _bus.endWrite();
+    }
+
+    // 比例寬度的反鋸齒文字：整段只開一個視窗，每列依 alpha 與已知背景色混色後送出。
+    // 文字不足 minWidth 時右側以背景色補滿，回傳含補白的總寬度。
+    int16_t drawAAText(int16_t x, int16_t y, const char* str, const AAFont& font,
+                       uint16_t color, uint16_t bg, int16_t minWidth = 0) {
+        if (!str) return 0;
+
+        const size_t len = strlen(str);
+        const int32_t textW = aaTextWidth(font, str, len);
+        const int32_t runW = textW > minWidth ? textW : minWidth;
+        const int32_t runH = font.lineHeight;
+
+        const int32_t c0 = x < 0 ? -x : 0;
+        const int32_t c1 = runW < TFT_WIDTH - x ? runW : TFT_WIDTH - x;
+        const int32_t r0 = y < 0 ? -y : 0;
+        const int32_t r1 = runH < TFT_HEIGHT - y ? runH : TFT_HEIGHT - y;
+        if (c0 >= c1 || r0 >= r1) return (int16_t)runW;
+
+        uint16_t palette[4];
+        aaBuildPalette(palette, color, bg);
+        for (uint8_t a = 0; a < 4; a++) {
+            palette[a] = tftPanelOrder(palette[a]);
+        }
+
+        _bus.startWrite();
+        setAddrWindow(x + c0, y + r0, x + c1 - 1, y + r1 - 1);
+        for (int32_t r = r0; r < r1; r++) {
+            aaExpandTextRow(_line, font, str, len, (uint8_t)r, c0, c1, palette);
+            _bus.writePixels(_line, (uint32_t)(c1 - c0));
+        }
+        _bus.endWrite();
+        return (int16_t)runW;
+    }
+
+    // 把多次繪圖包在同一段 CS 內（可巢狀）；openWindow/writePixels 需在這之間呼叫
+    void startWrite() {
+        _bus.startWrite();
+    }
+
+    void endWrite() {
+        _bus.endWrite();
+    }
+
+    // 由呼叫端自行合成像素時使用：開一個已裁切好的視窗，再以 writePixels 分段送出 w*h 像素
+    void openWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+        setAddrWindow(x, y, x + w - 1, y + h - 1);
+    }
+
+    void writePixels(const uint16_t* pixels, uint32_t count) {
+        if (count > 0) _bus.writePixels(pixels, count);
+    }
+
+    // 共用的一列掃描線緩衝（TFT_LINE_BUFFER_PIXELS 像素），給呼叫端合成像素時使用以免在堆疊上開陣列；
+    // 使用期間不可呼叫 drawString 等同樣會寫入它的文字函式
+    uint16_t* lineBuffer() { return _line; }
+
+    static bool isFontChar(char c) {
+        uint8_t code = (uint8_t)c;
+        return code >= FONT_FIRST_CHAR && code <= FONT_LAST_CHAR;
+    }
+
+    // 把字串第 glyphRow 列、可見欄 [c0, c1) 展開成面板順序像素，c1 超過字串寬的部分補背景色
+    static void expandTextRow(uint16_t* dst, const char* str, size_t len, uint8_t glyphRow,
+                              int32_t c0, int32_t c1, uint8_t size, uint16_t fg, uint16_t bg) {
+        const int32_t cellW = (int32_t)FONT_WIDTH * size;
+#if TFT_FONT_ATLAS_2X
+        // 預先放大的遮罩每 2 位元對應一組相鄰像素
+        const uint16_t pairs[4][2] = {{bg, bg}, {bg, fg}, {fg, bg}, {fg, fg}};
+#endif
+
+        for (size_t i = (size_t)(c0 / cellW); i < len && (int32_t)i * cellW < c1; i++) {
+            const int32_t cellStart = (int32_t)i * cellW;
+            const bool wholeCell = cellStart >= c0 && cellStart + cellW <= c1;
+
+#if TFT_FONT_ATLAS_2X
+            if (size == 2 && wholeCell) {
+                const uint8_t glyph = font2xGlyph(str[i]);
+                if (glyph != FONT_2X_NONE) {
+                    const uint16_t mask = font2xRow(glyph, glyphRow);
+                    for (int8_t shift = 14; shift >= 0; shift -= 2) {
+                        memcpy(dst, pairs[(mask >> shift) & 3], sizeof(pairs[0]));
+                        dst += 2;
+                    }
+                    continue;
+                }
+            }
+#endif
+
+            uint8_t bits = 0;
+            if (isFontChar(str[i])) {
+                uint16_t index = ((uint8_t)str[i] - FONT_FIRST_CHAR) * FONT_HEIGHT + glyphRow;
+                bits = pgm_read_byte(&font_8x16[index]);
+            }
+
+            if (wholeCell) {
+                for (uint8_t col = 0; col < FONT_WIDTH; col++) {
+                    uint16_t px = (bits & (0x80 >> col)) ? fg : bg;
+                    for (uint8_t s = 0; s < size; s++) {
+                        *dst++ = px;
+                    }
+                }
+                continue;
+            }
+
+            // 螢幕邊緣被裁切的字元
+            const int32_t from = cellStart > c0 ? cellStart : c0;
+            const int32_t to = cellStart + cellW < c1 ? cellStart + cellW : c1;
+            for (int32_t col = from; col < to; col++) {
+                uint8_t bit = (uint8_t)((col - cellStart) / size);
+                *dst++ = (bits & (0x80 >> bit)) ? fg : bg;
+            }
+        }
+
+        // 尾端補白
+        const int32_t textW = (int32_t)len * cellW;
+        for (int32_t col = textW > c0 ? textW : c0; col < c1; col++) {
+            *dst++ = bg;
+        }
+    }
+
+protected:
+    Bus _bus;
+    alignas(4) uint16_t _line[TFT_LINE_BUFFER_PIXELS];
+
+    static bool clipRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+        if (x >= TFT_WIDTH || y >= TFT_HEIGHT || w <= 0 || h <= 0) return false;
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > TFT_WIDTH) w = TFT_WIDTH - x;
+        if (y + h > TFT_HEIGHT) h = TFT_HEIGHT - y;
+        return w > 0 && h > 0;
+    }
+
+    // 面板會記住上一次的 CASET/RASET，範圍沒變的那一軸就不再送（RAMWR 一律重送以重設寫入位置）
+    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+        alignas(4) uint8_t buf[4];
+
+        if (_winValid && x0 == _winX0 && x1 == _winX1) {
+            _addrCommandsElided++;
+        } else {
+            buf[0] = x0 >> 8;
+            buf[1] = x0 & 0xFF;
+            buf[2] = x1 >> 8;
+            buf[3] = x1 & 0xFF;
+            _bus.writeCommand(TFT_CMD_CASET);
+            _bus.writeData(buf, sizeof(buf));
+        }
+
+        if (_winValid && y0 == _winY0 && y1 == _winY1) {
+            _addrCommandsElided++;
+        } else {
+            buf[0] = y0 >> 8;
+            buf[1] = y0 & 0xFF;
+            buf[2] = y1 >> 8;
+            buf[3] = y1 & 0xFF;
+            _bus.writeCommand(TFT_CMD_RASET);
+            _bus.writeData(buf, sizeof(buf));
+        }
+
+        _bus.writeCommand(TFT_CMD_RAMWR);
+
+        _winX0 = x0;
+        _winX1 = x1;
+        _winY0 = y0;
+        _winY1 = y1;
+        _winValid = true;
+    }
+
+private:
+    uint16_t _winX0 = 0;
+    uint16_t _winY0 = 0;
+    uint16_t _winX1 = 0;
+    uint16_t _winY1 = 0;
+    bool _winValid = false;
+    uint32_t _addrCommandsElided = 0;
+};
+
+#endif
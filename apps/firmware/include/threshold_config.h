@@ -0,0 +1,18 @@
+#ifndef THRESHOLD_CONFIG_H
+#define THRESHOLD_CONFIG_H
+
+#include <stdint.h>
+
+// 閾值設定
+struct ThresholdConfig {
+    uint8_t cpuWarn;
+    uint8_t cpuCrit;
+    uint8_t ramWarn;
+    uint8_t ramCrit;
+    uint8_t gpuWarn;
+    uint8_t gpuCrit;
+    uint8_t tempWarn;
+    uint8_t tempCrit;
+};
+
+#endif
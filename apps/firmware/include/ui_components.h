@@ -1,8 +1,12 @@
 #ifndef UI_COMPONENTS_H
 #define UI_COMPONENTS_H
 
-#include <Arduino.h>
-#include "tft_driver.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "damage_region.h"
+#include "metric_history.h"
+#include "tft_core.h"
 
 // 根據數值取得顏色（綠→黃→紅）
 inline uint16_t getValueColor(int value, int warnThreshold = 70, int critThreshold = 90) {
@@ -18,9 +22,10 @@ inline uint16_t getTempColor(int temp, int warnThreshold = 60, int critThreshold
     return COLOR_CYAN;
 }
 
+template <typename Tft>
 class UIComponents {
 public:
-    UIComponents(TFTDriver& tft) : _tft(tft) {}
+    UIComponents(Tft& tft) : _tft(tft) {}
 
     // 繪製水平進度條
     void drawProgressBar(int16_t x, int16_t y, int16_t w, int16_t h,
@@ -114,7 +119,103 @@ public:
     }
 
 private:
-    TFTDriver& _tft;
+    Tft& _tft;
+};
+
+// 迷你長條圖：每筆取樣一欄，最新的在最右邊，高度為量化代碼 0..maxCode() 對應 0..h。
+// 記住每一欄目前畫在面板上的高度，新增取樣時每欄只補畫新舊高度之間的差，
+// 等同整張圖左移一欄再在右邊接上新值，不必重畫整個區塊。
+template <typename Tft, uint8_t Columns>
+class Sparkline {
+public:
+    Sparkline(Tft& tft, int16_t x, int16_t y, uint8_t columnWidth, uint8_t height,
+              uint16_t color, uint16_t bg = COLOR_BLACK)
+        : _tft(tft), _x(x), _y(y), _columnWidth(columnWidth), _height(height), _color(color), _bg(bg) {}
+
+    // 面板上這一塊的內容不可信，下次 draw 整塊重畫
+    void invalidate() { _valid = false; }
+
+    DamageRect bounds() const {
+        return damageRect(_x, _y, (int16_t)Columns * _columnWidth, _height);
+    }
+
+    template <typename History>
+    void draw(const History& history) {
+        uint8_t target[Columns];
+        const uint8_t count = history.size() < Columns ? history.size() : Columns;
+        const uint8_t skip = history.size() - count;
+        for (uint8_t c = 0; c < Columns; c++) {
+            target[c] = 0;
+            if (c >= Columns - count) {
+                target[c] = barHeight(history.at(skip + c - (Columns - count)), history.maxCode());
+            }
+        }
+
+        if (!_valid) {
+            drawAll(target);
+            return;
+        }
+
+        _tft.startWrite();
+        for (uint8_t c = 0; c < Columns; c++) {
+            const uint8_t from = _shown[c];
+            const uint8_t to = target[c];
+            if (from == to) continue;
+
+            const int16_t cx = _x + (int16_t)c * _columnWidth;
+            if (to > from) {
+                _tft.fillRect(cx, _y + _height - to, _columnWidth, to - from, _color);
+            } else {
+                _tft.fillRect(cx, _y + _height - from, _columnWidth, from - to, _bg);
+            }
+            _shown[c] = to;
+        }
+        _tft.endWrite();
+    }
+
+private:
+    Tft& _tft;
+    int16_t _x;
+    int16_t _y;
+    uint8_t _columnWidth;
+    uint8_t _height;
+    uint16_t _color;
+    uint16_t _bg;
+    bool _valid = false;
+    uint8_t _shown[Columns] = {};
+
+    uint8_t barHeight(uint8_t code, uint8_t fullScale) const {
+        if (code > fullScale) code = fullScale;
+        return (uint8_t)(((uint16_t)code * _height + fullScale / 2) / fullScale);
+    }
+
+    // 整塊以單一視窗逐列送出
+    void drawAll(const uint8_t* heights) {
+        const int16_t w = (int16_t)Columns * _columnWidth;
+        if (_x < 0 || _y < 0 || _x + w > TFT_WIDTH || _y + _height > TFT_HEIGHT) return;
+
+        uint16_t* row = _tft.lineBuffer();
+        const uint16_t fg = tftPanelOrder(_color);
+        const uint16_t bg = tftPanelOrder(_bg);
+
+        _tft.startWrite();
+        _tft.openWindow(_x, _y, w, _height);
+        for (uint8_t r = 0; r < _height; r++) {
+            const uint8_t level = _height - r;  // 這一列以下（含）的長條高度門檻
+            uint16_t* out = row;
+            for (uint8_t c = 0; c < Columns; c++) {
+                const uint16_t px = heights[c] >= level ? fg : bg;
+                for (uint8_t k = 0; k < _columnWidth; k++) {
+                    *out++ = px;
+                }
+            }
+            _tft.writePixels(row, w);
+        }
+        _tft.endWrite();
+
+        memcpy(_shown, heights, Columns);
+        _valid = true;
+    }
 };
 
 #endif
@@ -5,18 +5,42 @@
 #include <string.h>
 
 #include "connection_policy.h"
+#include "device_visibility.h"
+#include "hostname_index.h"
+#include "metric_history.h"
+#include "metrics_delta.h"
 #include "metrics_v2.h"
 #include "monitor_config.h"
 
 struct DeviceSlot {
     char hostname[32];
+    uint32_t hostHash;  // hostnameHash(hostname)，查設定時不必重算
     bool inUse;
     bool online;
     unsigned long lastUpdateMs;
     MetricsFrameV2 frame;
     uint16_t dirtyMask;
+    // 每收到一筆 frame 記一筆 8-bit 量化取樣，給設備頁的歷史圖與狀態 API 用
+    DeviceHistory history;
+    // metrics v3 keyframe / delta 的重建狀態
+    MetricsDeltaState delta;
 };
 
+enum FrameUpdateResult : uint8_t {
+    FRAME_APPLIED = 0,
+    FRAME_STORE_FULL,
+    FRAME_AWAIT_KEYFRAME  // delta 對不上手上的 keyframe，等下一個 keyframe
+};
+
+// 全部設備的歷史固定放在 DeviceStore 裡，不另外配置；調大 MAX_DEVICES、
+// DEVICE_HISTORY_SAMPLES 或 DEVICE_HISTORY_TIER_BUCKETS 超過預算時在編譯期就擋下
+#ifndef DEVICE_HISTORY_BUDGET_BYTES
+#define DEVICE_HISTORY_BUDGET_BYTES 18432
+#endif
+
+static_assert(sizeof(DeviceHistory) * MAX_DEVICES <= DEVICE_HISTORY_BUDGET_BYTES,
+              "device history exceeds DEVICE_HISTORY_BUDGET_BYTES; lower the history sizes");
+
 class DeviceStore {
 public:
     DeviceSlot devices[MAX_DEVICES];
@@ -24,6 +48,9 @@ public:
 
     void begin() {
         deviceCount = 0;
+        _index.clear();
+        _visibility.clear();
+        _enabledSynced = false;
         for (uint8_t i = 0; i < MAX_DEVICES; i++) {
             devices[i].hostname[0] = '\0';
             devices[i].inUse = false;
@@ -34,15 +61,12 @@ public:
     }
 
     DeviceSlot* getByHostname(const char* hostname) {
-        if (!hostname) {
-            return nullptr;
-        }
-        for (uint8_t i = 0; i < MAX_DEVICES; i++) {
-            if (devices[i].inUse && strcmp(devices[i].hostname, hostname) == 0) {
-                return &devices[i];
-            }
-        }
-        return nullptr;
+        return getByHostname(hostKey(hostname));
+    }
+
+    DeviceSlot* getByHostname(const HostKey& key) {
+        const int16_t i = _index.find(key, [this](uint8_t item) { return devices[item].hostname; });
+        return i < 0 ? nullptr : &devices[i];
     }
 
     DeviceSlot* getByIndex(uint8_t index) {
@@ -53,72 +77,61 @@ public:
     }
 
     bool updateFrame(const char* hostname, const MetricsFrameV2& frame, unsigned long nowMs) {
-        DeviceSlot* slot = getByHostname(hostname);
+        return updateFrame(hostKey(hostname), frame, nowMs);
+    }
+
+    // 完整 frame（v2 JSON 或一般 v3 frame），會結束該設備的 delta 序列
+    bool updateFrame(const HostKey& key, const MetricsFrameV2& frame, unsigned long nowMs) {
+        DeviceSlot* slot = findOrAllocate(key);
         if (!slot) {
-            slot = allocateSlot(hostname);
-            if (!slot) {
-                return false;
-            }
-            slot->frame = frame;
-            slot->online = true;
-            slot->lastUpdateMs = nowMs;
-            slot->dirtyMask = DIRTY_ALL;
-            return true;
+            return false;
         }
+        slot->delta.reset();
+        applyFrame(*slot, frame, METRICS_V3_ALL_FIELDS, nowMs);
+        return true;
+    }
 
-        uint16_t dirty = DIRTY_NONE;
-        if (memcmp(&slot->frame, &frame, sizeof(MetricsFrameV2)) != 0) {
-            if (slot->frame.cpuPctX10 != frame.cpuPctX10 ||
-                slot->frame.cpuTempCX10 != frame.cpuTempCX10) {
-                dirty |= DIRTY_CPU;
-            }
-            if (slot->frame.ramPctX10 != frame.ramPctX10 ||
-                slot->frame.ramUsedMB != frame.ramUsedMB ||
-                slot->frame.ramTotalMB != frame.ramTotalMB) {
-                dirty |= DIRTY_RAM;
-            }
-            if (slot->frame.gpuPctX10 != frame.gpuPctX10 ||
-                slot->frame.gpuTempCX10 != frame.gpuTempCX10 ||
-                slot->frame.gpuMemPctX10 != frame.gpuMemPctX10 ||
-                slot->frame.gpuHotspotCX10 != frame.gpuHotspotCX10 ||
-                slot->frame.gpuMemTempCX10 != frame.gpuMemTempCX10) {
-                dirty |= DIRTY_GPU;
-            }
-            if (slot->frame.netRxKbps != frame.netRxKbps ||
-                slot->frame.netTxKbps != frame.netTxKbps) {
-                dirty |= DIRTY_NET;
-            }
-            if (slot->frame.diskReadKBps != frame.diskReadKBps ||
-                slot->frame.diskWriteKBps != frame.diskWriteKBps) {
-                dirty |= DIRTY_DISK;
-            }
-
-            slot->frame = frame;
+    // metrics v3 frame：keyframe / delta 先重建成完整 frame，dirty 只比對 delta 可能動到的欄位。
+    // 不認識的設備送來 delta 不配置槽位，等 keyframe
+    FrameUpdateResult updateFrameV3(const HostKey& key, const MetricsFrameV2& decoded, const MetricsV3Info& info,
+                                    unsigned long nowMs) {
+        DeviceSlot* slot = info.flags == METRICS_V3_FLAG_DELTA ? getByHostname(key) : findOrAllocate(key);
+        if (!slot) {
+            return info.flags == METRICS_V3_FLAG_DELTA ? FRAME_AWAIT_KEYFRAME : FRAME_STORE_FULL;
         }
 
-        if (!slot->online) {
-            slot->online = true;
-            dirty |= DIRTY_ONLINE;
+        MetricsFrameV2 frame;
+        uint16_t candidates = 0;
+        const uint16_t gapsBefore = slot->delta.gapCount;
+        const MetricsDeltaResult result = applyMetricsV3Frame(slot->delta, info, decoded, frame, candidates);
+        _seqGaps += (uint16_t)(slot->delta.gapCount - gapsBefore);
+        if (result != DELTA_APPLIED) {
+            return FRAME_AWAIT_KEYFRAME;
         }
-
-        slot->lastUpdateMs = nowMs;
-        slot->dirtyMask |= dirty;
-        return true;
+        applyFrame(*slot, frame, candidates, nowMs);
+        return FRAME_APPLIED;
     }
 
+    // 只走訪線上的槽位
     void markOfflineExpired(unsigned long nowMs, unsigned long timeoutMs) {
-        for (uint8_t i = 0; i < MAX_DEVICES; i++) {
-            DeviceSlot& slot = devices[i];
-            if (!slot.inUse || !slot.online) {
-                continue;
-            }
+        for (Visibility::Mask online = _visibility.onlineMask(); online; online &= online - 1) {
+            DeviceSlot& slot = devices[Visibility::lowestSlot(online)];
             if (hasElapsedIntervalMs(nowMs, slot.lastUpdateMs, timeoutMs)) {
-                slot.online = false;
+                setOnline(slot, false);
+                // sender 可能已重啟，回來時要先收到 keyframe
+                slot.delta.reset();
                 slot.dirtyMask |= DIRTY_ONLINE;
             }
         }
     }
 
+    // 上次取走後所有設備累積的 seq 缺號次數（掉了的 frame），取走後歸零
+    uint16_t takeSeqGaps() {
+        const uint16_t gaps = _seqGaps;
+        _seqGaps = 0;
+        return gaps;
+    }
+
     uint16_t consumeDirtyMask(DeviceSlot* slot) {
         if (!slot) {
             return DIRTY_NONE;
@@ -128,40 +141,81 @@ public:
         return mask;
     }
 
+    // 線上且啟用的設備數；設定沒有變動時為 O(1)
     uint8_t getOnlineCount(MonitorConfigManager* configMgr = nullptr) {
-        uint8_t count = 0;
-        for (uint8_t i = 0; i < MAX_DEVICES; i++) {
-            if (!devices[i].inUse || !devices[i].online) {
-                continue;
-            }
-            if (!isDeviceEnabled(configMgr, devices[i].hostname)) {
-                continue;
-            }
-            count++;
-        }
-        return count;
+        syncEnabled(configMgr);
+        return _visibility.count();
     }
 
+    // 依槽位順序的第 index 台線上且啟用的設備
     DeviceSlot* getOnlineByIndex(uint8_t index, MonitorConfigManager* configMgr = nullptr) {
-        uint8_t cursor = 0;
+        syncEnabled(configMgr);
+        const int16_t slot = _visibility.at(index);
+        return slot < 0 ? nullptr : &devices[slot];
+    }
+
+private:
+    static void recordHistory(DeviceSlot& slot, const MetricsFrameV2& frame, unsigned long nowMs) {
+        slot.history.record(frame, (uint32_t)nowMs);
+    }
+
+    // candidates 以外的欄位呼叫端保證沒變，不必比對；新槽位本來就是 DIRTY_ALL
+    void applyFrame(DeviceSlot& slot, const MetricsFrameV2& frame, uint16_t candidates, unsigned long nowMs) {
+        recordHistory(slot, frame, nowMs);
+
+        uint16_t dirty = metricsDirtyMaskForFields(metricsChangedFields(slot.frame, frame, candidates));
+        slot.frame = frame;
+
+        if (!slot.online) {
+            setOnline(slot, true);
+            dirty |= DIRTY_ONLINE;
+        }
+
+        slot.lastUpdateMs = nowMs;
+        slot.dirtyMask |= dirty;
+    }
+
+    DeviceSlot* findOrAllocate(const HostKey& key) {
+        DeviceSlot* slot = getByHostname(key);
+        return slot ? slot : allocateSlot(key);
+    }
+
+    typedef DeviceVisibility<MAX_DEVICES> Visibility;
+
+    HostnameIndex<MAX_DEVICES> _index;
+    uint16_t _seqGaps = 0;
+    Visibility _visibility;
+    // 上次同步 enabled 位元時的設定來源與版本
+    const MonitorConfigManager* _enabledSource = nullptr;
+    uint16_t _enabledRevision = 0;
+    bool _enabledSynced = false;
+
+    void setOnline(DeviceSlot& slot, bool online) {
+        slot.online = online;
+        _visibility.setOnline((uint8_t)(&slot - devices), online);
+    }
+
+    // 設定來源或版本改變（或有新槽位）才重算 enabled 位元
+    void syncEnabled(MonitorConfigManager* configMgr) {
+        const uint16_t revision = configMgr ? configMgr->deviceRevision() : 0;
+        if (_enabledSynced && configMgr == _enabledSource && revision == _enabledRevision) {
+            return;
+        }
+
+        Visibility::Mask enabled = 0;
         for (uint8_t i = 0; i < MAX_DEVICES; i++) {
-            if (!devices[i].inUse || !devices[i].online) {
-                continue;
-            }
-            if (!isDeviceEnabled(configMgr, devices[i].hostname)) {
-                continue;
+            if (devices[i].inUse && isDeviceEnabled(configMgr, devices[i])) {
+                enabled |= Visibility::bit(i);
             }
-            if (cursor == index) {
-                return &devices[i];
-            }
-            cursor++;
         }
-        return nullptr;
+        _visibility.setEnabledMask(enabled);
+        _enabledSource = configMgr;
+        _enabledRevision = revision;
+        _enabledSynced = true;
     }
 
-private:
-    DeviceSlot* allocateSlot(const char* hostname) {
-        if (!hostname || hostname[0] == '\0') {
+    DeviceSlot* allocateSlot(const HostKey& key) {
+        if (!key.name || key.name[0] == '\0') {
             return nullptr;
         }
 
@@ -172,8 +226,13 @@ private:
                 slot.online = false;
                 slot.lastUpdateMs = 0;
                 slot.dirtyMask = DIRTY_ALL;
-                strlcpy(slot.hostname, hostname, sizeof(slot.hostname));
+                strlcpy(slot.hostname, key.name, sizeof(slot.hostname));
+                slot.hostHash = hostnameHash(slot.hostname);
                 slot.frame = MetricsFrameV2{};
+                slot.history.clear();
+                slot.delta = MetricsDeltaState{};
+                _index.insert(slot.hostHash, i);
+                _enabledSynced = false;
                 deviceCount++;
                 return &slot;
             }
@@ -181,17 +240,13 @@ private:
         return nullptr;
     }
 
-    bool isDeviceEnabled(MonitorConfigManager* configMgr, const char* hostname) {
-        if (!configMgr || !hostname) {
+    bool isDeviceEnabled(MonitorConfigManager* configMgr, const DeviceSlot& slot) {
+        if (!configMgr) {
             return true;
         }
 
-        for (uint8_t i = 0; i < configMgr->config.deviceCount; i++) {
-            if (strcmp(configMgr->config.devices[i].hostname, hostname) == 0) {
-                return configMgr->config.devices[i].enabled;
-            }
-        }
-        return true;
+        const DeviceConfig* cfg = configMgr->findDevice(HostKey{slot.hostname, slot.hostHash});
+        return cfg ? cfg->enabled : true;
     }
 };
 
@@ -54,6 +54,7 @@ const char HTML_MONITOR[] PROGMEM = R"rawliteral(
       <div class="tab active" onclick="showTab(event,'mqtt')">MQTT</div>
       <div class="tab" onclick="showTab(event,'topics')">Topics</div>
       <div class="tab" onclick="showTab(event,'display')">Display</div>
+      <div class="tab" onclick="showTab(event,'history')">History</div>
     </div>
 
     <div id="tab-mqtt" class="tab-content active">
@@ -104,6 +105,18 @@ const char HTML_MONITOR[] PROGMEM = R"rawliteral(
       </div>
     </div>
 
+    <div id="tab-history" class="tab-content">
+      <div class="card">
+        <h2>CPU / GPU Load</h2>
+        <div class="row">
+          <div class="form-group"><label>Host</label><select id="histHost" onchange="loadHistory()"></select></div>
+          <div class="form-group"><label>Range</label><select id="histTier" onchange="drawHistory()"><option value="0">1 min (1 s)</option><option value="1">10 min (10 s)</option><option value="2">1 hour (1 min)</option></select></div>
+        </div>
+        <canvas id="histChart" width="680" height="200" style="width:100%;background:#0f172a;border-radius:8px"></canvas>
+        <p class="hint">Band = min..max per bucket, line = mean. <span style="color:#34d399">CPU</span> / <span style="color:#e879f9">GPU</span></p>
+      </div>
+    </div>
+
     <button onclick="saveConfig()">Save Settings</button>
     <button class="secondary" onclick="loadConfig()">Reload</button>
     <div id="status" class="status"></div>
@@ -113,12 +126,14 @@ const char HTML_MONITOR[] PROGMEM = R"rawliteral(
     let D = [];
     let topicRows = [];
     let SI = 0;
+    let H = null;
 
     function showTab(evt, name) {
       document.querySelectorAll('.tab').forEach(t => t.classList.remove('active'));
       document.querySelectorAll('.tab-content').forEach(t => t.classList.remove('active'));
       evt.currentTarget.classList.add('active');
       document.getElementById('tab-' + name).classList.add('active');
+      if (name === 'history') loadHistory();
     }
 
     function topicFromHost(hostname) {
@@ -303,10 +318,59 @@ const char HTML_MONITOR[] PROGMEM = R"rawliteral(
       doSave(JSON.stringify(buildSavePayload()), 0);
     }
 
+    // /api/v2/history 二進位格式見 docs/protocol/history-export.md
+    function loadHistory() {
+      const host = document.getElementById('histHost').value;
+      if (!host) return;
+      fetch('/api/v2/history?host=' + encodeURIComponent(host))
+        .then(r => { if (!r.ok) throw new Error('HTTP ' + r.status); return r.arrayBuffer(); })
+        .then(b => { H = new Uint8Array(b); drawHistory(); })
+        .catch(() => { H = null; drawHistory(); });
+    }
+
+    function drawHistory() {
+      const c = document.getElementById('histChart');
+      const g = c.getContext('2d');
+      g.clearRect(0, 0, c.width, c.height);
+      if (!H || H[0] !== 77 || H[1] !== 72 || H[2] !== 1) return;
+      const channels = H[3], tiers = H[4], n = H[5], scale = H[6];
+      const tier = Math.min(+document.getElementById('histTier').value, tiers - 1);
+      const y = code => c.height - code * scale / 1000 * c.height;
+      const w = c.width / n;
+      ['52,211,153', '232,121,249'].forEach((rgb, ch) => {
+        if (ch >= channels) return;
+        const base = 8 + tiers * 8 + (tier * channels + ch) * n * 3;
+        g.fillStyle = 'rgba(' + rgb + ',.25)';
+        g.strokeStyle = 'rgb(' + rgb + ')';
+        g.beginPath();
+        let pen = false;
+        for (let i = 0; i < n; i++) {
+          const lo = H[base + i * 3], hi = H[base + i * 3 + 1], mean = H[base + i * 3 + 2];
+          if (lo > hi) { pen = false; continue; }
+          g.fillRect(i * w, y(hi), w, Math.max(1, y(lo) - y(hi)));
+          pen ? g.lineTo(i * w + w / 2, y(mean)) : g.moveTo(i * w + w / 2, y(mean));
+          pen = true;
+        }
+        g.stroke();
+      });
+    }
+
+    function updateHosts(devices) {
+      const sel = document.getElementById('histHost');
+      const hosts = (devices || []).map(d => d.hostname);
+      if (hosts.join() === Array.from(sel.options).map(o => o.value).join()) return;
+      const keep = sel.value;
+      sel.innerHTML = '';
+      hosts.forEach(h => sel.add(new Option(h, h)));
+      if (hosts.includes(keep)) sel.value = keep;
+    }
+
     function updateStatus() {
       fetch('/api/v2/status')
         .then(r => r.json())
         .then(d => {
+          updateHosts(d.devices);
+          if (document.getElementById('tab-history').classList.contains('active')) loadHistory();
           const m = document.getElementById('mqttStatus');
           if (!m) return;
           if (d.mqttConnected) {
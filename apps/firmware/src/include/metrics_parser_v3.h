@@ -0,0 +1,29 @@
+#ifndef METRICS_PARSER_V3_H
+#define METRICS_PARSER_V3_H
+
+#include <Arduino.h>
+
+#include "connection_policy.h"
+#include "metrics_v3.h"
+
+// sys/agents/<host>/metrics/v3 的二進位 payload，格式見 metrics_v3.h；
+// keyframe / delta 的序號放在 info，交給 DeviceStore::updateFrameV3 重建
+inline bool parseMetricsV3Payload(const char* topic,
+                                  const uint8_t* payload,
+                                  size_t length,
+                                  char* hostname,
+                                  size_t hostnameSize,
+                                  MetricsFrameV2& frame,
+                                  MetricsV3Info& info) {
+    if (!payload || !hostname || hostnameSize == 0) {
+        return false;
+    }
+
+    if (!extractHostnameFromSenderTopic(topic, hostname, hostnameSize)) {
+        return false;
+    }
+
+    return decodeMetricsV3(payload, length, frame, &info);
+}
+
+#endif
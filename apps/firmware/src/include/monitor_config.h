@@ -5,8 +5,13 @@
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 
+#include "hostname_index.h"
+#include "threshold_config.h"
+
 #define MONITOR_CONFIG_FILE "/monitor_v2.json"
+#ifndef MAX_DEVICES
 #define MAX_DEVICES 8
+#endif
 #define MAX_FIELDS 10
 #define MAX_SUBSCRIBED_TOPICS 8
 #define DEFAULT_OFFLINE_TIMEOUT_SEC 20
@@ -35,18 +40,6 @@ struct DeviceConfig {
     bool enabled;           // 是否啟用
 };
 
-// 閾值設定
-struct ThresholdConfig {
-    uint8_t cpuWarn;
-    uint8_t cpuCrit;
-    uint8_t ramWarn;
-    uint8_t ramCrit;
-    uint8_t gpuWarn;
-    uint8_t gpuCrit;
-    uint8_t tempWarn;
-    uint8_t tempCrit;
-};
-
 // 版面欄位配置
 struct FieldConfig {
     FieldType type;
@@ -104,6 +97,8 @@ public:
 private:
     bool _needsSave = false;
     unsigned long _lastSaveTime = 0;
+    HostnameIndex<MAX_DEVICES> _deviceIndex;
+    uint16_t _deviceRevision = 0;
 
 public:
 
@@ -111,6 +106,20 @@ public:
         _needsSave = true;
     }
 
+    // 設備清單或任一設備的 enabled 改變時遞增；DeviceStore 據此判斷是否要重算可見設備
+    uint16_t deviceRevision() const {
+        return _deviceRevision;
+    }
+
+    void setDeviceEnabled(DeviceConfig& device, bool enabled) {
+        if (device.enabled == enabled) {
+            return;
+        }
+        device.enabled = enabled;
+        _deviceRevision++;
+        markDirty();
+    }
+
     void setDefaults() {
         // MQTT 預設
         strcpy(config.mqttServer, "");
@@ -122,6 +131,7 @@ public:
 
         // 設備預設
         config.deviceCount = 0;
+        reindexDevices();
 
         // 預設版面
         config.fieldCount = 5;
@@ -194,6 +204,7 @@ public:
             d.enabled = dev["enabled"] | true;
             config.deviceCount++;
         }
+        reindexDevices();
 
         // 閾值
         JsonObject th = doc["thresholds"];
@@ -275,18 +286,40 @@ public:
         return true;
     }
 
+    // config.devices 被整批改寫（載入、網頁儲存）後必須呼叫，重建 hostname 索引
+    void reindexDevices() {
+        _deviceRevision++;
+        _deviceIndex.clear();
+        for (uint8_t i = 0; i < config.deviceCount; i++) {
+            const HostKey key = hostKey(config.devices[i].hostname);
+            // 重複的 hostname 以第一筆為準，與逐一比對時相同
+            if (!findDevice(key)) {
+                _deviceIndex.insert(key.hash, i);
+            }
+        }
+    }
+
+    DeviceConfig* findDevice(const HostKey& key) {
+        const int16_t i = _deviceIndex.find(key, [this](uint8_t item) { return config.devices[item].hostname; });
+        return i < 0 ? nullptr : &config.devices[i];
+    }
+
     // 取得或建立設備設定（自動新增新設備）
     DeviceConfig* getOrCreateDevice(const char* hostname) {
+        return getOrCreateDevice(hostKey(hostname));
+    }
+
+    DeviceConfig* getOrCreateDevice(const HostKey& key) {
         // 先找現有的
-        for (uint8_t i = 0; i < config.deviceCount; i++) {
-            if (strcmp(config.devices[i].hostname, hostname) == 0) {
-                return &config.devices[i];
-            }
+        DeviceConfig* existing = findDevice(key);
+        if (existing) {
+            return existing;
         }
 
         // 新增設備
         if (config.deviceCount < MAX_DEVICES) {
             DeviceConfig& d = config.devices[config.deviceCount];
+            const char* hostname = key.name;
             strlcpy(d.hostname, hostname, sizeof(d.hostname));
 
             // 預設別名：使用完整 hostname，顯示時由 ESP12 自行截斷
@@ -294,6 +327,8 @@ public:
 
             d.displayTime = config.defaultDisplayTime;
             d.enabled = false;
+            _deviceIndex.insert(key.hash, config.deviceCount);
+            _deviceRevision++;
             config.deviceCount++;
             _needsSave = true;  // 標記需要儲存，稍後在主迴圈中儲存
 
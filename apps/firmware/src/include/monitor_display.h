@@ -7,9 +7,9 @@
 #include "connection_policy.h"
 #include "device_store.h"
 #include "monitor_config.h"
+#include "monitor_screens.h"
 #include "mqtt_transport.h"
 #include "tft_driver.h"
-#include "ui_components.h"
 
 class MonitorDisplay {
 public:
@@ -17,7 +17,7 @@ public:
                    DeviceStore& store,
                    MQTTTransport& mqtt,
                    MonitorConfigManager& config)
-        : _tft(tft), _ui(tft), _store(store), _mqtt(mqtt), _config(config) {}
+        : _screens(tft), _store(store), _mqtt(mqtt), _config(config) {}
 
     void begin() {
         _currentDevice = 0;
@@ -27,6 +27,14 @@ public:
         _pendingVisibleUpdate = true;
         _forceRedraw = true;
         _lastHostname[0] = '\0';
+        _screens.invalidate();
+    }
+
+    // 面板內容不可信（例如 SPI 降速後），下一輪整個重畫
+    void forceRedraw() {
+        _screens.invalidate();
+        _forceRedraw = true;
+        _pendingVisibleUpdate = true;
     }
 
     void notifyMetricsUpdated(const char* hostname) {
@@ -54,8 +62,7 @@ public:
     }
 
 private:
-    TFTDriver& _tft;
-    UIComponents _ui;
+    MonitorScreens<TFTDriver> _screens;
     DeviceStore& _store;
     MQTTTransport& _mqtt;
     MonitorConfigManager& _config;
@@ -77,7 +84,7 @@ private:
         DeviceSlot* slot = _store.getOnlineByIndex(_currentDevice, &_config);
         uint16_t displayTime = _config.config.defaultDisplayTime;
         if (slot) {
-            DeviceConfig* devCfg = _config.getOrCreateDevice(slot->hostname);
+            DeviceConfig* devCfg = _config.getOrCreateDevice(HostKey{slot->hostname, slot->hostHash});
             if (devCfg) {
                 displayTime = devCfg->displayTime;
             }
@@ -144,138 +151,21 @@ private:
             dirty);
         if (headerRedraw) {
             dirty = DIRTY_ALL;
-            _tft.fillScreen(COLOR_BLACK);
-            _ui.drawDeviceHeader(alias, true);
-
-            if (onlineCount > 1) {
-                char indicator[16];
-                snprintf(indicator, sizeof(indicator), "%d/%d", _currentDevice + 1, onlineCount);
-                _tft.drawString(200, 8, indicator, COLOR_GRAY, 0x1082, 1);
-            }
-
+            _screens.drawDeviceFrame(alias, _currentDevice, onlineCount);
             strlcpy(_lastHostname, slot->hostname, sizeof(_lastHostname));
             _forceRedraw = false;
         }
 
-        const MetricsFrameV2& frame = slot->frame;
-        ThresholdConfig& th = _config.config.thresholds;
-
-        if (dirty & DIRTY_CPU) {
-            drawCpuRow(frame, th);
-        }
-        if (dirty & DIRTY_RAM) {
-            drawRamRow(frame, th);
-        }
-        if (dirty & DIRTY_GPU) {
-            drawGpuRows(frame, th);
-        }
-        if (dirty & DIRTY_NET) {
-            drawNetRow(frame);
-        }
-        if (dirty & DIRTY_DISK) {
-            drawDiskRow(frame);
-        }
+        _screens.drawDeviceRows(slot->frame, _config.config.thresholds, dirty);
 
         if (headerRedraw || dirty != DIRTY_NONE || now - _lastFooterUpdate >= 1000UL) {
-            drawFooter(frame, now, slot->lastUpdateMs);
+            String ip = WiFi.localIP().toString();
+            _screens.drawFooter(ip.c_str(), _mqtt.isConnectedForDisplay(), (now - slot->lastUpdateMs) / 1000UL);
             _lastFooterUpdate = now;
         }
-    }
-
-    void drawCpuRow(const MetricsFrameV2& frame, ThresholdConfig& th) {
-        int y = 36;
-        char buf[20];
-        int cpuPct = roundedPercent(frame.cpuPctX10);
-        int cpuTemp = roundedTempC(frame.cpuTempCX10);
-
-        _tft.drawString(8, y, "CPU", COLOR_WHITE, COLOR_BLACK, 2);
-        snprintf(buf, sizeof(buf), "%3d%%", cpuPct);
-        uint16_t cpuColor = (cpuPct >= th.cpuCrit) ? COLOR_RED : (cpuPct >= th.cpuWarn) ? COLOR_YELLOW : COLOR_GREEN;
-        _tft.drawStringPadded(64, y, buf, cpuColor, COLOR_BLACK, 2, 80);
 
-        snprintf(buf, sizeof(buf), "%2dC", cpuTemp);
-        uint16_t tempColor = (cpuTemp >= th.tempCrit) ? COLOR_RED : (cpuTemp >= th.tempWarn) ? COLOR_YELLOW : COLOR_CYAN;
-        _tft.drawStringPadded(152, y, buf, tempColor, COLOR_BLACK, 2, 80);
-    }
-
-    void drawRamRow(const MetricsFrameV2& frame, ThresholdConfig& th) {
-        int y = 72;
-        char buf[24];
-        int ramPct = roundedPercent(frame.ramPctX10);
-
-        _tft.drawString(8, y, "RAM", COLOR_WHITE, COLOR_BLACK, 2);
-        snprintf(buf, sizeof(buf), "%3d%%", ramPct);
-        uint16_t ramColor = (ramPct >= th.ramCrit) ? COLOR_RED : (ramPct >= th.ramWarn) ? COLOR_YELLOW : COLOR_GREEN;
-        _tft.drawStringPadded(64, y, buf, ramColor, COLOR_BLACK, 2, 70);
-
-        snprintf(buf, sizeof(buf), "%u/%uM", frame.ramUsedMB, frame.ramTotalMB);
-        _tft.drawStringPadded(136, y, buf, COLOR_GRAY, COLOR_BLACK, 1, 100);
-    }
-
-    void drawGpuRows(const MetricsFrameV2& frame, ThresholdConfig& th) {
-        int y = 108;
-        char buf[24];
-
-        _tft.drawString(8, y, "GPU", COLOR_WHITE, COLOR_BLACK, 2);
-
-        int gpuPct = roundedPercent(frame.gpuPctX10);
-        snprintf(buf, sizeof(buf), "%3d%%", gpuPct);
-        uint16_t gpuColor = (gpuPct >= th.gpuCrit) ? COLOR_RED : (gpuPct >= th.gpuWarn) ? COLOR_YELLOW : COLOR_GREEN;
-        _tft.drawStringPadded(64, y, buf, gpuColor, COLOR_BLACK, 2, 80);
-
-        int gpuTemp = roundedTempC(frame.gpuTempCX10);
-        snprintf(buf, sizeof(buf), "%2dC", gpuTemp);
-        uint16_t tempColor = (gpuTemp >= th.tempCrit) ? COLOR_RED : (gpuTemp >= th.tempWarn) ? COLOR_YELLOW : COLOR_CYAN;
-        _tft.drawStringPadded(152, y, buf, tempColor, COLOR_BLACK, 2, 80);
-
-        y += 32;
-        int hspTemp = roundedTempC(frame.gpuHotspotCX10);
-        int memTemp = roundedTempC(frame.gpuMemTempCX10);
-        snprintf(buf, sizeof(buf), "HSP:%dC", hspTemp);
-        _tft.drawStringPadded(8, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 72);
-        snprintf(buf, sizeof(buf), "MEM:%dC", memTemp);
-        _tft.drawStringPadded(88, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 72);
-
-        y += 16;
-        snprintf(buf, sizeof(buf), "VRAM: %d%%", roundedPercent(frame.gpuMemPctX10));
-        _tft.drawStringPadded(8, y, buf, COLOR_GRAY, COLOR_BLACK, 1, 120);
-    }
-
-    void drawNetRow(const MetricsFrameV2& frame) {
-        int y = 172;
-        char buf[20];
-        _tft.drawString(8, y, "NET", COLOR_GRAY, COLOR_BLACK, 1);
-        snprintf(buf, sizeof(buf), "v%.1fM", kbpsToMbps(frame.netRxKbps));
-        _tft.drawStringPadded(40, y, buf, COLOR_GREEN, COLOR_BLACK, 1, 70);
-        snprintf(buf, sizeof(buf), "^%.1fM", kbpsToMbps(frame.netTxKbps));
-        _tft.drawStringPadded(112, y, buf, COLOR_CYAN, COLOR_BLACK, 1, 70);
-    }
-
-    void drawDiskRow(const MetricsFrameV2& frame) {
-        int y = 188;
-        char buf[20];
-        _tft.drawString(8, y, "DISK", COLOR_GRAY, COLOR_BLACK, 1);
-        snprintf(buf, sizeof(buf), "R:%.1fM", kbpsToMBps(frame.diskReadKBps));
-        _tft.drawStringPadded(48, y, buf, COLOR_WHITE, COLOR_BLACK, 1, 78);
-        snprintf(buf, sizeof(buf), "W:%.1fM", kbpsToMBps(frame.diskWriteKBps));
-        _tft.drawStringPadded(128, y, buf, COLOR_WHITE, COLOR_BLACK, 1, 78);
-    }
-
-    void drawFooter(const MetricsFrameV2&, unsigned long now, unsigned long lastUpdateMs) {
-        char buf[20];
-
-        String ip = WiFi.localIP().toString();
-        _tft.drawStringCentered(204, ip.c_str(), COLOR_YELLOW, COLOR_BLACK, 1);
-
-        if (_mqtt.isConnectedForDisplay()) {
-            _tft.drawString(8, 222, "MQTT OK", COLOR_GREEN, COLOR_BLACK, 1);
-        } else {
-            _tft.drawString(8, 222, "MQTT --", COLOR_RED, COLOR_BLACK, 1);
-        }
-
-        unsigned long ageSec = (now - lastUpdateMs) / 1000UL;
-        snprintf(buf, sizeof(buf), "%lus ago", ageSec);
-        _tft.drawStringPadded(168, 222, buf, COLOR_GRAY, COLOR_BLACK, 1, 70);
+        _screens.present();
+        _screens.drawHistory(slot->history.cpuPct, slot->history.gpuPct);
     }
 
     void showNoDevice() {
@@ -286,17 +176,9 @@ private:
         _forceRedraw = false;
         _lastHostname[0] = '\0';
 
-        _tft.fillScreen(COLOR_BLACK);
-        _ui.drawDeviceHeader("Monitor", true);
-        _tft.drawStringCentered(100, "Waiting", COLOR_CYAN, COLOR_BLACK, 2);
-        _tft.drawStringCentered(130, "for metrics v2", COLOR_GRAY, COLOR_BLACK, 1);
-
-        if (!_mqtt.isConnectedForDisplay()) {
-            _tft.drawStringCentered(160, "MQTT not connected", COLOR_RED, COLOR_BLACK, 1);
-        }
-
         String ip = WiFi.localIP().toString();
-        _tft.drawStringCentered(204, ip.c_str(), COLOR_YELLOW, COLOR_BLACK, 1);
+        _screens.drawNoDevice(ip.c_str(), _mqtt.isConnectedForDisplay());
+        _screens.present();
     }
 
     void showOfflineDevice(const char* hostname) {
@@ -308,21 +190,11 @@ private:
         DeviceConfig* cfg = _config.getOrCreateDevice(hostname);
         const char* alias = (cfg && strlen(cfg->alias) > 0) ? cfg->alias : hostname;
 
-        _tft.fillScreen(COLOR_BLACK);
         strlcpy(_lastHostname, hostname, sizeof(_lastHostname));
         _forceRedraw = false;
 
-        _ui.drawDeviceHeader(alias, false);
-        _tft.drawStringCentered(96, "OFFLINE", COLOR_RED, COLOR_BLACK, 2);
-        _tft.drawStringCentered(128, "No updates", COLOR_GRAY, COLOR_BLACK, 1);
-
-        if (_mqtt.isConnectedForDisplay()) {
-            _tft.drawString(8, 222, "MQTT OK", COLOR_GREEN, COLOR_BLACK, 1);
-        } else {
-            _tft.drawString(8, 222, "MQTT --", COLOR_RED, COLOR_BLACK, 1);
-        }
-
-        _tft.drawStringPadded(168, 222, "OFFLINE", COLOR_RED, COLOR_BLACK, 1, 70);
+        _screens.drawOfflineDevice(alias, _mqtt.isConnectedForDisplay());
+        _screens.present();
     }
 };
 
@@ -7,7 +7,9 @@
 
 #include "connection_policy.h"
 #include "device_store.h"
+#include "metrics_batch.h"
 #include "metrics_parser_v2.h"
+#include "metrics_parser_v3.h"
 #include "monitor_config.h"
 
 class MQTTTransport;
@@ -77,8 +79,22 @@ public:
             return false;
         }
 
+        // allowlist 存的是 v2 topic，同一台的 v3 topic 也放行
         for (uint8_t i = 0; i < _configMgr->config.subscribedTopicCount; i++) {
-            if (strcmp(_configMgr->config.subscribedTopics[i], topic) == 0) {
+            if (isSameSenderMetricsHost(_configMgr->config.subscribedTopics[i], topic)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isHostInAllowlist(const char* hostname) const {
+        if (!_configMgr || !hostname) {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < _configMgr->config.subscribedTopicCount; i++) {
+            if (isSenderTopicForHost(_configMgr->config.subscribedTopics[i], hostname)) {
                 return true;
             }
         }
@@ -99,6 +115,11 @@ public:
             return;
         }
 
+        if (isValidBatchMetricsTopic(topic)) {
+            handleBatch(topic, payload, length);
+            return;
+        }
+
         bool allowlistMode = hasTopicAllowlist();
         if (allowlistMode && !isTopicInAllowlist(topic)) {
             return;
@@ -109,57 +130,19 @@ public:
 
         char hostname[32];
         MetricsFrameV2 frame;
-        if (!parseMetricsV2Payload(topic, payload, length, hostname, sizeof(hostname), frame)) {
-            Serial.printf("Drop invalid metrics v2 payload on topic: %s\n", topic ? topic : "<null>");
+        MetricsV3Info v3;
+        const uint8_t version = senderMetricsTopicVersion(topic);
+        const bool parsed = version == METRICS_SCHEMA_V3
+                                ? parseMetricsV3Payload(topic, payload, length, hostname, sizeof(hostname), frame, v3)
+                                : parseMetricsV2Payload(topic, payload, length, hostname, sizeof(hostname), frame);
+        if (!parsed) {
+            Serial.printf("Drop invalid metrics v%u payload on topic: %s\n", version, topic ? topic : "<null>");
             return;
         }
 
-        bool isKnown = false;
-        bool enabled = false;
-        getDeviceConfigState(hostname, isKnown, enabled);
-
-        if (_configMgr && isKnown && !enabled &&
-            shouldAutoEnableDeviceOnSubscribedTopic(_configMgr->config.subscribedTopicCount) &&
-            isTopicInAllowlist(topic)) {
-            DeviceConfig* cfg = _configMgr->getOrCreateDevice(hostname);
-            if (cfg && !cfg->enabled) {
-                cfg->enabled = true;
-                _configMgr->markDirty();
-                enabled = true;
-            }
-        }
-
-        if (isKnown && !enabled) {
-            return;
-        }
-
-        DeviceConfig* cfg = _configMgr->getOrCreateDevice(hostname);
-        if (cfg && !cfg->enabled &&
-            (!allowlistMode || shouldAutoEnableDeviceOnSubscribedTopic(_configMgr->config.subscribedTopicCount))) {
-            cfg->enabled = true;
-            _configMgr->markDirty();
-        }
-
-        unsigned long now = millis();
-        if (!_store->updateFrame(hostname, frame, now)) {
-            Serial.println("Drop metrics: device store is full");
-            return;
-        }
-
-        _lastMessageAt = now;
-        _rxMessageCount++;
-
-        if (now - _lastRxLogAt >= MQTT_RX_LOG_INTERVAL_MS) {
-            Serial.printf("MQTT rx v2: %u msgs / %ums, last=%s\n",
-                          _rxMessageCount,
-                          (unsigned int)MQTT_RX_LOG_INTERVAL_MS,
-                          hostname);
-            _rxMessageCount = 0;
-            _lastRxLogAt = now;
-        }
-
-        if (onMetricsReceived) {
-            onMetricsReceived(hostname);
+        const unsigned long now = millis();
+        if (applyHostFrame(hostKey(hostname), frame, version == METRICS_SCHEMA_V3 ? &v3 : nullptr, now)) {
+            noteReceived(hostname, now);
         }
     }
 
@@ -172,6 +155,7 @@ private:
     uint8_t _reconnectFailureCount = 0;
     unsigned long _lastRxLogAt = 0;
     uint16_t _rxMessageCount = 0;
+    uint16_t _awaitKeyframeDrops = 0;  // 等 keyframe 而丟掉的 delta，隨 rx 統計一起輸出
     unsigned long _lastConnectedAt = 0;
     unsigned long _lastMessageAt = 0;
     bool connected = false;
@@ -191,25 +175,90 @@ private:
         return (unsigned long)sec * 1000UL;
     }
 
-    static void mqttCallback(char* topic, uint8_t* payload, unsigned int length) {
-        if (_mqttTransportInstance) {
-            _mqttTransportInstance->handleMessage(topic, payload, length);
+    // 一則 batch 在同一個 callback 裡逐台寫入 DeviceStore；allowlist 模式下只收名單內的設備
+    void handleBatch(const char* topic, const uint8_t* payload, unsigned int length) {
+        const bool allowlistMode = hasTopicAllowlist();
+        const unsigned long now = millis();
+        const int16_t count = forEachMetricsBatchEntry(payload, length, [&](const MetricsBatchEntry& entry) {
+            if (allowlistMode && !isHostInAllowlist(entry.hostname)) {
+                return;
+            }
+            if (applyHostFrame(entry.key, entry.frame, &entry.info, now)) {
+                noteReceived(entry.hostname, now);
+            }
+        });
+        if (count < 0) {
+            Serial.printf("Drop invalid metrics batch on topic: %s\n", topic);
         }
     }
 
-    void getDeviceConfigState(const char* hostname, bool& isKnown, bool& enabled) {
-        isKnown = false;
-        enabled = false;
-        if (!_configMgr) {
+    // 設定檢查與 DeviceStore 更新，單台 topic 與 batch 共用；v3 為 nullptr 時是 v2 frame。
+    // 走到這裡時 allowlist 模式的設備一定在名單內
+    bool applyHostFrame(const HostKey& key, const MetricsFrameV2& frame, const MetricsV3Info* v3, unsigned long now) {
+        // hash 只算一次，設定與設備各查一次索引
+        DeviceConfig* cfg = _configMgr->findDevice(key);
+        const bool isKnown = cfg != nullptr;
+        const bool allowlistMode = hasTopicAllowlist();
+
+        if (isKnown && !cfg->enabled && shouldAutoEnableDeviceOnSubscribedTopic(_configMgr->config.subscribedTopicCount)) {
+            _configMgr->setDeviceEnabled(*cfg, true);
+        }
+
+        if (isKnown && !cfg->enabled) {
+            return false;
+        }
+
+        if (!cfg) {
+            cfg = _configMgr->getOrCreateDevice(key);
+        }
+        if (cfg && !cfg->enabled &&
+            (!allowlistMode || shouldAutoEnableDeviceOnSubscribedTopic(_configMgr->config.subscribedTopicCount))) {
+            _configMgr->setDeviceEnabled(*cfg, true);
+        }
+
+        const FrameUpdateResult result = v3 ? _store->updateFrameV3(key, frame, *v3, now)
+                                            : (_store->updateFrame(key, frame, now) ? FRAME_APPLIED : FRAME_STORE_FULL);
+        if (result == FRAME_STORE_FULL) {
+            Serial.println("Drop metrics: device store is full");
+            return false;
+        }
+        if (result == FRAME_AWAIT_KEYFRAME) {
+            // 重開機或離線後每台會連續丟掉最多 interval - 1 個 delta，只計數不逐筆輸出
+            _awaitKeyframeDrops++;
+            logRxStats(key.name, now);
+            return false;
+        }
+        return true;
+    }
+
+    void noteReceived(const char* hostname, unsigned long now) {
+        _lastMessageAt = now;
+        _rxMessageCount++;
+        logRxStats(hostname, now);
+
+        if (onMetricsReceived) {
+            onMetricsReceived(hostname);
+        }
+    }
+
+    void logRxStats(const char* hostname, unsigned long now) {
+        if (now - _lastRxLogAt < MQTT_RX_LOG_INTERVAL_MS) {
             return;
         }
+        Serial.printf("MQTT rx: %u frames / %ums, last=%s, %u deltas awaiting keyframe, %u seq gaps\n",
+                      _rxMessageCount,
+                      (unsigned int)MQTT_RX_LOG_INTERVAL_MS,
+                      hostname,
+                      _awaitKeyframeDrops,
+                      _store->takeSeqGaps());
+        _rxMessageCount = 0;
+        _awaitKeyframeDrops = 0;
+        _lastRxLogAt = now;
+    }
 
-        for (uint8_t i = 0; i < _configMgr->config.deviceCount; i++) {
-            if (strcmp(_configMgr->config.devices[i].hostname, hostname) == 0) {
-                isKnown = true;
-                enabled = _configMgr->config.devices[i].enabled;
-                return;
-            }
+    static void mqttCallback(char* topic, uint8_t* payload, unsigned int length) {
+        if (_mqttTransportInstance) {
+            _mqttTransportInstance->handleMessage(topic, payload, length);
         }
     }
 
@@ -230,7 +279,7 @@ private:
 
             bool duplicate = false;
             for (uint8_t j = 0; j < uniqueCount; j++) {
-                if (strcmp(uniqueTopics[j], topic) == 0) {
+                if (isSameSenderMetricsHost(uniqueTopics[j], topic)) {
                     duplicate = true;
                     break;
                 }
@@ -255,23 +304,34 @@ private:
                 discoveryTopic = MQTT_SENDER_DISCOVERY_TOPIC;
             }
 
-            if (_client.subscribe(discoveryTopic)) {
-                Serial.printf("Subscribed discovery topic: %s\n", discoveryTopic);
-            } else {
-                Serial.printf("Subscribe failed (discovery): %s\n", discoveryTopic);
-            }
+            subscribeTopic(discoveryTopic, "discovery");
+            subscribeTopic(MQTT_SENDER_DISCOVERY_TOPIC_V3, "discovery");
+            subscribeTopic(MQTT_BATCH_DISCOVERY_TOPIC, "batch");
             return;
         }
 
+        // batch 可能帶名單內的設備，逐台比對 allowlist
+        subscribeTopic(MQTT_BATCH_DISCOVERY_TOPIC, "batch");
+
+        // 每台 sender 同時訂閱 v2 與 v3，sender 改用二進位格式時不需改設定
+        char topicBuf[64];
         for (uint8_t i = 0; i < uniqueCount; i++) {
-            if (_client.subscribe(uniqueTopics[i])) {
-                Serial.printf("Subscribed sender topic: %s\n", uniqueTopics[i]);
-            } else {
-                Serial.printf("Subscribe failed: %s\n", uniqueTopics[i]);
+            for (uint8_t version = METRICS_SCHEMA_V2; version <= METRICS_SCHEMA_V3; version++) {
+                if (senderMetricsTopicForVersion(uniqueTopics[i], version, topicBuf, sizeof(topicBuf))) {
+                    subscribeTopic(topicBuf, "sender");
+                }
             }
         }
     }
 
+    void subscribeTopic(const char* topic, const char* kind) {
+        if (_client.subscribe(topic)) {
+            Serial.printf("Subscribed %s topic: %s\n", kind, topic);
+        } else {
+            Serial.printf("Subscribe failed (%s): %s\n", kind, topic);
+        }
+    }
+
     void reconnect() {
         if (!_configMgr) {
             return;
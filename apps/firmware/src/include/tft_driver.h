@@ -3,7 +3,10 @@
 
 #include <Arduino.h>
 #include <SPI.h>
-#include "font_8x16.h"
+
+#include "fast_pin.h"
+#include "spi_clock_policy.h"
+#include "tft_core.h"
 
 // 腳位定義
 #define TFT_MOSI 13
@@ -13,21 +16,68 @@
 #define TFT_RST  4
 #define TFT_BL   5
 
-#define TFT_WIDTH  240
-#define TFT_HEIGHT 240
-
-// 顏色定義 (RGB565)
-#define COLOR_BLACK   0x0000
-#define COLOR_WHITE   0xFFFF
-#define COLOR_RED     0xF800
-#define COLOR_GREEN   0x07E0
-#define COLOR_BLUE    0x001F
-#define COLOR_YELLOW  0xFFE0
-#define COLOR_CYAN    0x07FF
-#define COLOR_MAGENTA 0xF81F
-#define COLOR_GRAY    0x8410
-
-class TFTDriver {
+// ST7789 讀取指令
+static const uint8_t TFT_CMD_RDDID = 0x04;
+static const uint8_t TFT_CMD_RAMRD = 0x2E;
+
+// 校正用測試圖樣長度（像素），執行中健康檢查只用前面一小段
+static const uint8_t TFT_CLOCK_PATTERN_PIXELS = 64;
+static const uint8_t TFT_CLOCK_HEALTH_PIXELS = 16;
+
+typedef FastPin<TFT_CS> TFTPinCS;
+typedef FastPin<TFT_DC> TFTPinDC;
+typedef FastPin<TFT_SCLK> TFTPinSCLK;
+typedef FastPin<TFT_MOSI> TFTPinMOSI;
+
+// ESP8266 硬體 SPI：重複顏色用 writePattern、像素緩衝用 writeBytes，
+// 由 SPI FIFO 一次推送 64 bytes，不再逐 byte 呼叫 SPI.transfer()。
+// CS 由 startWrite/endWrite 控制，整批指令與像素之間不放開；
+// DC 平時保持 HIGH（資料），只有送指令那一個 byte 拉低。
+struct TFTSpiBus {
+    uint8_t csDepth = 0;
+
+    void startWrite() {
+        if (csDepth++ == 0) {
+            TFTPinCS::low();
+        }
+    }
+
+    void endWrite() {
+        if (--csDepth == 0) {
+            TFTPinCS::high();
+        }
+    }
+
+    void writeCommand(uint8_t cmd) {
+        TFTPinDC::low();
+        SPI.transfer(cmd);
+        TFTPinDC::high();
+    }
+
+    // data 與 pixels 需 4-byte 對齊（SPI FIFO 以 32-bit 讀取）
+    void writeData(const uint8_t* data, uint16_t len) {
+        SPI.writeBytes(data, len);
+    }
+
+    void writeColor(uint16_t color, uint32_t count) {
+        if (count == 0) return;
+
+        uint8_t pattern[2] = {(uint8_t)(color >> 8), (uint8_t)(color & 0xFF)};
+        SPI.writePattern(pattern, sizeof(pattern), count);
+    }
+
+    void writePixels(const uint16_t* pixels, uint32_t count) {
+        if (count == 0) return;
+
+        SPI.writeBytes(reinterpret_cast<const uint8_t*>(pixels), count * 2);
+    }
+
+    void yieldCpu() {
+        yield();
+    }
+};
+
+class TFTDriver : public TFTCore<TFTSpiBus> {
 public:
     void begin() {
         pinMode(TFT_CS, OUTPUT);
@@ -35,18 +85,65 @@ public:
         pinMode(TFT_RST, OUTPUT);
         pinMode(TFT_BL, OUTPUT);
 
-        digitalWrite(TFT_CS, HIGH);
+        TFTPinCS::high();
+        TFTPinDC::high();
         digitalWrite(TFT_BL, LOW);  // 背光 ON
 
-        SPI.begin();
-        SPI.setFrequency(10000000);
-        SPI.setDataMode(SPI_MODE0);
-        SPI.setBitOrder(MSBFIRST);
+        _spiClock = {TFT_SPI_SAFE_HZ, SPI_CLOCK_DEFAULT, 0};
+        beginSpi();
 
         init();
+        calibrateClock();
+    }
+
+    // 以保守時脈開機後，由快到慢找出寫入/讀回都正確的最高時脈
+    void calibrateClock() {
+        _spiClock = calibrateSpiClock(*this);
+        applySpiClock();
+        Serial.printf("TFT SPI clock: %lu Hz (%s, %u fallbacks)\n",
+                      (unsigned long)_spiClock.hz, spiClockStatusToString(_spiClock.status), _spiClock.fallbacks);
+    }
+
+    // 執行中重新驗證目前時脈，失敗就降一階；回傳 true 表示已降速，畫面需整個重畫
+    bool checkClock() {
+        if (_spiClock.status != SPI_CLOCK_VERIFIED && _spiClock.status != SPI_CLOCK_DEGRADED) {
+            return false;
+        }
+
+        // 先以慢速讀出左上角原本的內容，驗證完再寫回
+        alignas(4) uint16_t saved[TFT_CLOCK_HEALTH_PIXELS];
+        readPixels(0, 0, saved, TFT_CLOCK_HEALTH_PIXELS);
+
+        bool ok = verifyPattern(_spiClock.hz, TFT_CLOCK_HEALTH_PIXELS);
+        if (!ok) {
+            applySpiClockFault(_spiClock);
+            applySpiClock();
+            Serial.printf("TFT SPI corruption detected, clock -> %lu Hz\n", (unsigned long)_spiClock.hz);
+        }
+
+        for (uint8_t i = 0; i < TFT_CLOCK_HEALTH_PIXELS; i++) {
+            saved[i] = tftPanelOrder(saved[i]);
+        }
+        pushPixels(0, 0, TFT_CLOCK_HEALTH_PIXELS, 1, saved);
+        return !ok;
+    }
+
+    const SpiClockState& spiClock() const {
+        return _spiClock;
+    }
+
+    // calibrateSpiClock 的 Probe 介面
+    bool canReadBack() {
+        uint32_t id = readId();
+        return id != 0 && id != 0xFFFFFFUL;
+    }
+
+    bool verifyClock(uint32_t hz) {
+        return verifyPattern(hz, TFT_CLOCK_PATTERN_PIXELS);
     }
 
     void init() {
+        invalidateAddrWindow();
         digitalWrite(TFT_RST, LOW);
         delay(50);
         digitalWrite(TFT_RST, HIGH);
@@ -67,128 +164,137 @@ public:
         delay(50);
     }
 
-    void fillScreen(uint16_t color) {
-        setAddrWindow(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
-        digitalWrite(TFT_DC, HIGH);
-        digitalWrite(TFT_CS, LOW);
-
-        uint8_t hi = color >> 8;
-        uint8_t lo = color & 0xFF;
-        for (uint32_t i = 0; i < (uint32_t)TFT_WIDTH * TFT_HEIGHT; i++) {
-            SPI.transfer(hi);
-            SPI.transfer(lo);
-        }
-        digitalWrite(TFT_CS, HIGH);
-    }
-
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-        if (x >= TFT_WIDTH || y >= TFT_HEIGHT || w <= 0 || h <= 0) return;
-        if (x < 0) { w += x; x = 0; }
-        if (y < 0) { h += y; y = 0; }
-        if (x + w > TFT_WIDTH) w = TFT_WIDTH - x;
-        if (y + h > TFT_HEIGHT) h = TFT_HEIGHT - y;
-
-        setAddrWindow(x, y, x + w - 1, y + h - 1);
-        digitalWrite(TFT_DC, HIGH);
-        digitalWrite(TFT_CS, LOW);
-
-        uint8_t hi = color >> 8;
-        uint8_t lo = color & 0xFF;
-        uint32_t total = (uint32_t)w * h;
-        for (uint32_t i = 0; i < total; i++) {
-            SPI.transfer(hi);
-            SPI.transfer(lo);
-        }
-        digitalWrite(TFT_CS, HIGH);
-        if (total > 512) yield();  // 大面積填充後讓出 CPU
+    void setBacklight(bool on) {
+        digitalWrite(TFT_BL, on ? LOW : HIGH);  // LOW = ON
     }
 
-    void drawPixel(int16_t x, int16_t y, uint16_t color) {
-        if (x < 0 || x >= TFT_WIDTH || y < 0 || y >= TFT_HEIGHT) return;
+private:
+    SpiClockState _spiClock = {TFT_SPI_SAFE_HZ, SPI_CLOCK_DEFAULT, 0};
+
+    void beginSpi() {
+        SPI.begin();
+        SPI.setFrequency(_spiClock.hz);
+        SPI.setDataMode(SPI_MODE0);
+        SPI.setBitOrder(MSBFIRST);
+    }
 
-        setAddrWindow(x, y, x, y);
-        digitalWrite(TFT_DC, HIGH);
-        digitalWrite(TFT_CS, LOW);
-        SPI.transfer(color >> 8);
-        SPI.transfer(color & 0xFF);
-        digitalWrite(TFT_CS, HIGH);
+    void applySpiClock() {
+        SPI.setFrequency(_spiClock.hz);
     }
 
-    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1) {
-        if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) return;
+    // 以 hz 寫入一段測試圖樣（含 CASET/RASET），再以慢速讀回比對
+    bool verifyPattern(uint32_t hz, uint8_t count) {
+        alignas(4) uint16_t pattern[TFT_CLOCK_PATTERN_PIXELS];
+        alignas(4) uint16_t readback[TFT_CLOCK_PATTERN_PIXELS];
 
-        uint16_t index = (c - FONT_FIRST_CHAR) * FONT_HEIGHT;
+        // 交錯 0/1 與漸變值，讓每條資料線都會高頻切換
+        uint16_t seed = 0xACE1;
+        for (uint8_t i = 0; i < count; i++) {
+            seed = (uint16_t)(seed * 25173U + 13849U);
+            pattern[i] = (i & 1) ? (uint16_t)(0xAAAA ^ seed) : (uint16_t)(0x5555 ^ (seed >> 3));
+        }
 
-        for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
-            uint8_t line = pgm_read_byte(&font_8x16[index + row]);
-            for (uint8_t col = 0; col < FONT_WIDTH; col++) {
-                uint16_t px_color = (line & (0x80 >> col)) ? color : bg;
-                if (size == 1) {
-                    drawPixel(x + col, y + row, px_color);
-                } else {
-                    fillRect(x + col * size, y + row * size, size, size, px_color);
-                }
+        SPI.setFrequency(hz);
+        for (uint8_t i = 0; i < count; i++) {
+            readback[i] = tftPanelOrder(pattern[i]);
+        }
+        pushPixelsUncached(0, 0, count, 1, readback);
+        applySpiClock();
+        invalidateAddrWindow();  // 高速下的 CASET/RASET 可能已經送錯
+
+        readPixels(0, 0, readback, count);
+        for (uint8_t i = 0; i < count; i++) {
+            if (readback[i] != pattern[i]) {
+                return false;
             }
         }
+        return true;
+    }
+
+    // 板子沒有接 MISO：讀取時把 SDA(MOSI) 暫時改成 GPIO 輸入，以 bit-bang 慢速讀
+    void beginBitBang() {
+        SPI.end();
+        pinMode(TFT_SCLK, OUTPUT);
+        TFTPinSCLK::low();
+        pinMode(TFT_MOSI, OUTPUT);
+        TFTPinCS::low();
+    }
+
+    void endBitBang() {
+        TFTPinCS::high();
+        beginSpi();
     }
 
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1) {
-        while (*str) {
-            drawChar(x, y, *str, color, bg, size);
-            x += FONT_WIDTH * size;
-            str++;
-            yield();  // 讓 WiFi/TCP stack 處理封包
+    void bitBangWrite(uint8_t value) {
+        pinMode(TFT_MOSI, OUTPUT);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            TFTPinMOSI::write(value & 0x80);
+            value <<= 1;
+            delayMicroseconds(1);
+            TFTPinSCLK::high();
+            delayMicroseconds(1);
+            TFTPinSCLK::low();
         }
     }
 
-    // 繪製固定寬度字串：先畫文字（含背景），再清除尾部剩餘像素，無閃爍
-    void drawStringPadded(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size, int16_t totalWidth) {
-        int16_t strWidth = strlen(str) * FONT_WIDTH * size;
-        drawString(x, y, str, color, bg, size);
-        if (strWidth < totalWidth) {
-            fillRect(x + strWidth, y, totalWidth - strWidth, FONT_HEIGHT * size, bg);
+    // 面板在 SCLK 下降緣送出資料，上升緣取樣
+    uint32_t bitBangRead(uint8_t bits) {
+        pinMode(TFT_MOSI, INPUT);
+        uint32_t value = 0;
+        for (uint8_t bit = 0; bit < bits; bit++) {
+            TFTPinSCLK::high();
+            delayMicroseconds(1);
+            value = (value << 1) | (digitalRead(TFT_MOSI) ? 1U : 0U);
+            TFTPinSCLK::low();
+            delayMicroseconds(1);
         }
+        return value;
     }
 
-    void drawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1) {
-        int16_t len = strlen(str);
-        int16_t x = (TFT_WIDTH - len * FONT_WIDTH * size) / 2;
-        drawString(x, y, str, color, bg, size);
+    void bitBangCommand(uint8_t cmd) {
+        TFTPinDC::low();
+        bitBangWrite(cmd);
+        TFTPinDC::high();
     }
 
-    void setBacklight(bool on) {
-        digitalWrite(TFT_BL, on ? LOW : HIGH);  // LOW = ON
+    uint32_t readId() {
+        beginBitBang();
+        bitBangCommand(TFT_CMD_RDDID);
+        bitBangRead(1);  // dummy clock
+        uint32_t id = bitBangRead(24);
+        endBitBang();
+        return id;
+    }
+
+    // RAMRD 以 RGB666（每色一 byte，高位對齊）回傳，轉回 RGB565 比對
+    void readPixels(uint16_t x, uint16_t y, uint16_t* out, uint8_t count) {
+        _bus.startWrite();
+        setAddrWindow(x, y, x + count - 1, y);
+        _bus.endWrite();
+
+        beginBitBang();
+        bitBangCommand(TFT_CMD_RAMRD);
+        bitBangRead(8);  // dummy byte
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t r = (uint8_t)bitBangRead(8);
+            uint8_t g = (uint8_t)bitBangRead(8);
+            uint8_t b = (uint8_t)bitBangRead(8);
+            out[i] = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+        }
+        endBitBang();
     }
 
-private:
     void writeCommand(uint8_t cmd) {
-        digitalWrite(TFT_DC, LOW);
-        digitalWrite(TFT_CS, LOW);
-        SPI.transfer(cmd);
-        digitalWrite(TFT_CS, HIGH);
+        _bus.startWrite();
+        _bus.writeCommand(cmd);
+        _bus.endWrite();
     }
 
     void writeData(uint8_t data) {
-        digitalWrite(TFT_DC, HIGH);
-        digitalWrite(TFT_CS, LOW);
-        SPI.transfer(data);
-        digitalWrite(TFT_CS, HIGH);
-    }
-
-    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-        writeCommand(0x2A);
-        writeData(x0 >> 8);
-        writeData(x0 & 0xFF);
-        writeData(x1 >> 8);
-        writeData(x1 & 0xFF);
-
-        writeCommand(0x2B);
-        writeData(y0 >> 8);
-        writeData(y0 & 0xFF);
-        writeData(y1 >> 8);
-        writeData(y1 & 0xFF);
-
-        writeCommand(0x2C);
+        alignas(4) uint8_t buf[1] = {data};
+        _bus.startWrite();
+        _bus.writeData(buf, 1);
+        _bus.endWrite();
     }
 };
 
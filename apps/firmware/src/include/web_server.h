@@ -7,10 +7,12 @@
 
 #include "connection_policy.h"
 #include "device_store.h"
+#include "history_export.h"
 #include "html_monitor.h"
 #include "html_page.h"
 #include "monitor_config.h"
 #include "mqtt_transport.h"
+#include "tft_driver.h"
 #include "wifi_manager.h"
 
 class WebServerManager {
@@ -29,6 +31,10 @@ public:
         _store = store;
     }
 
+    void setDisplay(const TFTDriver* tft) {
+        _tft = tft;
+    }
+
     void loop() {
         processPendingWifiApply();
 
@@ -107,6 +113,9 @@ public:
         _server.on("/api/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
             sendStatus(request);
         });
+        _server.on("/api/v2/history", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            sendHistory(request);
+        });
 
         _server.begin();
         Serial.println("Web Server started");
@@ -127,6 +136,7 @@ private:
     MonitorConfigManager* _monitorConfig = nullptr;
     MQTTTransport* _mqtt = nullptr;
     DeviceStore* _store = nullptr;
+    const TFTDriver* _tft = nullptr;
     volatile bool _pendingRestart = false;
     unsigned long _restartAt = 0;
     WifiApplyState _wifiApplyState = WIFI_APPLY_IDLE;
@@ -368,6 +378,7 @@ private:
                 d.enabled = dev["enabled"] | true;
                 cfg.deviceCount++;
             }
+            _monitorConfig->reindexDevices();
         }
 
         if (data["thresholds"].is<JsonObject>()) {
@@ -405,6 +416,14 @@ private:
         doc["onlineCount"] = (_store && _monitorConfig) ? _store->getOnlineCount(_monitorConfig) : 0;
         doc["wifiApplyState"] = wifiApplyStateToString();
 
+        if (_tft) {
+            const SpiClockState& spiClock = _tft->spiClock();
+            doc["spiClockHz"] = spiClock.hz;
+            doc["spiClockStatus"] = spiClockStatusToString(spiClock.status);
+            doc["spiClockFallbacks"] = spiClock.fallbacks;
+            doc["addrCommandsElided"] = _tft->addrCommandsElided();
+        }
+
         if (_store) {
             JsonArray devices = doc["devices"].to<JsonArray>();
             for (uint8_t i = 0; i < MAX_DEVICES; i++) {
@@ -418,6 +437,13 @@ private:
                 dev["online"] = slot->online;
                 dev["cpu"] = roundedPercent(slot->frame.cpuPctX10);
                 dev["ram"] = roundedPercent(slot->frame.ramPctX10);
+
+                // 最近 history 窗內的 CPU 使用率，O(1) 取得
+                const PercentSeries& cpu = slot->history.cpuPct;
+                dev["cpuMin"] = roundedPercent((int16_t)cpu.min());
+                dev["cpuMax"] = roundedPercent((int16_t)cpu.max());
+                dev["cpuAvg"] = roundedPercent((int16_t)cpu.mean());
+                dev["historySamples"] = cpu.size();
             }
         }
 
@@ -426,6 +452,34 @@ private:
         request->send(200, "application/json", json);
     }
 
+    // 單一設備的分層 CPU/GPU 歷史，直接從 DeviceStore 分段讀出，不建 JsonDocument 也不組 String
+    void sendHistory(AsyncWebServerRequest* request) {
+        if (!_store) {
+            request->send(503, "application/json", "{\"success\":false,\"message\":\"store unavailable\"}");
+            return;
+        }
+        if (!request->hasParam("host")) {
+            request->send(400, "application/json", "{\"success\":false,\"message\":\"host required\"}");
+            return;
+        }
+
+        const DeviceSlot* slot = _store->getByHostname(request->getParam("host")->value().c_str());
+        if (!slot) {
+            request->send(404, "application/json", "{\"success\":false,\"message\":\"unknown host\"}");
+            return;
+        }
+
+        // slot 在 begin() 之後不會被釋放，回應送完前持有指標是安全的；
+        // 分段之間若收到新 frame，長度不變、只是後段的桶較新
+        const uint32_t nowMs = millis();
+        AsyncWebServerResponse* response = request->beginResponse(
+            "application/octet-stream", HISTORY_EXPORT_BYTES,
+            [slot, nowMs](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+                return historyExportRead(slot->history, nowMs, index, buf, maxLen);
+            });
+        request->send(response);
+    }
+
     void processPendingWifiApply() {
         if (!isWifiApplyBusy()) {
             return;
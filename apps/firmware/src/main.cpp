@@ -4,13 +4,14 @@
 #include "include/monitor_config.h"
 #include "include/monitor_display.h"
 #include "include/mqtt_transport.h"
-#include "include/qr_display.h"
 #include "include/tft_driver.h"
 #include "include/web_server.h"
 #include "include/wifi_manager.h"
+#include "qr_display.h"
+#include "setup_screens.h"
 
 TFTDriver tft;
-QRDisplay qr(tft);
+QRDisplay<TFTDriver> qr(tft);
 WiFiManager wifiMgr;
 WebServerManager* webServer = nullptr;
 MonitorConfigManager monitorConfig;
@@ -49,6 +50,7 @@ uint8_t savedConnectAttempts = 0;
 uint8_t sdkConnectAttempts = 0;
 uint8_t startupRecoveryCycles = 0;
 unsigned long startupNextAt = 0;
+unsigned long lastSpiClockCheckAt = 0;
 bool hasSavedWiFiConfig = false;
 bool wifiStorageReady = false;
 
@@ -66,27 +68,12 @@ void scheduleStartupRetryCycle() {
 }
 
 void showAPScreen() {
-    tft.fillScreen(COLOR_BLACK);
-
-    tft.drawStringCentered(10, "WiFi Setup", COLOR_CYAN, COLOR_BLACK, 2);
-
     String apSSID = wifiMgr.getAPSSID();
-    tft.drawStringCentered(45, apSSID.c_str(), COLOR_WHITE, COLOR_BLACK, 1);
-
-    qr.drawWiFiQR(apSSID.c_str(), nullptr, 10);
-
-    tft.drawStringCentered(210, wifiMgr.localIP.c_str(), COLOR_YELLOW, COLOR_BLACK, 1);
+    drawApSetupScreen(tft, qr, apSSID.c_str(), wifiMgr.localIP.c_str());
 }
 
 void showConnectedScreen() {
-    tft.fillScreen(COLOR_BLACK);
-    tft.drawStringCentered(10, "Connected", COLOR_GREEN, COLOR_BLACK, 2);
-    tft.drawStringCentered(45, wifiMgr.ssid.c_str(), COLOR_WHITE, COLOR_BLACK, 1);
-
-    String url = "http://" + wifiMgr.localIP + "/monitor";
-    qr.drawURLQR(url.c_str(), 10);
-
-    tft.drawStringCentered(210, wifiMgr.localIP.c_str(), COLOR_YELLOW, COLOR_BLACK, 1);
+    drawWifiConnectedScreen(tft, qr, wifiMgr.ssid.c_str(), wifiMgr.localIP.c_str());
 }
 
 void showConnectingScreen() {
@@ -111,6 +98,7 @@ void ensureWebServer() {
     webServer->setMonitorConfig(&monitorConfig);
     webServer->setMQTTTransport(&mqttTransport);
     webServer->setDeviceStore(&deviceStore);
+    webServer->setDisplay(&tft);
     webServer->begin();
 }
 
@@ -316,6 +304,12 @@ void loop() {
         yield();
         monitorConfig.loop();
         yield();
+        if (millis() - lastSpiClockCheckAt >= TFT_SPI_HEALTH_CHECK_MS) {
+            lastSpiClockCheckAt = millis();
+            if (tft.checkClock() && monitorDisplay) {
+                monitorDisplay->forceRedraw();
+            }
+        }
         if (monitorDisplay) {
             monitorDisplay->loop();
         }
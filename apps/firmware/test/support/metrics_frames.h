@@ -0,0 +1,40 @@
+#ifndef METRICS_FRAMES_H
+#define METRICS_FRAMES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <unity.h>
+
+#include "metrics_v3.h"
+
+// metrics v3 / delta / batch 測試共用：docs/protocol/metrics-v3.md 範例對應的 frame
+static inline MetricsFrameV2 exampleFrame() {
+    MetricsFrameV2 frame;
+    frame.senderTsMs = (uint32_t)(1739999999000ULL & 0xFFFFFFFFUL);
+    frame.cpuPctX10 = 424;
+    frame.cpuTempCX10 = 582;
+    frame.ramPctX10 = 678;
+    frame.ramUsedMB = 12288;
+    frame.ramTotalMB = 32768;
+    frame.gpuPctX10 = 150;
+    frame.gpuTempCX10 = 520;
+    frame.gpuMemPctX10 = 125;
+    frame.netRxKbps = 1024;
+    frame.netTxKbps = 512;
+    frame.diskReadKBps = 2048;
+    frame.diskWriteKBps = 1024;
+    return frame;
+}
+
+// 時間戳與 14 個 v3 欄位都相同
+static inline bool sameFields(const MetricsFrameV2& a, const MetricsFrameV2& b) {
+    return a.senderTsMs == b.senderTsMs &&
+           memcmp(metricsV3FieldBytes(a), metricsV3FieldBytes(b), METRICS_V3_FIELD_COUNT * 2) == 0;
+}
+
+static inline void assertFieldsEqual(const MetricsFrameV2& a, const MetricsFrameV2& b) {
+    TEST_ASSERT_EQUAL_UINT32(a.senderTsMs, b.senderTsMs);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(metricsV3FieldBytes(a), metricsV3FieldBytes(b), METRICS_V3_FIELD_COUNT * 2));
+}
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef VIRTUAL_PANEL_H
+#define VIRTUAL_PANEL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tft_core.h"
+
+// native 測試用的虛擬 ST7789：實作與 TFTSpiBus 相同的介面，
+// 解析 CASET/RASET/RAMWR 把像素寫進 240x240 RGB565 framebuffer，
+// 並統計 SPI 流量，可輸出 PPM/PNG 快照。
+struct VirtualPanelBus {
+    uint16_t pixels[TFT_WIDTH * TFT_HEIGHT];
+
+    // 統計
+    uint32_t transactions = 0;   // 每次 write* 呼叫（一段 SPI 傳輸）
+    uint32_t csCycles = 0;       // CS 拉低的次數（最外層 startWrite）
+    uint32_t unframedWrites = 0; // 沒有拉低 CS 就寫入（應為 0）
+    uint32_t commands = 0;       // 指令位元組
+    uint32_t spiBytes = 0;       // 指令 + 參數 + 像素位元組
+    uint32_t pixelBytes = 0;     // 其中的像素位元組
+    uint32_t windowChanges = 0;  // CASET/RASET 實際改變範圍的次數
+    uint32_t ramWrites = 0;      // RAMWR 次數
+    uint32_t overflowPixels = 0; // 寫出視窗範圍外的像素（應為 0）
+
+    uint8_t csDepth = 0;
+    uint8_t command = 0;
+    uint16_t x0 = 0, x1 = TFT_WIDTH - 1, y0 = 0, y1 = TFT_HEIGHT - 1;
+    uint16_t cursorX = 0, cursorY = 0;
+
+    void startWrite() {
+        if (csDepth++ == 0) csCycles++;
+    }
+
+    void endWrite() {
+        csDepth--;
+    }
+
+    void writeCommand(uint8_t cmd) {
+        checkFramed();
+        transactions++;
+        commands++;
+        spiBytes++;
+        command = cmd;
+        if (cmd == TFT_CMD_RAMWR) {
+            cursorX = x0;
+            cursorY = y0;
+            ramWrites++;
+        }
+    }
+
+    void writeData(const uint8_t* data, uint16_t len) {
+        checkFramed();
+        transactions++;
+        spiBytes += len;
+        if (len < 4) return;
+
+        uint16_t a = (uint16_t)(data[0] << 8 | data[1]);
+        uint16_t b = (uint16_t)(data[2] << 8 | data[3]);
+        if (command == TFT_CMD_CASET) {
+            if (a != x0 || b != x1) windowChanges++;
+            x0 = a;
+            x1 = b;
+        } else if (command == TFT_CMD_RASET) {
+            if (a != y0 || b != y1) windowChanges++;
+            y0 = a;
+            y1 = b;
+        }
+    }
+
+    void writeColor(uint16_t color, uint32_t count) {
+        checkFramed();
+        transactions++;
+        spiBytes += count * 2;
+        pixelBytes += count * 2;
+        while (count--) {
+            put(color);
+        }
+    }
+
+    void writePixels(const uint16_t* data, uint32_t count) {
+        checkFramed();
+        transactions++;
+        spiBytes += count * 2;
+        pixelBytes += count * 2;
+        while (count--) {
+            put(tftPanelOrder(*data++));
+        }
+    }
+
+    void yieldCpu() {}
+
+    void resetCounters() {
+        transactions = 0;
+        csCycles = 0;
+        unframedWrites = 0;
+        commands = 0;
+        spiBytes = 0;
+        pixelBytes = 0;
+        windowChanges = 0;
+        ramWrites = 0;
+        overflowPixels = 0;
+    }
+
+    void clear(uint16_t color) {
+        for (uint32_t i = 0; i < (uint32_t)TFT_WIDTH * TFT_HEIGHT; i++) {
+            pixels[i] = color;
+        }
+        resetCounters();
+    }
+
+    uint16_t pixelAt(uint16_t x, uint16_t y) const {
+        return pixels[(uint32_t)y * TFT_WIDTH + x];
+    }
+
+    // FNV-1a，作為 golden image 比對
+    uint32_t hash() const {
+        uint32_t h = 2166136261UL;
+        for (uint32_t i = 0; i < (uint32_t)TFT_WIDTH * TFT_HEIGHT; i++) {
+            h = (h ^ (pixels[i] & 0xFF)) * 16777619UL;
+            h = (h ^ (pixels[i] >> 8)) * 16777619UL;
+        }
+        return h;
+    }
+
+    bool writePpm(const char* path) const {
+        FILE* f = fopen(path, "wb");
+        if (!f) return false;
+
+        fprintf(f, "P6\n%d %d\n255\n", TFT_WIDTH, TFT_HEIGHT);
+        for (uint32_t i = 0; i < (uint32_t)TFT_WIDTH * TFT_HEIGHT; i++) {
+            uint8_t rgb[3];
+            toRgb888(pixels[i], rgb);
+            fwrite(rgb, 1, 3, f);
+        }
+        return fclose(f) == 0;
+    }
+
+    // 未壓縮（stored deflate）的 RGB PNG，不依賴 zlib
+    bool writePng(const char* path) const {
+        FILE* f = fopen(path, "wb");
+        if (!f) return false;
+
+        static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        fwrite(signature, 1, sizeof(signature), f);
+
+        uint8_t ihdr[13] = {0};
+        putU32(ihdr, TFT_WIDTH);
+        putU32(ihdr + 4, TFT_HEIGHT);
+        ihdr[8] = 8;  // bit depth
+        ihdr[9] = 2;  // RGB
+        writeChunk(f, "IHDR", ihdr, sizeof(ihdr));
+
+        const uint32_t rowBytes = 1 + TFT_WIDTH * 3;
+        const uint32_t rawSize = rowBytes * TFT_HEIGHT;
+        const uint32_t blocks = (rawSize + 65534) / 65535;
+        const uint32_t idatSize = 2 + rawSize + blocks * 5 + 4;
+        static uint8_t idat[2 + (1 + TFT_WIDTH * 3) * TFT_HEIGHT + 5 * 8 + 4];
+
+        uint8_t raw[1 + TFT_WIDTH * 3];
+        uint32_t pos = 0;
+        uint32_t rawPos = 0;
+        uint32_t adlerA = 1, adlerB = 0;
+
+        idat[pos++] = 0x78;
+        idat[pos++] = 0x01;
+        for (uint16_t y = 0; y < TFT_HEIGHT; y++) {
+            raw[0] = 0;  // filter: none
+            for (uint16_t x = 0; x < TFT_WIDTH; x++) {
+                toRgb888(pixelAt(x, y), raw + 1 + x * 3);
+            }
+            for (uint32_t i = 0; i < rowBytes; i++, rawPos++) {
+                if (rawPos % 65535 == 0) {
+                    uint32_t remain = rawSize - rawPos;
+                    uint16_t len = (uint16_t)(remain > 65535 ? 65535 : remain);
+                    idat[pos++] = remain <= 65535 ? 1 : 0;
+                    idat[pos++] = len & 0xFF;
+                    idat[pos++] = len >> 8;
+                    idat[pos++] = ~len & 0xFF;
+                    idat[pos++] = (~len >> 8) & 0xFF;
+                }
+                idat[pos++] = raw[i];
+                adlerA = (adlerA + raw[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+        }
+        putU32(idat + pos, (adlerB << 16) | adlerA);
+        pos += 4;
+
+        writeChunk(f, "IDAT", idat, idatSize);
+        writeChunk(f, "IEND", nullptr, 0);
+        return pos == idatSize && fclose(f) == 0;
+    }
+
+    void checkFramed() {
+        if (csDepth == 0) unframedWrites++;
+    }
+
+    void put(uint16_t color) {
+        if (cursorY > y1 || cursorY >= TFT_HEIGHT || cursorX >= TFT_WIDTH) {
+            overflowPixels++;
+            return;
+        }
+        pixels[(uint32_t)cursorY * TFT_WIDTH + cursorX] = color;
+        if (++cursorX > x1) {
+            cursorX = x0;
+            cursorY++;
+        }
+    }
+
+    static void toRgb888(uint16_t c, uint8_t* rgb) {
+        uint8_t r = (c >> 11) & 0x1F;
+        uint8_t g = (c >> 5) & 0x3F;
+        uint8_t b = c & 0x1F;
+        rgb[0] = (uint8_t)((r << 3) | (r >> 2));
+        rgb[1] = (uint8_t)((g << 2) | (g >> 4));
+        rgb[2] = (uint8_t)((b << 3) | (b >> 2));
+    }
+
+    static void putU32(uint8_t* p, uint32_t v) {
+        p[0] = (uint8_t)(v >> 24);
+        p[1] = (uint8_t)(v >> 16);
+        p[2] = (uint8_t)(v >> 8);
+        p[3] = (uint8_t)v;
+    }
+
+    static uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t len) {
+        crc = ~crc;
+        while (len--) {
+            crc ^= *data++;
+            for (uint8_t k = 0; k < 8; k++) {
+                crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+
+    static void writeChunk(FILE* f, const char* type, const uint8_t* data, uint32_t len) {
+        uint8_t header[8];
+        putU32(header, len);
+        memcpy(header + 4, type, 4);
+        fwrite(header, 1, sizeof(header), f);
+        if (len > 0) {
+            fwrite(data, 1, len, f);
+        }
+
+        uint32_t crc = crc32(0, header + 4, 4);
+        if (len > 0) {
+            crc = crc32(crc, data, len);
+        }
+        uint8_t trailer[4];
+        putU32(trailer, crc);
+        fwrite(trailer, 1, sizeof(trailer), f);
+    }
+};
+
+typedef TFTCore<VirtualPanelBus> VirtualTFT;
+
+#endif
@@ -0,0 +1,155 @@
+#include <string.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+#include "aa_font.h"
+#include "aa_font_sans14.h"
+#include "scene_compositor.h"
+
+static VirtualTFT tft;
+static VirtualTFT reference;
+
+// 手工字型：' ' 空白 3 寬；'!' 字格 4 寬，墨水 2x2 位於 (1,1)，alpha 由左上依序為 3,2,1,0
+static const uint8_t tinyBitmap[] PROGMEM = {0xE4};
+static const AAGlyph tinyGlyphs[] PROGMEM = {
+    {0, 0, 0, 0, 0, 3, 0},
+    {0, 2, 2, 1, 1, 4, 0},
+};
+static const AAFont tinyFont = {tinyBitmap, tinyGlyphs, ' ', '!', 4};
+
+void setUp() {
+    tft.bus().clear(COLOR_BLACK);
+    tft.invalidateAddrWindow();
+    reference.bus().clear(COLOR_BLACK);
+}
+
+void tearDown() {}
+
+void test_blend_endpoints_and_midpoints() {
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLUE, aaBlend565(COLOR_WHITE, COLOR_BLUE, 0));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_WHITE, aaBlend565(COLOR_WHITE, COLOR_BLUE, 3));
+    // 白疊在黑上：R/B 0..31、G 0..63 的 1/3 與 2/3
+    TEST_ASSERT_EQUAL_HEX16((10 << 11) | (21 << 5) | 10, aaBlend565(COLOR_WHITE, COLOR_BLACK, 1));
+    TEST_ASSERT_EQUAL_HEX16((20 << 11) | (42 << 5) | 20, aaBlend565(COLOR_WHITE, COLOR_BLACK, 2));
+    // 由亮到暗也不會借位到相鄰通道
+    TEST_ASSERT_EQUAL_HEX16((21 << 11) | (42 << 5) | 21, aaBlend565(COLOR_BLACK, COLOR_WHITE, 1));
+}
+
+void test_expand_row_places_ink_inside_cell() {
+    const uint16_t palette[4] = {0, 1, 2, 3};
+    uint16_t row[12];
+
+    memset(row, 0xFF, sizeof(row));
+    aaExpandTextRow(row, tinyFont, " !", 2, 1, 0, 9, palette);
+    const uint16_t row1[9] = {0, 0, 0, 0, 3, 2, 0, 0, 0};
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(row1, row, 9);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, row[9]);
+
+    aaExpandTextRow(row, tinyFont, " !", 2, 2, 0, 7, palette);
+    const uint16_t row2[7] = {0, 0, 0, 0, 1, 0, 0};
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(row2, row, 7);
+
+    // 可見欄從字格中間開始
+    aaExpandTextRow(row, tinyFont, " !", 2, 1, 5, 7, palette);
+    const uint16_t clipped[2] = {2, 0};
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(clipped, row, 2);
+}
+
+void test_unknown_chars_fall_back_to_first_glyph() {
+    TEST_ASSERT_EQUAL_INT32(3 + 4 + 3, aaTextWidth(tinyFont, "A!\x01", 3));
+    TEST_ASSERT_EQUAL_UINT8(aaFontGlyph(AA_FONT_SANS14, ' ').advance, aaFontGlyph(AA_FONT_SANS14, (char)0xB0).advance);
+    TEST_ASSERT_EQUAL_UINT8(aaFontGlyph(AA_FONT_SANS14, ' ').advance, aaFontGlyph(AA_FONT_SANS14, '\n').advance);
+}
+
+// 轉檔工具的輸出必須符合格式約定：墨水在字格內、點陣依序緊密排列
+void test_generated_font_is_well_formed() {
+    const AAFont& font = AA_FONT_SANS14;
+    uint32_t expectedOffset = 0;
+    for (uint16_t c = font.first; c <= font.last; c++) {
+        const AAGlyph g = aaFontGlyph(font, (char)c);
+        TEST_ASSERT_EQUAL_UINT16(expectedOffset, g.offset);
+        TEST_ASSERT_TRUE(g.xOffset + g.width <= g.advance);
+        TEST_ASSERT_TRUE(g.yOffset + g.height <= font.lineHeight);
+        expectedOffset += ((uint32_t)g.width * g.height * 2 + 7) / 8;
+    }
+    TEST_ASSERT_EQUAL_UINT32(sizeof(aa_font_sans14_bitmap), expectedOffset);
+    TEST_ASSERT_EQUAL_UINT8(0, aaFontGlyph(font, ' ').width);
+    TEST_ASSERT_TRUE(aaFontGlyph(font, 'M').advance > aaFontGlyph(font, 'i').advance);
+}
+
+// 同樣的數值列：14 px 比例字型的像素數不到 2 倍點陣字的一半
+void test_proportional_label_is_cheaper_than_size_two() {
+    const char* label = "CPU 42% 61C";
+    const int32_t aaPixels = aaTextWidth(AA_FONT_SANS14, label, strlen(label)) * AA_FONT_SANS14.lineHeight;
+    const int32_t bitmapPixels = (int32_t)strlen(label) * FONT_WIDTH * 2 * FONT_HEIGHT * 2;
+    TEST_ASSERT_TRUE(aaPixels * 2 < bitmapPixels);
+}
+
+void test_draw_aa_text_streams_one_window() {
+    tft.bus().resetCounters();
+    const int16_t w = tft.drawAAText(20, 30, "GPU 38%", AA_FONT_SANS14, COLOR_WHITE, COLOR_BLUE, 120);
+
+    TEST_ASSERT_EQUAL_INT16(120, w);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+    TEST_ASSERT_EQUAL_UINT32(120UL * AA_FONT_SANS14.lineHeight * 2, tft.bus().pixelBytes);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLUE, tft.bus().pixelAt(20 + 119, 30));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(20 + 120, 30));
+
+    // 字形內部有完整的前景色，也有混色的邊緣
+    bool full = false;
+    bool blended = false;
+    for (int16_t y = 30; y < 30 + AA_FONT_SANS14.lineHeight; y++) {
+        for (int16_t x = 20; x < 80; x++) {
+            uint16_t px = tft.bus().pixelAt(x, y);
+            full |= px == COLOR_WHITE;
+            blended |= px != COLOR_WHITE && px != COLOR_BLUE;
+        }
+    }
+    TEST_ASSERT_TRUE(full);
+    TEST_ASSERT_TRUE(blended);
+}
+
+void test_draw_aa_text_clips_at_screen_edges() {
+    tft.drawAAText(200, 230, "wide text", AA_FONT_SANS14, COLOR_YELLOW, COLOR_GRAY);
+    tft.drawAAText(-15, -4, "clip", AA_FONT_SANS14, COLOR_YELLOW, COLOR_GRAY);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_TRUE(tft.bus().pixelAt(239, 239) != COLOR_BLACK);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(199, 239));
+}
+
+// 場景中的反鋸齒文字與直接 drawAAText 的結果一致，換字只重畫第一個不同字元之後
+void test_scene_aa_text_matches_direct_draw_and_damages_suffix() {
+    SceneCompositor<VirtualTFT, 2> scene(tft);
+    scene.setAAText(0, 40, 100, "RX 1280K", AA_FONT_SANS14, COLOR_GREEN, COLOR_BLACK, 100);
+    scene.flush();
+
+    scene.setAAText(0, 40, 100, "RX 1310K", AA_FONT_SANS14, COLOR_GREEN, COLOR_BLACK, 100);
+    TEST_ASSERT_EQUAL_UINT8(1, scene.damage().count());
+    const int16_t from = (int16_t)aaTextWidth(AA_FONT_SANS14, "RX 1", 4);
+    TEST_ASSERT_EQUAL_INT16(40 + from, scene.damage().rect(0).x0);
+    TEST_ASSERT_EQUAL_INT16(140, scene.damage().rect(0).x1);
+    scene.flush();
+
+    reference.drawAAText(40, 100, "RX 1310K", AA_FONT_SANS14, COLOR_GREEN, COLOR_BLACK, 100);
+    TEST_ASSERT_EQUAL_HEX32(reference.bus().hash(), tft.bus().hash());
+
+    tft.bus().resetCounters();
+    scene.setAAText(0, 40, 100, "RX 1310K", AA_FONT_SANS14, COLOR_GREEN, COLOR_BLACK, 100);
+    scene.flush();
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_blend_endpoints_and_midpoints);
+    RUN_TEST(test_expand_row_places_ink_inside_cell);
+    RUN_TEST(test_unknown_chars_fall_back_to_first_glyph);
+    RUN_TEST(test_generated_font_is_well_formed);
+    RUN_TEST(test_proportional_label_is_cheaper_than_size_two);
+    RUN_TEST(test_draw_aa_text_streams_one_window);
+    RUN_TEST(test_draw_aa_text_clips_at_screen_edges);
+    RUN_TEST(test_scene_aa_text_matches_direct_draw_and_damages_suffix);
+    return UNITY_END();
+}
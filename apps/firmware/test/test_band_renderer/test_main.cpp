@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+#include "band_renderer.h"
+#include "scene_compositor.h"
+
+static VirtualTFT tft;
+
+void setUp() {
+    tft.bus().clear(COLOR_BLACK);
+    tft.invalidateAddrWindow();
+}
+
+void tearDown() {}
+
+static uint16_t patternAt(int16_t x, int16_t y) {
+    return (uint16_t)((x * 31 + y * 977) ^ (y << 5));
+}
+
+static void composePattern(uint16_t* dst, int16_t x0, int16_t x1, int16_t y) {
+    for (int16_t x = x0; x < x1; x++) {
+        *dst++ = tftPanelOrder(patternAt(x, y));
+    }
+}
+
+static void assertPattern(const DamageRect& rect) {
+    for (int16_t y = 0; y < TFT_HEIGHT; y++) {
+        for (int16_t x = 0; x < TFT_WIDTH; x++) {
+            bool inside = x >= rect.x0 && x < rect.x1 && y >= rect.y0 && y < rect.y1;
+            uint16_t expected = inside ? patternAt(x, y) : COLOR_BLACK;
+            if (tft.bus().pixelAt(x, y) != expected) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "pixel mismatch at %d,%d", x, y);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+// 整頁：一個視窗，ceil(240 / StripHeight) 次 burst
+template <uint8_t StripHeight>
+static void checkFullScreen() {
+    tft.bus().clear(COLOR_BLACK);
+    tft.invalidateAddrWindow();
+    static BandRenderer<VirtualTFT, StripHeight> bands(tft);
+    bands.renderScreen(composePattern);
+
+    const uint32_t strips = (TFT_HEIGHT + StripHeight - 1) / StripHeight;
+    char line[128];
+    snprintf(line, sizeof(line), "strip %3u rows: buffer=%6lu B bursts=%3lu spiBytes=%lu",
+             (unsigned)StripHeight,
+             (unsigned long)(BandRenderer<VirtualTFT, StripHeight>::BUFFER_PIXELS * 2),
+             (unsigned long)(tft.bus().transactions - 5),
+             (unsigned long)tft.bus().spiBytes);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(strips + 5, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    assertPattern(damageRect(0, 0, TFT_WIDTH, TFT_HEIGHT));
+}
+
+void test_full_screen_strip_heights() {
+    checkFullScreen<1>();
+    checkFullScreen<7>();
+    checkFullScreen<8>();
+    checkFullScreen<16>();
+    checkFullScreen<32>();
+}
+
+// 窄矩形：一條緩衝可以裝好幾列
+void test_narrow_rect_packs_rows_into_strip() {
+    static BandRenderer<VirtualTFT, 1> bands(tft);
+    DamageRect rect = damageRect(50, 60, 16, 32);
+    bands.render(rect, composePattern);
+
+    // 240 / 16 = 15 列一條 -> 32 列分 3 次送出
+    TEST_ASSERT_EQUAL_UINT32(3 + 5, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(16 * 32 * 2, tft.bus().pixelBytes);
+    assertPattern(rect);
+}
+
+void test_empty_rect_sends_nothing() {
+    static BandRenderer<VirtualTFT, 8> bands(tft);
+    bands.render(damageRect(10, 10, 0, 5), composePattern);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+template <uint8_t StripHeight>
+static uint32_t renderSampleScene() {
+    tft.bus().clear(COLOR_MAGENTA);
+    static SceneCompositor<VirtualTFT, 4, 8, StripHeight> scene(tft);
+    scene.invalidate();
+    scene.setFill(0, 0, 0, TFT_WIDTH, 28, 0x1082);
+    scene.setText(1, 88, 6, "desk", COLOR_WHITE, 0x1082, 2);
+    scene.setText(2, 64, 36, " 42%", COLOR_GREEN, COLOR_BLACK, 2, 80);
+    scene.setText(3, -4, 230, "edge clipped", COLOR_YELLOW, COLOR_BLUE, 1);
+    scene.flush();
+    return tft.bus().hash();
+}
+
+// 帶高只影響 burst 切法，畫面內容必須一致
+void test_scene_output_independent_of_strip_height() {
+    uint32_t expected = renderSampleScene<1>();
+    TEST_ASSERT_EQUAL_HEX32(expected, renderSampleScene<5>());
+    TEST_ASSERT_EQUAL_HEX32(expected, renderSampleScene<16>());
+    TEST_ASSERT_EQUAL_HEX32(expected, renderSampleScene<240>());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_screen_strip_heights);
+    RUN_TEST(test_narrow_rect_packs_rows_into_strip);
+    RUN_TEST(test_empty_rect_sends_nothing);
+    RUN_TEST(test_scene_output_independent_of_strip_height);
+    return UNITY_END();
+}
@@ -23,6 +23,16 @@ void test_mqtt_port_validation() {
     TEST_ASSERT_FALSE(isValidMqttPort(0));
 }
 
+void test_mqtt_publish_payload_budget() {
+    TEST_ASSERT_EQUAL_UINT32(MQTT_MAX_PAYLOAD_BYTES - 7 - 29, mqttPublishPayloadBudget("sys/agents/rack/metrics/batch"));
+    TEST_ASSERT_EQUAL_UINT32(MQTT_MAX_PAYLOAD_BYTES - 7, mqttPublishPayloadBudget(nullptr));
+
+    char longTopic[MQTT_MAX_PAYLOAD_BYTES];
+    memset(longTopic, 'a', sizeof(longTopic) - 1);
+    longTopic[sizeof(longTopic) - 1] = '\0';
+    TEST_ASSERT_EQUAL_UINT32(0, mqttPublishPayloadBudget(longTopic));
+}
+
 void test_wifi_boot_ap_fallback_policy() {
     TEST_ASSERT_TRUE(shouldEnterApModeAfterBootRetries(false, true, 0));
     TEST_ASSERT_FALSE(shouldEnterApModeAfterBootRetries(true, true, 0));
@@ -65,6 +75,45 @@ void test_sender_topic_validation_policy() {
     TEST_ASSERT_FALSE(isValidSenderMetricsTopic("other/agents/desk/metrics/v2"));
 }
 
+void test_sender_topic_version_policy() {
+    TEST_ASSERT_EQUAL_UINT8(2, senderMetricsTopicVersion("sys/agents/desk/metrics/v2"));
+    TEST_ASSERT_EQUAL_UINT8(3, senderMetricsTopicVersion("sys/agents/desk/metrics/v3"));
+    TEST_ASSERT_EQUAL_UINT8(0, senderMetricsTopicVersion("sys/agents/desk/metrics/v4"));
+    TEST_ASSERT_EQUAL_UINT8(0, senderMetricsTopicVersion("sys/agents/+/metrics/v3"));
+    TEST_ASSERT_EQUAL_UINT8(0, senderMetricsTopicVersion(nullptr));
+
+    TEST_ASSERT_TRUE(isSameSenderMetricsHost("sys/agents/desk/metrics/v2", "sys/agents/desk/metrics/v3"));
+    TEST_ASSERT_TRUE(isSameSenderMetricsHost("sys/agents/desk/metrics/v2", "sys/agents/desk/metrics/v2"));
+    TEST_ASSERT_FALSE(isSameSenderMetricsHost("sys/agents/desk/metrics/v2", "sys/agents/desk2/metrics/v3"));
+    TEST_ASSERT_FALSE(isSameSenderMetricsHost("sys/agents/desk/metrics/v2", "sys/agents/desk/metrics/v4"));
+
+    char topic[64];
+    TEST_ASSERT_TRUE(senderMetricsTopicForVersion("sys/agents/desk/metrics/v2", 3, topic, sizeof(topic)));
+    TEST_ASSERT_EQUAL_STRING("sys/agents/desk/metrics/v3", topic);
+    TEST_ASSERT_FALSE(senderMetricsTopicForVersion("sys/agents/desk/metrics/v2", 4, topic, sizeof(topic)));
+    TEST_ASSERT_FALSE(senderMetricsTopicForVersion("sys/agents/desk/metrics/v2", 3, topic, 10));
+
+    char host[32];
+    TEST_ASSERT_TRUE(extractHostnameFromSenderTopic("sys/agents/desk/metrics/v3", host, sizeof(host)));
+    TEST_ASSERT_EQUAL_STRING("desk", host);
+}
+
+void test_batch_topic_policy() {
+    TEST_ASSERT_TRUE(isValidBatchMetricsTopic("sys/agents/rack-a/metrics/batch"));
+    TEST_ASSERT_FALSE(isValidBatchMetricsTopic(MQTT_BATCH_DISCOVERY_TOPIC));
+    TEST_ASSERT_FALSE(isValidBatchMetricsTopic("sys/agents//metrics/batch"));
+    TEST_ASSERT_FALSE(isValidBatchMetricsTopic("sys/agents/rack-a/metrics/v3"));
+    TEST_ASSERT_FALSE(isValidBatchMetricsTopic(nullptr));
+    TEST_ASSERT_EQUAL_UINT8(0, senderMetricsTopicVersion("sys/agents/rack-a/metrics/batch"));
+
+    TEST_ASSERT_TRUE(isSenderTopicForHost("sys/agents/desk/metrics/v2", "desk"));
+    TEST_ASSERT_TRUE(isSenderTopicForHost("sys/agents/desk/metrics/v3", "desk"));
+    TEST_ASSERT_FALSE(isSenderTopicForHost("sys/agents/desk/metrics/v2", "desk2"));
+    TEST_ASSERT_FALSE(isSenderTopicForHost("sys/agents/desk2/metrics/v2", "desk"));
+    TEST_ASSERT_FALSE(isSenderTopicForHost("sys/agents/+/metrics/v2", "+"));
+    TEST_ASSERT_FALSE(isSenderTopicForHost("sys/agents/desk/metrics/v2", nullptr));
+}
+
 void test_sender_wildcard_topic_validation_policy() {
     TEST_ASSERT_TRUE(isValidSenderWildcardMetricsTopic("sys/agents/+/metrics/v2"));
 
@@ -121,11 +170,14 @@ int main(int argc, char** argv) {
     RUN_TEST(test_backoff_increases_and_caps);
     RUN_TEST(test_wifi_credential_validation);
     RUN_TEST(test_mqtt_port_validation);
+    RUN_TEST(test_mqtt_publish_payload_budget);
     RUN_TEST(test_wifi_boot_ap_fallback_policy);
     RUN_TEST(test_mqtt_subscription_strategy_policy);
     RUN_TEST(test_sender_topic_subscription_policy);
     RUN_TEST(test_auto_enable_device_on_subscribed_topic_policy);
     RUN_TEST(test_sender_topic_validation_policy);
+    RUN_TEST(test_sender_topic_version_policy);
+    RUN_TEST(test_batch_topic_policy);
     RUN_TEST(test_sender_wildcard_topic_validation_policy);
     RUN_TEST(test_sender_topic_hostname_extract_policy);
     RUN_TEST(test_display_refresh_policy);
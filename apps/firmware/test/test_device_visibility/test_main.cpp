@@ -0,0 +1,100 @@
+#include <stdlib.h>
+#include <unity.h>
+
+#include "device_visibility.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_visible_order_follows_slot_order() {
+    DeviceVisibility<8> v;
+    TEST_ASSERT_EQUAL_UINT8(0, v.count());
+    TEST_ASSERT_EQUAL_INT16(-1, v.at(0));
+
+    v.setEnabledMask(0xFF);
+    v.setOnline(5, true);
+    v.setOnline(1, true);
+    v.setOnline(3, true);
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_INT16(1, v.at(0));
+    TEST_ASSERT_EQUAL_INT16(3, v.at(1));
+    TEST_ASSERT_EQUAL_INT16(5, v.at(2));
+    TEST_ASSERT_EQUAL_INT16(-1, v.at(3));
+
+    // 停用的設備即使在線上也不出現
+    v.setEnabled(3, false);
+    TEST_ASSERT_EQUAL_UINT8(2, v.count());
+    TEST_ASSERT_EQUAL_INT16(5, v.at(1));
+    TEST_ASSERT_TRUE(v.isOnline(3));
+
+    v.setOnline(1, false);
+    TEST_ASSERT_EQUAL_UINT8(1, v.count());
+    TEST_ASSERT_EQUAL_INT16(5, v.at(0));
+
+    v.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, v.count());
+}
+
+void test_wide_masks_cover_64_slots() {
+    DeviceVisibility<64> v;
+    TEST_ASSERT_EQUAL_UINT32(8, sizeof(DeviceVisibility<64>::Mask));
+    TEST_ASSERT_EQUAL_UINT32(4, sizeof(DeviceVisibility<32>::Mask));
+
+    v.setEnabledMask(~(DeviceVisibility<64>::Mask)0);
+    v.setOnline(63, true);
+    v.setOnline(0, true);
+    v.setOnline(40, true);
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_INT16(0, v.at(0));
+    TEST_ASSERT_EQUAL_INT16(40, v.at(1));
+    TEST_ASSERT_EQUAL_INT16(63, v.at(2));
+    TEST_ASSERT_EQUAL_UINT8(40, DeviceVisibility<64>::lowestSlot(DeviceVisibility<64>::bit(40) | DeviceVisibility<64>::bit(63)));
+}
+
+// 隨機轉換下，count()/at() 與直接掃描旗標的結果一致
+void test_random_transitions_match_linear_scan() {
+    DeviceVisibility<32> v;
+    bool online[32] = {};
+    bool enabled[32] = {};
+    srand(5);
+
+    for (int round = 0; round < 3000; round++) {
+        const uint8_t slot = (uint8_t)(rand() % 32);
+        switch (rand() % 3) {
+            case 0:
+                online[slot] = !online[slot];
+                v.setOnline(slot, online[slot]);
+                break;
+            case 1:
+                enabled[slot] = !enabled[slot];
+                v.setEnabled(slot, enabled[slot]);
+                break;
+            default: {
+                uint32_t mask = 0;
+                for (uint8_t i = 0; i < 32; i++) {
+                    if (rand() % 4 == 0) enabled[i] = !enabled[i];
+                    if (enabled[i]) mask |= 1UL << i;
+                }
+                v.setEnabledMask(mask);
+                break;
+            }
+        }
+
+        uint8_t expected = 0;
+        for (uint8_t i = 0; i < 32; i++) {
+            if (!online[i] || !enabled[i]) continue;
+            TEST_ASSERT_EQUAL_INT16(i, v.at(expected));
+            expected++;
+        }
+        TEST_ASSERT_EQUAL_UINT8(expected, v.count());
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_visible_order_follows_slot_order);
+    RUN_TEST(test_wide_masks_cover_64_slots);
+    RUN_TEST(test_random_transitions_match_linear_scan);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "fixed_decimal.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// 舊流程：ArduinoJson 以 double 讀入，as<float>() 後 scaleX10 / lroundf 再夾範圍
+static int16_t floatX10(const char* text) {
+    return clampI16(scaleX10((float)strtod(text, nullptr)));
+}
+
+static uint16_t floatU16(const char* text) {
+    return clampU16(lroundf((float)strtod(text, nullptr)));
+}
+
+// 解析失敗時回傳範圍外的標記值，比對必定不相等
+static long fixedX10(const char* text) {
+    int16_t out = 0;
+    return parseScaledX10(text, strlen(text), out) ? out : 99999;
+}
+
+static long fixedU16(const char* text) {
+    uint16_t out = 0;
+    return parseU16Value(text, strlen(text), out) ? out : 99999;
+}
+
+static void formatUnits(char* buf, size_t size, long units, int decimals) {
+    const unsigned long mag = (unsigned long)labs(units);
+    if (decimals == 0) {
+        snprintf(buf, size, "%s%lu", units < 0 ? "-" : "", mag);
+    } else {
+        const unsigned long scale = decimals == 1 ? 10 : 100;
+        snprintf(buf, size, "%s%lu.%0*lu", units < 0 ? "-" : "", mag / scale, decimals, mag % scale);
+    }
+}
+
+void test_scans_json_numbers_only() {
+    struct Case {
+        const char* text;
+        size_t used;
+    };
+    const Case cases[] = {
+        {"0", 1},      {"-0", 2},     {"12.5", 4},  {"1e3", 3},   {"1E+3", 4}, {"2.5e-1", 6},
+        {"12,", 2},    {"7]", 1},     {"01", 1},    {"", 0},      {"-", 0},    {"+1", 0},
+        {".5", 0},     {"1.", 0},     {"1.e2", 0},  {"1e", 0},    {"1e+", 0},  {"x", 0},
+    };
+    for (const Case& c : cases) {
+        FixedDecimal n;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(c.used, scanFixedDecimal(c.text, c.text + strlen(c.text), n), c.text);
+    }
+
+    // 整段必須是數字，失敗時 out 不變
+    int16_t x10 = 77;
+    uint16_t u16 = 77;
+    TEST_ASSERT_FALSE(parseScaledX10("12a", 3, x10));
+    TEST_ASSERT_FALSE(parseScaledX10("01", 2, x10));
+    TEST_ASSERT_FALSE(parseU16Value(" 1", 2, u16));
+    TEST_ASSERT_FALSE(parseU16Value(nullptr, 0, u16));
+    TEST_ASSERT_EQUAL_INT16(77, x10);
+    TEST_ASSERT_EQUAL_UINT16(77, u16);
+
+    // 不需要 '\0' 結尾
+    TEST_ASSERT_TRUE(parseScaledX10("42.45999", 5, x10));
+    TEST_ASSERT_EQUAL_INT16(425, x10);
+}
+
+void test_rounding_saturation_and_long_mantissas() {
+    TEST_ASSERT_EQUAL_INT16(1, fixedX10("0.05"));
+    TEST_ASSERT_EQUAL_INT16(-1, fixedX10("-0.05"));
+    TEST_ASSERT_EQUAL_INT16(0, fixedX10("0.0499999999999999999999"));
+    TEST_ASSERT_EQUAL_INT16(425, fixedX10("4.25e1"));
+    TEST_ASSERT_EQUAL_INT16(425, fixedX10("4250e-2"));
+    TEST_ASSERT_EQUAL_INT16(32767, fixedX10("1e30"));
+    TEST_ASSERT_EQUAL_INT16(-32768, fixedX10("-1e400"));
+    TEST_ASSERT_EQUAL_INT16(0, fixedX10("1e-400"));
+    TEST_ASSERT_EQUAL_INT16(123, fixedX10("12.3456789012345678901234"));
+
+    TEST_ASSERT_EQUAL_UINT16(3, fixedU16("2.5"));
+    TEST_ASSERT_EQUAL_UINT16(0, fixedU16("-2.5"));
+    TEST_ASSERT_EQUAL_UINT16(65535, fixedU16("65535.5"));
+    TEST_ASSERT_EQUAL_UINT16(65535, fixedU16("99999999999999999999999999"));
+    TEST_ASSERT_EQUAL_UINT16(1235, fixedU16("1234567890123456789012e-18"));
+}
+
+// x10 欄位：一位小數涵蓋夾值前後的每個值，結果與 float 流程完全相同
+void test_x10_one_decimal_matches_float_exhaustively() {
+    char buf[32];
+    uint32_t checked = 0;
+    for (long units = -34000; units <= 34000; units++) {
+        formatUnits(buf, sizeof(buf), units, 1);
+        TEST_ASSERT_EQUAL_INT16_MESSAGE(floatX10(buf), fixedX10(buf), buf);
+        checked++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(68001, checked);
+}
+
+// 兩位小數：包含 x.x5 中點在內也與 float 流程相同（float 在這個範圍的中點都落在遠離 0 的一側）
+void test_x10_two_decimals_match_float_including_midpoints() {
+    char buf[32];
+    for (long units = -340000; units <= 340000; units++) {
+        formatUnits(buf, sizeof(buf), units, 2);
+        const long actual = fixedX10(buf);
+        TEST_ASSERT_EQUAL_INT16_MESSAGE(floatX10(buf), actual, buf);
+        if (labs(units) % 10 == 5) {
+            TEST_ASSERT_EQUAL_INT16_MESSAGE(clampI16(units < 0 ? (units - 5) / 10 : (units + 5) / 10), actual, buf);
+        }
+    }
+}
+
+// u16 欄位：每個整數與每個一位小數（含 .5 中點）都與 float 流程相同
+void test_u16_matches_float_exhaustively() {
+    char buf[32];
+    for (long value = -1000; value <= 70000; value++) {
+        formatUnits(buf, sizeof(buf), value, 0);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(floatU16(buf), fixedU16(buf), buf);
+    }
+    for (long units = -1000; units <= 700000; units++) {
+        formatUnits(buf, sizeof(buf), units, 1);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(floatU16(buf), fixedU16(buf), buf);
+    }
+}
+
+void test_bench_fixed_vs_float() {
+    static char texts[1000][16];
+    for (int i = 0; i < 1000; i++) formatUnits(texts[i], sizeof(texts[i]), (i * 7919L) % 20000 - 5000, 1);
+
+    const uint32_t rounds = 500;
+    volatile long sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (int i = 0; i < 1000; i++) {
+            int16_t out = 0;
+            parseScaledX10(texts[i], strlen(texts[i]), out);
+            sink += out;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (int i = 0; i < 1000; i++) sink += floatX10(texts[i]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    const double n = rounds * 1000.0;
+    printf("fixed: %.1f ns/value   strtod + lroundf: %.1f ns/value (host FPU)\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / n,
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / n);
+    (void)sink;
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_scans_json_numbers_only);
+    RUN_TEST(test_rounding_saturation_and_long_mantissas);
+    RUN_TEST(test_x10_one_decimal_matches_float_exhaustively);
+    RUN_TEST(test_x10_two_decimals_match_float_including_midpoints);
+    RUN_TEST(test_u16_matches_float_exhaustively);
+    RUN_TEST(test_bench_fixed_vs_float);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "history_export.h"
+
+static DeviceHistory history;
+static uint8_t whole[HISTORY_EXPORT_BYTES];
+
+void setUp() {
+    history.clear();
+}
+
+void tearDown() {}
+
+static uint32_t readU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void recordLoad(int16_t cpuX10, int16_t gpuX10, uint32_t nowMs) {
+    MetricsFrameV2 frame{};
+    frame.cpuPctX10 = cpuX10;
+    frame.gpuPctX10 = gpuX10;
+    history.record(frame, nowMs);
+}
+
+static const uint8_t* bucketAt(uint8_t tier, uint8_t channel, uint8_t slot) {
+    const size_t section = (size_t)tier * HISTORY_EXPORT_CHANNELS + channel;
+    return whole + HISTORY_EXPORT_HEADER_BYTES + section * HISTORY_EXPORT_SECTION_BYTES + (size_t)slot * 3;
+}
+
+void test_empty_history_has_fixed_header_and_empty_buckets() {
+    TEST_ASSERT_EQUAL_UINT32(32 + 3 * 2 * DEVICE_HISTORY_TIER_BUCKETS * 3, HISTORY_EXPORT_BYTES);
+    TEST_ASSERT_EQUAL_UINT32(HISTORY_EXPORT_BYTES, historyExportRead(history, 5000, 0, whole, sizeof(whole)));
+
+    const uint8_t fixed[8] = {'M', 'H', 1, 2, 3, DEVICE_HISTORY_TIER_BUCKETS, 5, 0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(fixed, whole, 8);
+    TEST_ASSERT_EQUAL_UINT32(1000, readU32(whole + 8));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFUL, readU32(whole + 12));
+    TEST_ASSERT_EQUAL_UINT32(10000, readU32(whole + 16));
+    TEST_ASSERT_EQUAL_UINT32(60000, readU32(whole + 24));
+
+    for (uint8_t slot = 0; slot < DEVICE_HISTORY_TIER_BUCKETS; slot++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, bucketAt(2, 1, slot)[0]);
+        TEST_ASSERT_EQUAL_HEX8(0, bucketAt(2, 1, slot)[1]);
+    }
+}
+
+// 桶靠右對齊（最新的在最後），不足整層時前面是空桶
+void test_buckets_are_right_aligned_per_tier_and_channel() {
+    recordLoad(100, 900, 60000);
+    recordLoad(300, 700, 61000);
+    recordLoad(500, 500, 73500);
+    historyExportRead(history, 74000, 0, whole, sizeof(whole));
+
+    const uint8_t last = DEVICE_HISTORY_TIER_BUCKETS - 1;
+    // 1 s 層：60000、61000、空 x 11、73000
+    TEST_ASSERT_EQUAL_UINT8(100, bucketAt(0, 0, last)[2]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, bucketAt(0, 0, last - 1)[0]);
+    TEST_ASSERT_EQUAL_UINT8(60, bucketAt(0, 0, last - 12)[2]);
+    TEST_ASSERT_EQUAL_UINT8(20, bucketAt(0, 0, last - 13)[2]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, bucketAt(0, 0, last - 14)[0]);
+    TEST_ASSERT_EQUAL_UINT32(1000, readU32(whole + 12));  // 目前這一桶從 73000 開始
+
+    // 1 min 層只有一桶，GPU 的 min/max/mean
+    const uint8_t* gpu = bucketAt(2, 1, last);
+    TEST_ASSERT_EQUAL_UINT8(100, gpu[0]);
+    TEST_ASSERT_EQUAL_UINT8(180, gpu[1]);
+    TEST_ASSERT_EQUAL_UINT8(140, gpu[2]);
+    TEST_ASSERT_EQUAL_UINT32(14000, readU32(whole + 28));
+}
+
+// AsyncWebServer 以任意大小分段讀取，結果必須與一次讀完相同
+void test_chunked_reads_match_single_read() {
+    srand(11);
+    uint32_t now = 1000;
+    for (int i = 0; i < 400; i++) {
+        now += 900 + rand() % 300;
+        recordLoad((int16_t)(rand() % 1001), (int16_t)(rand() % 1001), now);
+    }
+    historyExportRead(history, now, 0, whole, sizeof(whole));
+
+    uint8_t chunked[HISTORY_EXPORT_BYTES + 16];
+    memset(chunked, 0xAA, sizeof(chunked));
+    size_t offset = 0;
+    while (true) {
+        const size_t maxLen = 1 + rand() % 97;
+        const size_t n = historyExportRead(history, now, offset, chunked + offset, maxLen);
+        if (n == 0) break;
+        TEST_ASSERT_TRUE(n <= maxLen);
+        offset += n;
+    }
+    TEST_ASSERT_EQUAL_UINT32(HISTORY_EXPORT_BYTES, offset);
+    TEST_ASSERT_EQUAL_MEMORY(whole, chunked, HISTORY_EXPORT_BYTES);
+    TEST_ASSERT_EQUAL_HEX8(0xAA, chunked[HISTORY_EXPORT_BYTES]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_history_has_fixed_header_and_empty_buckets);
+    RUN_TEST(test_buckets_are_right_aligned_per_tier_and_channel);
+    RUN_TEST(test_chunked_reads_match_single_read);
+    return UNITY_END();
+}
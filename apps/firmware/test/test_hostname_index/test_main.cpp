@@ -0,0 +1,134 @@
+#include <chrono>
+#include <stdio.h>
+#include <unity.h>
+
+#include "hostname_index.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+template <uint8_t N>
+struct HostTable {
+    char names[N][32];
+    HostnameIndex<N> index;
+    mutable uint32_t compares = 0;
+
+    void fill() {
+        index.clear();
+        for (uint8_t i = 0; i < N; i++) {
+            snprintf(names[i], sizeof(names[i]), "workstation-%02u", i);
+            index.insert(hostnameHash(names[i]), i);
+        }
+    }
+
+    int16_t find(const HostKey& key) const {
+        return index.find(key, [this](uint8_t item) {
+            compares++;
+            return names[item];
+        });
+    }
+
+    // 舊實作：逐一 strcmp
+    int16_t linearFind(const char* name) const {
+        for (uint8_t i = 0; i < N; i++) {
+            compares++;
+            if (strcmp(names[i], name) == 0) return i;
+        }
+        return -1;
+    }
+};
+
+void test_finds_every_inserted_name_and_rejects_misses() {
+    static HostTable<64> table;
+    table.fill();
+    TEST_ASSERT_EQUAL_UINT8(64, table.index.size());
+
+    for (uint8_t i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_INT16(i, table.find(hostKey(table.names[i])));
+    }
+    TEST_ASSERT_EQUAL_INT16(-1, table.find(hostKey("workstation-64")));
+    TEST_ASSERT_EQUAL_INT16(-1, table.find(hostKey("")));
+    TEST_ASSERT_EQUAL_INT16(-1, table.find(HostKey{nullptr, 0}));
+
+    // 表滿之後不再接受
+    TEST_ASSERT_FALSE(table.index.insert(hostnameHash("extra"), 0));
+}
+
+// hash 相同時仍以字串區分，且線性探測能越過佔用的位置
+void test_colliding_hashes_fall_back_to_string_compare() {
+    HostTable<4> table;
+    strcpy(table.names[0], "alpha");
+    strcpy(table.names[1], "beta");
+    strcpy(table.names[2], "gamma");
+    table.index.insert(7, 0);
+    table.index.insert(7, 1);
+    table.index.insert(7 + HostnameIndex<4>::SLOTS, 2);
+
+    TEST_ASSERT_EQUAL_INT16(0, table.find(HostKey{"alpha", 7}));
+    TEST_ASSERT_EQUAL_INT16(1, table.find(HostKey{"beta", 7}));
+    TEST_ASSERT_EQUAL_INT16(2, table.find(HostKey{"gamma", 7 + HostnameIndex<4>::SLOTS}));
+    TEST_ASSERT_EQUAL_INT16(-1, table.find(HostKey{"delta", 7}));
+
+    // 不同 hash 的項目不會觸發 strcmp
+    table.compares = 0;
+    TEST_ASSERT_EQUAL_INT16(2, table.find(HostKey{"gamma", 7 + HostnameIndex<4>::SLOTS}));
+    TEST_ASSERT_EQUAL_UINT32(1, table.compares);
+
+    table.index.clear();
+    TEST_ASSERT_EQUAL_INT16(-1, table.find(HostKey{"alpha", 7}));
+}
+
+// 每則訊息：舊流程對設定掃 2 次（狀態 + getOrCreateDevice）、對設備掃 1 次；
+// 新流程算一次 hash，設定與設備各查一次表
+template <uint8_t N>
+static void benchPerMessage() {
+    static HostTable<N> config;
+    static HostTable<N> store;
+    config.fill();
+    store.fill();
+
+    const uint32_t messages = 200000;
+    volatile int32_t sink = 0;
+
+    config.compares = store.compares = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t m = 0; m < messages; m++) {
+        const char* host = store.names[m % N];
+        sink += config.linearFind(host) + config.linearFind(host) + store.linearFind(host);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    const uint32_t legacyCompares = config.compares + store.compares;
+
+    config.compares = store.compares = 0;
+    for (uint32_t m = 0; m < messages; m++) {
+        const HostKey key = hostKey(store.names[m % N]);
+        sink += config.find(key) + store.find(key);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    const uint32_t indexedCompares = config.compares + store.compares;
+
+    const double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / messages;
+    const double indexedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / messages;
+    printf("MAX_DEVICES=%2u  linear: %6.2f strcmp %7.1f ns/msg   indexed: %4.2f strcmp %6.1f ns/msg\n",
+           N, (double)legacyCompares / messages, legacyNs, (double)indexedCompares / messages, indexedNs);
+
+    // 命中時每次查表只比對一次字串，與設備數無關
+    TEST_ASSERT_EQUAL_UINT32(2 * messages, indexedCompares);
+    TEST_ASSERT_EQUAL_UINT32(3 * messages * (N + 1) / 2, legacyCompares);
+    (void)sink;
+}
+
+void test_bench_per_message_lookup_cost() {
+    benchPerMessage<8>();
+    benchPerMessage<32>();
+    benchPerMessage<64>();
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_finds_every_inserted_name_and_rejects_misses);
+    RUN_TEST(test_colliding_hashes_fall_back_to_string_compare);
+    RUN_TEST(test_bench_per_message_lookup_cost);
+    return UNITY_END();
+}
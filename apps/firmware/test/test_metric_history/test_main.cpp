@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <unity.h>
+
+#include "metric_history.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_series_keeps_latest_samples_in_order() {
+    MetricSeries<4, PercentX10Codec> series;
+    TEST_ASSERT_EQUAL_UINT8(0, series.size());
+    TEST_ASSERT_EQUAL_INT32(0, series.min());
+    TEST_ASSERT_EQUAL_INT32(0, series.mean());
+
+    for (int32_t v = 1; v <= 3; v++) series.push(v * 100);
+    TEST_ASSERT_EQUAL_UINT8(3, series.size());
+    TEST_ASSERT_EQUAL_INT32(100, series.value(0));
+    TEST_ASSERT_EQUAL_INT32(300, series.latest());
+
+    for (int32_t v = 4; v <= 6; v++) series.push(v * 100);
+    TEST_ASSERT_EQUAL_UINT8(4, series.size());
+    TEST_ASSERT_EQUAL_INT32(300, series.value(0));
+    TEST_ASSERT_EQUAL_INT32(600, series.value(3));
+    TEST_ASSERT_EQUAL_INT32(300, series.min());
+    TEST_ASSERT_EQUAL_INT32(600, series.max());
+    TEST_ASSERT_EQUAL_INT32(450, series.mean());
+
+    series.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, series.size());
+    TEST_ASSERT_EQUAL_INT32(0, series.max());
+}
+
+void test_percent_and_temp_codecs_round_and_clamp() {
+    TEST_ASSERT_EQUAL_UINT8(0, PercentX10Codec::encode(-40));
+    TEST_ASSERT_EQUAL_UINT8(85, PercentX10Codec::encode(423));
+    TEST_ASSERT_EQUAL_INT32(425, PercentX10Codec::decode(85));
+    TEST_ASSERT_EQUAL_UINT8(200, PercentX10Codec::encode(1000));
+    TEST_ASSERT_EQUAL_UINT8(200, PercentX10Codec::encode(1200));
+
+    TEST_ASSERT_EQUAL_UINT8(122, TempX10Codec::encode(612));
+    TEST_ASSERT_EQUAL_UINT8(255, TempX10Codec::encode(1500));
+    TEST_ASSERT_EQUAL_INT32(1275, TempX10Codec::decode(255));
+}
+
+// 流量 codec 必須單調、涵蓋 uint16 全範圍，解碼誤差不超過約 3%
+void test_rate_codec_is_monotonic_with_bounded_error() {
+    uint8_t previous = 0;
+    for (int32_t v = 0; v <= 65535; v++) {
+        const uint8_t code = RateCodec::encode(v);
+        TEST_ASSERT_TRUE(code >= previous);
+        TEST_ASSERT_TRUE(code <= RateCodec::MAX_CODE);
+        previous = code;
+
+        const int32_t decoded = RateCodec::decode(code);
+        const int32_t error = decoded > v ? decoded - v : v - decoded;
+        TEST_ASSERT_TRUE(error * 32 <= v + 16);
+    }
+    TEST_ASSERT_EQUAL_UINT8(RateCodec::MAX_CODE, RateCodec::encode(70000));
+}
+
+// 單調佇列的最小/最大值與累加和的平均，必須與窗內暴力掃描的結果一致
+template <uint8_t Window, typename Codec>
+static void checkAgainstBruteForce(int32_t range, uint32_t seed) {
+    MetricSeries<Window, Codec> series;
+    srand(seed);
+
+    for (int round = 0; round < 1000; round++) {
+        // 偶爾連續相同值，測試相等時的出隊
+        const int32_t raw = (round % 7 < 2) ? range / 2 : rand() % (range + 1);
+        series.push(raw);
+
+        int32_t lo = 0x7FFFFFFF;
+        int32_t hi = -1;
+        int32_t sum = 0;
+        for (uint8_t i = 0; i < series.size(); i++) {
+            const int32_t v = series.value(i);
+            if (v < lo) lo = v;
+            if (v > hi) hi = v;
+            sum += v;
+        }
+        TEST_ASSERT_EQUAL_INT32(Codec::decode(Codec::encode(raw)), series.latest());
+        TEST_ASSERT_EQUAL_INT32(lo, series.min());
+        TEST_ASSERT_EQUAL_INT32(hi, series.max());
+        TEST_ASSERT_EQUAL_INT32((sum + series.size() / 2) / series.size(), series.mean());
+    }
+}
+
+void test_aggregates_match_brute_force() {
+    checkAgainstBruteForce<1, PercentX10Codec>(1000, 1);
+    checkAgainstBruteForce<7, TempX10Codec>(1300, 2);
+    checkAgainstBruteForce<DEVICE_HISTORY_SAMPLES, PercentX10Codec>(1000, 3);
+    checkAgainstBruteForce<DEVICE_HISTORY_SAMPLES, RateCodec>(65535, 4);
+    checkAgainstBruteForce<255, RateCodec>(5000, 5);
+}
+
+void test_device_history_records_every_channel() {
+    DeviceHistory history;
+    MetricsFrameV2 frame{};
+    frame.cpuPctX10 = 423;
+    frame.cpuTempCX10 = 612;
+    frame.ramPctX10 = 550;
+    frame.gpuPctX10 = 980;
+    frame.gpuTempCX10 = 700;
+    frame.netRxKbps = 1280;
+    frame.netTxKbps = 12;
+    frame.diskReadKBps = 300;
+    frame.diskWriteKBps = 0;
+    history.record(frame, 0);
+
+    TEST_ASSERT_EQUAL_INT32(425, history.cpuPct.latest());
+    TEST_ASSERT_EQUAL_INT32(610, history.cpuTemp.latest());
+    TEST_ASSERT_EQUAL_INT32(550, history.ramPct.latest());
+    TEST_ASSERT_EQUAL_INT32(980, history.gpuPct.latest());
+    TEST_ASSERT_EQUAL_INT32(700, history.gpuTemp.latest());
+    TEST_ASSERT_EQUAL_INT32(1312, history.netRx.latest());
+    TEST_ASSERT_EQUAL_INT32(12, history.netTx.latest());
+    TEST_ASSERT_EQUAL_INT32(296, history.diskRead.latest());  // 288..303 的中點
+    TEST_ASSERT_EQUAL_INT32(0, history.diskWrite.latest());
+
+    TEST_ASSERT_EQUAL_UINT8(85, history.cpuTiers.minutes.at(0));
+    TEST_ASSERT_EQUAL_UINT8(196, history.gpuTiers.seconds.at(0));
+
+    history.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, history.netRx.size());
+    TEST_ASSERT_EQUAL_UINT8(0, history.cpuTiers.tenSeconds.size());
+}
+
+// 同一串取樣在各層的桶，必須等於直接把該時段的取樣拿來算的結果
+template <typename Tier>
+static void checkTierAgainstBruteForce(const Tier& tier, const uint8_t* codes, const uint32_t* times,
+                                       int count, uint32_t nowMs) {
+    const uint32_t period = Tier::periodMs();
+    const uint32_t openStart = nowMs - nowMs % period;
+    for (uint8_t i = 0; i < tier.size(); i++) {
+        const uint32_t start = openStart - (uint32_t)(tier.size() - 1 - i) * period;
+        uint8_t lo = 0xFF;
+        uint8_t hi = 0;
+        uint32_t sum = 0;
+        uint32_t n = 0;
+        for (int k = 0; k < count; k++) {
+            if (times[k] < start || times[k] >= start + period) continue;
+            if (codes[k] < lo) lo = codes[k];
+            if (codes[k] > hi) hi = codes[k];
+            sum += codes[k];
+            n++;
+        }
+
+        const HistoryBucket b = tier.bucket(i);
+        TEST_ASSERT_EQUAL(n == 0, b.empty());
+        if (n == 0) continue;
+        TEST_ASSERT_EQUAL_UINT8(lo, b.min);
+        TEST_ASSERT_EQUAL_UINT8(hi, b.max);
+        TEST_ASSERT_EQUAL_UINT8((sum + n / 2) / n, b.mean);
+    }
+}
+
+// 約每秒一筆、偶爾斷線數十秒到數分鐘，三層都與暴力計算一致
+void test_tiers_roll_up_like_brute_force() {
+    static uint8_t codes[5000];
+    static uint32_t times[5000];
+    HistoryTiers<PercentX10Codec> tiers;
+    srand(7);
+
+    uint32_t now = 123456;
+    int count = 0;
+    for (; count < 5000; count++) {
+        now += 700 + rand() % 600;
+        if (rand() % 200 == 0) now += 20000 + rand() % 200000;
+        const int32_t raw = rand() % 1001;
+        codes[count] = PercentX10Codec::encode(raw);
+        times[count] = now;
+        tiers.add(raw, now);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(DEVICE_HISTORY_TIER_BUCKETS, tiers.minutes.size());
+    checkTierAgainstBruteForce(tiers.seconds, codes, times, count, now);
+    checkTierAgainstBruteForce(tiers.tenSeconds, codes, times, count, now);
+    checkTierAgainstBruteForce(tiers.minutes, codes, times, count, now);
+}
+
+void test_tier_fills_gaps_and_survives_millis_wrap() {
+    HistoryTier<4, 1000, PercentX10Codec> tier;
+    tier.add(10, 0xFFFFFC18UL);  // 桶起點 0xFFFFFAF0（對齊 1000 ms），距溢位 1296 ms
+    tier.add(30, 0xFFFFFD00UL);
+    TEST_ASSERT_EQUAL_UINT8(1, tier.size());
+    TEST_ASSERT_EQUAL_UINT8(20, tier.at(0));
+
+    // 跨過 0 之後 2576 ms：中間空一桶
+    tier.add(50, 0x00000500UL);
+    TEST_ASSERT_EQUAL_UINT8(3, tier.size());
+    TEST_ASSERT_TRUE(tier.bucket(1).empty());
+    TEST_ASSERT_EQUAL_UINT8(0, tier.at(1));
+    TEST_ASSERT_EQUAL_UINT8(50, tier.bucket(2).max);
+
+    // 離線很久：整層都是空桶，只剩目前這一桶
+    tier.add(70, 0x00100000UL);
+    TEST_ASSERT_EQUAL_UINT8(4, tier.size());
+    for (uint8_t i = 0; i < 3; i++) TEST_ASSERT_TRUE(tier.bucket(i).empty());
+    TEST_ASSERT_EQUAL_UINT8(70, tier.at(3));
+    TEST_ASSERT_TRUE(0x00100000UL - tier.openedAtMs() < 1000);
+}
+
+// 預設設定下 8 台設備的全部歷史不到 18 KB，其中分層歷史每台約 1.1 KB 涵蓋一小時
+void test_default_footprint_fits_budget() {
+    TEST_ASSERT_TRUE(sizeof(PercentSeries) <= 3 * DEVICE_HISTORY_SAMPLES + 12);
+    TEST_ASSERT_TRUE(sizeof(HistoryTiers<PercentX10Codec>) <= 3 * (3 * DEVICE_HISTORY_TIER_BUCKETS + 12));
+    TEST_ASSERT_TRUE(sizeof(DeviceHistory) * 8 <= 18432);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_series_keeps_latest_samples_in_order);
+    RUN_TEST(test_percent_and_temp_codecs_round_and_clamp);
+    RUN_TEST(test_rate_codec_is_monotonic_with_bounded_error);
+    RUN_TEST(test_aggregates_match_brute_force);
+    RUN_TEST(test_device_history_records_every_channel);
+    RUN_TEST(test_tiers_roll_up_like_brute_force);
+    RUN_TEST(test_tier_fills_gaps_and_survives_millis_wrap);
+    RUN_TEST(test_default_footprint_fits_budget);
+    return UNITY_END();
+}
@@ -0,0 +1,483 @@
+#include <chrono>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <vector>
+
+#include "metrics_batch.h"
+#include "metrics_delta.h"
+#include "../support/metrics_frames.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// docs/protocol/metrics-v3.md 的 batch 範例，與 sender 端 Python 測試共用同一組 bytes：
+// desk 只送 cpu 的一般 frame，nas 為 keySeq 7 之後的 delta
+static const uint8_t DOC_BATCH_EXAMPLE[] = {
+    0x38, 0x02, 0x04, 0x64, 0x65, 0x73, 0x6B, 0x30, 0x03, 0x00, 0x18, 0xF4, 0x14, 0x20, 0xA8, 0x01, 0x46, 0x02, 0x03,
+    0x6E, 0x61, 0x73, 0x32, 0x01, 0x04, 0x00, 0xF8, 0x14, 0x20, 0x08, 0x07, 0xAF, 0x01, 0x00, 0x08, 0x6F, 0x4E,
+};
+
+struct Collected {
+    char hostname[32];
+    uint32_t hash;
+    MetricsFrameV2 frame;
+    MetricsV3Info info;
+};
+
+static int16_t collect(const uint8_t* payload, size_t length, std::vector<Collected>& out) {
+    out.clear();
+    return forEachMetricsBatchEntry(payload, length, [&](const MetricsBatchEntry& entry) {
+        Collected c;
+        snprintf(c.hostname, sizeof(c.hostname), "%s", entry.hostname);
+        c.hash = entry.key.hash;
+        c.frame = entry.frame;
+        c.info = entry.info;
+        out.push_back(c);
+    });
+}
+
+void test_decodes_protocol_example() {
+    std::vector<Collected> got;
+    TEST_ASSERT_EQUAL_INT16(2, collect(DOC_BATCH_EXAMPLE, sizeof(DOC_BATCH_EXAMPLE), got));
+
+    TEST_ASSERT_EQUAL_STRING("desk", got[0].hostname);
+    TEST_ASSERT_EQUAL_UINT32(hostnameHash("desk"), got[0].hash);
+    TEST_ASSERT_EQUAL_UINT8(0, got[0].info.flags);
+    TEST_ASSERT_EQUAL_INT16(424, got[0].frame.cpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(582, got[0].frame.cpuTempCX10);
+    TEST_ASSERT_EQUAL_UINT16(0, got[0].frame.ramTotalMB);
+
+    TEST_ASSERT_EQUAL_STRING("nas", got[1].hostname);
+    TEST_ASSERT_EQUAL_UINT8(METRICS_V3_FLAG_DELTA, got[1].info.flags);
+    TEST_ASSERT_EQUAL_UINT8(8, got[1].info.seq);
+    TEST_ASSERT_EQUAL_UINT8(7, got[1].info.keySeq);
+    TEST_ASSERT_EQUAL_INT16(431, got[1].frame.cpuPctX10);
+    TEST_ASSERT_EQUAL_UINT16(2048, got[1].frame.netRxKbps);
+    // 前一筆的值不會殘留到下一筆
+    TEST_ASSERT_EQUAL_INT16(0, got[1].frame.cpuTempCX10);
+
+    MetricsFrameV2 desk;
+    desk.senderTsMs = (uint32_t)(1739999999000ULL & 0xFFFFFFFFUL);
+    desk.cpuPctX10 = 424;
+    desk.cpuTempCX10 = 582;
+    MetricsFrameV2 nas;
+    nas.senderTsMs = desk.senderTsMs + 1000;
+    nas.cpuPctX10 = 431;
+    nas.netRxKbps = 2048;
+
+    uint8_t buf[64];
+    MetricsBatchWriter writer(buf, sizeof(buf));
+    TEST_ASSERT_TRUE(writer.add("desk", desk, (1U << V3_CPU_PCT) | (1U << V3_CPU_TEMP)));
+    TEST_ASSERT_TRUE(writer.add("nas", nas, (1U << V3_CPU_PCT) | (1U << V3_NET_RX), METRICS_V3_FLAG_DELTA, 8, 7));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(DOC_BATCH_EXAMPLE), writer.finish());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(DOC_BATCH_EXAMPLE, buf, sizeof(DOC_BATCH_EXAMPLE)));
+}
+
+void test_random_batches_round_trip() {
+    srand(25);
+    uint8_t buf[MQTT_MAX_PAYLOAD_BYTES];
+    std::vector<Collected> got;
+    for (int round = 0; round < 2000; round++) {
+        const uint8_t hosts = (uint8_t)(1 + rand() % METRICS_BATCH_MAX_HOSTS);
+        MetricsBatchWriter writer(buf, sizeof(buf));
+        std::vector<Collected> sent;
+        for (uint8_t h = 0; h < hosts; h++) {
+            Collected c;
+            snprintf(c.hostname, sizeof(c.hostname), "vm-%u-%u", (unsigned)round, (unsigned)h);
+            c.frame.senderTsMs = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            uint8_t* fields = metricsV3FieldBytes(c.frame);
+            for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT * 2; i++) fields[i] = (uint8_t)rand();
+            const uint8_t kind = (uint8_t)(rand() % 3);
+            c.info.flags = kind == 0 ? 0 : kind == 1 ? METRICS_V3_FLAG_KEYFRAME : METRICS_V3_FLAG_DELTA;
+            c.info.present = kind == 1 ? METRICS_V3_ALL_FIELDS : (uint16_t)(rand() & METRICS_V3_ALL_FIELDS);
+            c.info.seq = (uint8_t)rand();
+            c.info.keySeq = kind == 1 ? c.info.seq : (uint8_t)rand();
+            if (!writer.add(c.hostname, c.frame, c.info.present, c.info.flags, c.info.seq, c.info.keySeq)) break;
+            sent.push_back(c);
+        }
+        const size_t len = writer.finish();
+        TEST_ASSERT_TRUE(len > 0 && len <= sizeof(buf));
+        TEST_ASSERT_EQUAL_INT16((int16_t)sent.size(), collect(buf, len, got));
+
+        for (size_t i = 0; i < sent.size(); i++) {
+            TEST_ASSERT_EQUAL_STRING(sent[i].hostname, got[i].hostname);
+            TEST_ASSERT_EQUAL_UINT8(sent[i].info.flags, got[i].info.flags);
+            TEST_ASSERT_EQUAL_UINT16(sent[i].info.present, got[i].info.present);
+            if (sent[i].info.flags) {
+                TEST_ASSERT_EQUAL_UINT8(sent[i].info.seq, got[i].info.seq);
+                TEST_ASSERT_EQUAL_UINT8(sent[i].info.keySeq, got[i].info.keySeq);
+            }
+            MetricsFrameV2 expected = sent[i].frame;
+            uint8_t* fields = metricsV3FieldBytes(expected);
+            for (uint8_t f = 0; f < METRICS_V3_FIELD_COUNT; f++) {
+                if (!(sent[i].info.present & (1U << f))) memset(fields + f * 2, 0, 2);
+            }
+            TEST_ASSERT_TRUE(sameFields(expected, got[i].frame));
+        }
+    }
+}
+
+// 任何損壞都整則拒絕，不會先寫入一部分設備
+void test_rejects_corrupted_batches() {
+    uint8_t buf[sizeof(DOC_BATCH_EXAMPLE) + 1];
+    std::vector<Collected> got;
+    for (size_t bit = 0; bit < sizeof(DOC_BATCH_EXAMPLE) * 8; bit++) {
+        memcpy(buf, DOC_BATCH_EXAMPLE, sizeof(DOC_BATCH_EXAMPLE));
+        buf[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        TEST_ASSERT_EQUAL_INT16(-1, collect(buf, sizeof(DOC_BATCH_EXAMPLE), got));
+        TEST_ASSERT_EQUAL_UINT32(0, got.size());
+    }
+    for (size_t len = 0; len < sizeof(DOC_BATCH_EXAMPLE); len++) {
+        TEST_ASSERT_EQUAL_INT16(-1, collect(DOC_BATCH_EXAMPLE, len, got));
+    }
+    memcpy(buf, DOC_BATCH_EXAMPLE, sizeof(DOC_BATCH_EXAMPLE));
+    buf[sizeof(DOC_BATCH_EXAMPLE)] = 0;
+    TEST_ASSERT_EQUAL_INT16(-1, collect(buf, sizeof(buf), got));
+    TEST_ASSERT_EQUAL_INT16(-1, collect(nullptr, 0, got));
+
+    // CRC 正確但結構不對：數量多一筆、hostname 含 '/'
+    struct Patch {
+        size_t offset;
+        uint8_t value;
+    };
+    const Patch patches[] = {{1, 3}, {1, 0}, {4, '/'}, {2, 0}, {2, 32}};
+    for (const Patch& patch : patches) {
+        memcpy(buf, DOC_BATCH_EXAMPLE, sizeof(DOC_BATCH_EXAMPLE));
+        buf[patch.offset] = patch.value;
+        const size_t body = sizeof(DOC_BATCH_EXAMPLE) - METRICS_V3_CRC_BYTES;
+        writeLe16(buf + body, metricsV3Crc(buf, body));
+        TEST_ASSERT_EQUAL_INT16(-1, collect(buf, sizeof(DOC_BATCH_EXAMPLE), got));
+    }
+
+    // 單台 v3 frame 不是 batch
+    MetricsFrameV2 frame;
+    const size_t len = encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT16(-1, collect(buf, len, got));
+}
+
+void test_writer_limits() {
+    MetricsFrameV2 frame;
+    uint8_t buf[MQTT_MAX_PAYLOAD_BYTES];
+    char name[40];
+
+    // 放不下時拒絕該筆，已加入的內容仍可送出
+    MetricsBatchWriter writer(buf, sizeof(buf));
+    uint8_t added = 0;
+    while (true) {
+        snprintf(name, sizeof(name), "host-%02u", (unsigned)added);
+        if (!writer.add(name, frame)) break;
+        added++;
+    }
+    const size_t perHost = 1 + strlen("host-00") + metricsV3FrameBytes(METRICS_V3_ALL_FIELDS) - METRICS_V3_CRC_BYTES;
+    TEST_ASSERT_EQUAL_UINT8((sizeof(buf) - METRICS_BATCH_HEADER_BYTES - METRICS_V3_CRC_BYTES) / perHost, added);
+    const size_t len = writer.finish();
+    TEST_ASSERT_TRUE(len <= sizeof(buf));
+    std::vector<Collected> got;
+    TEST_ASSERT_EQUAL_INT16(added, collect(buf, len, got));
+
+    // 數量上限
+    static uint8_t big[4096];
+    MetricsBatchWriter many(big, sizeof(big));
+    for (uint8_t i = 0; i < METRICS_BATCH_MAX_HOSTS; i++) {
+        snprintf(name, sizeof(name), "h%u", (unsigned)i);
+        TEST_ASSERT_TRUE(many.add(name, frame, 0));
+    }
+    TEST_ASSERT_FALSE(many.add("one-more", frame, 0));
+
+    MetricsBatchWriter names(buf, sizeof(buf));
+    TEST_ASSERT_FALSE(names.add("", frame));
+    TEST_ASSERT_FALSE(names.add("a/b", frame));
+    TEST_ASSERT_FALSE(names.add("0123456789012345678901234567890123", frame));
+    TEST_ASSERT_FALSE(names.add("desk", frame, METRICS_V3_ALL_FIELDS, METRICS_V3_FLAG_KEYFRAME | METRICS_V3_FLAG_DELTA));
+    TEST_ASSERT_EQUAL_UINT32(0, names.finish());
+}
+
+// 接收端的共同部分：hostname 索引、delta 重建、dirty 比對，對應 DeviceStore
+template <uint8_t Hosts>
+struct BenchSink {
+    char names[Hosts][32];
+    HostnameIndex<Hosts> index;
+    MetricsDeltaState states[Hosts];
+    MetricsFrameV2 shown[Hosts];
+    uint32_t applied = 0;
+    uint32_t dirty = 0;
+
+    void begin() {
+        index.clear();
+        for (uint8_t i = 0; i < Hosts; i++) {
+            snprintf(names[i], sizeof(names[i]), "host-%02u", (unsigned)i);
+            index.insert(hostnameHash(names[i]), i);
+            states[i] = MetricsDeltaState{};
+            shown[i] = MetricsFrameV2{};
+        }
+        applied = 0;
+        dirty = 0;
+    }
+
+    void apply(const HostKey& key, const MetricsFrameV2& decoded, const MetricsV3Info& info) {
+        const int16_t i = index.find(key, [this](uint8_t item) { return names[item]; });
+        if (i < 0) return;
+        MetricsFrameV2 out;
+        uint16_t candidates = 0;
+        if (applyMetricsV3Frame(states[i], info, decoded, out, candidates) != DELTA_APPLIED) return;
+        dirty += metricsDirtyMaskForFields(metricsChangedFields(shown[i], out, candidates));
+        shown[i] = out;
+        applied++;
+    }
+};
+
+static void stepFrame(MetricsFrameV2& frame) {
+    frame.senderTsMs += 1000;
+    if (rand() % 4 != 0) frame.cpuPctX10 = (int16_t)(rand() % 1000);
+    if (rand() % 10 == 0) frame.cpuTempCX10 = (int16_t)(400 + rand() % 400);
+    if (rand() % 5 == 0) frame.gpuPctX10 = (int16_t)(rand() % 1000);
+    if (rand() % 2 == 0) frame.netRxKbps = (uint16_t)rand();
+    if (rand() % 2 == 0) frame.netTxKbps = (uint16_t)rand();
+}
+
+// PUBLISH（QoS 0）的完整封包：fixed header、remaining length、topic 長度與 topic、payload
+static std::vector<uint8_t> publishPacket(const char* topic, const uint8_t* payload, size_t length) {
+    const size_t topicLen = strlen(topic);
+    size_t remaining = 2 + topicLen + length;
+    std::vector<uint8_t> wire{0x30};
+    do {
+        uint8_t digit = (uint8_t)(remaining & 127);
+        remaining >>= 7;
+        if (remaining) digit |= 128;
+        wire.push_back(digit);
+    } while (remaining);
+    wire.push_back((uint8_t)(topicLen >> 8));
+    wire.push_back((uint8_t)topicLen);
+    wire.insert(wire.end(), topic, topic + topicLen);
+    wire.insert(wire.end(), payload, payload + length);
+    return wire;
+}
+
+struct WireReader {
+    const uint8_t* data;
+    size_t pos;
+
+    __attribute__((noinline)) int read() {
+        return data[pos++];
+    }
+};
+
+typedef std::function<void(char*, uint8_t*, unsigned int)> MqttCallback;
+
+// 仿 PubSubClient 收一則 PUBLISH：每個 byte 經 Client::read() 讀進緩衝區，解 remaining length，
+// 把 topic 往前搬一格補 '\0' 後呼叫 callback。ESP8266 上每 byte 的 read 比 host 貴得多
+static void receivePublish(const std::vector<uint8_t>& wire, uint8_t* buffer, const MqttCallback& callback) {
+    WireReader reader{wire.data(), 0};
+    size_t n = 0;
+    buffer[n++] = (uint8_t)reader.read();
+    uint32_t remaining = 0;
+    uint32_t shift = 0;
+    uint8_t digit;
+    do {
+        digit = (uint8_t)reader.read();
+        buffer[n++] = digit;
+        remaining |= (uint32_t)(digit & 127) << shift;
+        shift += 7;
+    } while (digit & 128);
+    const size_t headerLen = n;
+    for (uint32_t i = 0; i < remaining; i++) buffer[n++] = (uint8_t)reader.read();
+
+    const uint16_t topicLen = (uint16_t)((buffer[headerLen] << 8) | buffer[headerLen + 1]);
+    memmove(buffer + headerLen + 1, buffer + headerLen + 2, topicLen);
+    buffer[headerLen + 1 + topicLen] = '\0';
+    callback((char*)buffer + headerLen + 1, buffer + headerLen + 2 + topicLen, remaining - 2 - topicLen);
+}
+
+// 最長的 collector 名稱、每筆都是最長 hostname 的 keyframe：依 topic 算出的預算塞滿後，整個封包仍放得進緩衝區
+void test_full_batch_fits_client_buffer() {
+    char topic[sizeof(MQTT_SENDER_TOPIC_PREFIX) + METRICS_BATCH_MAX_HOSTNAME + sizeof(MQTT_BATCH_TOPIC_SUFFIX)];
+    snprintf(topic, sizeof(topic), "%s%s%s", MQTT_SENDER_TOPIC_PREFIX, "collector-0123456789abcdefghijk",
+             MQTT_BATCH_TOPIC_SUFFIX);
+    TEST_ASSERT_TRUE(isValidBatchMetricsTopic(topic));
+
+    uint8_t buf[MQTT_MAX_PAYLOAD_BYTES];
+    MetricsBatchWriter writer(buf, mqttPublishPayloadBudget(topic));
+    const MetricsFrameV2 frame = exampleFrame();
+    char name[METRICS_BATCH_MAX_HOSTNAME + 1];
+    for (uint8_t i = 0; i < METRICS_BATCH_MAX_HOSTS; i++) {
+        snprintf(name, sizeof(name), "host-%02u-0123456789abcdefghijklm", (unsigned)i);
+        TEST_ASSERT_EQUAL_UINT32(METRICS_BATCH_MAX_HOSTNAME, strlen(name));
+        if (!writer.add(name, frame, METRICS_V3_ALL_FIELDS, METRICS_V3_FLAG_KEYFRAME, i, i)) break;
+    }
+    TEST_ASSERT_TRUE(writer.count() > 1);
+    TEST_ASSERT_TRUE(writer.count() < METRICS_BATCH_MAX_HOSTS);
+
+    const size_t len = writer.finish();
+    const std::vector<uint8_t> wire = publishPacket(topic, buf, len);
+    TEST_ASSERT_TRUE(wire.size() <= MQTT_MAX_PAYLOAD_BYTES);
+
+    // 下一筆加上去就會超過緩衝區
+    const size_t entry = 1 + METRICS_BATCH_MAX_HOSTNAME + metricsV3FrameBytes(METRICS_V3_ALL_FIELDS, METRICS_V3_FLAG_KEYFRAME) -
+                         METRICS_V3_CRC_BYTES;
+    TEST_ASSERT_TRUE(wire.size() + entry > MQTT_MAX_PAYLOAD_BYTES);
+
+    std::vector<Collected> got;
+    TEST_ASSERT_EQUAL_INT16(writer.count(), collect(buf, len, got));
+}
+
+struct Message {
+    char topic[64];
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> wire;
+};
+
+static Message makeMessage(const char* topic, const uint8_t* payload, size_t length) {
+    Message m;
+    snprintf(m.topic, sizeof(m.topic), "%s", topic);
+    m.payload.assign(payload, payload + length);
+    m.wire = publishPacket(topic, payload, length);
+    return m;
+}
+
+// handleMessage 的單台 topic 路徑與 batch 路徑，收到的 frame 交給同一種 sink
+template <uint8_t Hosts>
+static void handlePerTopic(BenchSink<Hosts>& sink, const char* topic, const uint8_t* payload, size_t length) {
+    if (!isValidSenderMetricsTopic(topic) || senderMetricsTopicVersion(topic) != METRICS_SCHEMA_V3) return;
+    char hostname[32];
+    MetricsFrameV2 frame;
+    MetricsV3Info info;
+    if (!extractHostnameFromSenderTopic(topic, hostname, sizeof(hostname))) return;
+    if (!decodeMetricsV3(payload, length, frame, &info)) return;
+    sink.apply(hostKey(hostname), frame, info);
+}
+
+template <uint8_t Hosts>
+static void handleBatch(BenchSink<Hosts>& sink, const char* topic, const uint8_t* payload, size_t length) {
+    if (!isValidBatchMetricsTopic(topic)) return;
+    forEachMetricsBatchEntry(payload, length,
+                             [&](const MetricsBatchEntry& entry) { sink.apply(entry.key, entry.frame, entry.info); });
+}
+
+// 同一串 frame 以每台一個 topic 與整批打包兩種方式送，結果必須相同。
+// 「解析」只量 callback 之後到寫入的成本；「含收包」再加上仿 PubSubClient 的逐 byte 讀取與 callback
+template <uint8_t Hosts>
+static void benchHosts() {
+    const int ticks = 100;
+    const int rounds = 100;
+    std::vector<Message> single;
+    std::vector<Message> batches;
+    MetricsV3DeltaEncoder encoders[Hosts];
+    MetricsFrameV2 frames[Hosts];
+    char names[Hosts][32];
+    for (uint8_t h = 0; h < Hosts; h++) snprintf(names[h], sizeof(names[h]), "host-%02u", (unsigned)h);
+
+    srand(Hosts);
+    uint8_t buf[MQTT_MAX_PAYLOAD_BYTES];
+    const char* batchTopic = "sys/agents/rack/metrics/batch";
+    const size_t budget = mqttPublishPayloadBudget(batchTopic);
+    for (int t = 0; t < ticks; t++) {
+        MetricsBatchWriter writer(buf, budget);
+        for (uint8_t h = 0; h < Hosts; h++) {
+            stepFrame(frames[h]);
+            char topic[sizeof(MQTT_SENDER_TOPIC_PREFIX) + sizeof(names[h]) + sizeof(MQTT_SENDER_TOPIC_SUFFIX_V3)];
+            snprintf(topic, sizeof(topic), "%s%.*s%s", MQTT_SENDER_TOPIC_PREFIX, (int)sizeof(names[h]) - 1, names[h],
+                     MQTT_SENDER_TOPIC_SUFFIX_V3);
+            uint8_t frameBuf[METRICS_V3_MAX_BYTES];
+            const size_t len = encoders[h].encode(frames[h], frameBuf, sizeof(frameBuf));
+            single.push_back(makeMessage(topic, frameBuf, len));
+
+            // collector 轉送同一個 frame；放不下時先送出目前這則
+            MetricsFrameV2 decoded;
+            MetricsV3Info info;
+            TEST_ASSERT_TRUE(decodeMetricsV3(frameBuf, len, decoded, &info));
+            if (!writer.add(names[h], decoded, info.present, info.flags, info.seq, info.keySeq)) {
+                const size_t batchLen = writer.finish();
+                batches.push_back(makeMessage(batchTopic, buf, batchLen));
+                writer = MetricsBatchWriter(buf, budget);
+                TEST_ASSERT_TRUE(writer.add(names[h], decoded, info.present, info.flags, info.seq, info.keySeq));
+            }
+        }
+        const size_t batchLen = writer.finish();
+        batches.push_back(makeMessage(batchTopic, buf, batchLen));
+    }
+
+    static BenchSink<Hosts> perTopic;
+    static BenchSink<Hosts> batched;
+    // 每則封包都要放得進 PubSubClient 的緩衝區，否則在裝置上根本收不到
+    for (const Message& m : single) TEST_ASSERT_TRUE(m.wire.size() <= MQTT_MAX_PAYLOAD_BYTES);
+    for (const Message& m : batches) TEST_ASSERT_TRUE(m.wire.size() <= MQTT_MAX_PAYLOAD_BYTES);
+    static uint8_t rx[MQTT_MAX_PAYLOAD_BYTES];
+    const MqttCallback perTopicCallback = [](char* topic, uint8_t* payload, unsigned int length) {
+        handlePerTopic(perTopic, topic, payload, length);
+    };
+    const MqttCallback batchCallback = [](char* topic, uint8_t* payload, unsigned int length) {
+        handleBatch(batched, topic, payload, length);
+    };
+
+    double ns[2][2];
+    const uint32_t expected = (uint32_t)rounds * ticks * Hosts;
+    for (int wire = 0; wire < 2; wire++) {
+        perTopic.begin();
+        batched.begin();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (const Message& m : single) {
+                if (wire) {
+                    receivePublish(m.wire, rx, perTopicCallback);
+                } else {
+                    handlePerTopic(perTopic, m.topic, m.payload.data(), m.payload.size());
+                }
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (const Message& m : batches) {
+                if (wire) {
+                    receivePublish(m.wire, rx, batchCallback);
+                } else {
+                    handleBatch(batched, m.topic, m.payload.data(), m.payload.size());
+                }
+            }
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        ns[wire][0] = std::chrono::duration<double, std::nano>(t1 - t0).count() / expected;
+        ns[wire][1] = std::chrono::duration<double, std::nano>(t2 - t1).count() / expected;
+
+        TEST_ASSERT_EQUAL_UINT32(expected, perTopic.applied);
+        TEST_ASSERT_EQUAL_UINT32(expected, batched.applied);
+        TEST_ASSERT_EQUAL_UINT32(perTopic.dirty, batched.dirty);
+        for (uint8_t h = 0; h < Hosts; h++) {
+            TEST_ASSERT_TRUE(sameFields(perTopic.shown[h], batched.shown[h]));
+            TEST_ASSERT_TRUE(sameFields(frames[h], batched.shown[h]));
+        }
+    }
+
+    size_t singleWire = 0;
+    size_t batchWire = 0;
+    for (const Message& m : single) singleWire += m.wire.size();
+    for (const Message& m : batches) batchWire += m.wire.size();
+    const double hostFrames = (double)ticks * Hosts;
+    printf("%2u hosts  per-topic: %5.1f ns/host parse, %5.1f ns/host with rx, %4.1f wire B/host, %u msgs/tick\n",
+           (unsigned)Hosts, ns[0][0], ns[1][0], singleWire / hostFrames, (unsigned)Hosts);
+    printf("%2u hosts  batch:     %5.1f ns/host parse, %5.1f ns/host with rx, %4.1f wire B/host, %.2f msgs/tick\n",
+           (unsigned)Hosts, ns[0][1], ns[1][1], batchWire / hostFrames, (double)batches.size() / ticks);
+}
+
+void test_bench_per_host_cost_8_hosts() {
+    benchHosts<8>();
+}
+
+void test_bench_per_host_cost_32_hosts() {
+    benchHosts<32>();
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_decodes_protocol_example);
+    RUN_TEST(test_random_batches_round_trip);
+    RUN_TEST(test_rejects_corrupted_batches);
+    RUN_TEST(test_writer_limits);
+    RUN_TEST(test_full_batch_fits_client_buffer);
+    RUN_TEST(test_bench_per_host_cost_8_hosts);
+    RUN_TEST(test_bench_per_host_cost_32_hosts);
+    return UNITY_END();
+}
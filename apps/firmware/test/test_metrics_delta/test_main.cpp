@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "metrics_delta.h"
+#include "../support/metrics_frames.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// docs/protocol/metrics-v3.md 的 delta 範例，與 sender 端 Python 測試共用同一組 bytes：
+// keySeq 7 之後的 seq 8，只有 cpu% 與 net rx 和 keyframe 不同
+static const uint8_t DOC_DELTA_EXAMPLE[] = {
+    0x32, 0x01, 0x04, 0x00, 0xF8, 0x14, 0x20, 0x08, 0x07, 0xAF, 0x01, 0x00, 0x08, 0xAB, 0x48,
+};
+
+// 舊 DeviceStore 的做法：整個 frame 不同時，逐群組比對每個欄位
+static uint16_t fullCompareDirty(const MetricsFrameV2& from, const MetricsFrameV2& to) {
+    uint16_t dirty = DIRTY_NONE;
+    if (memcmp(&from, &to, sizeof(MetricsFrameV2)) == 0) {
+        return dirty;
+    }
+    if (from.cpuPctX10 != to.cpuPctX10 || from.cpuTempCX10 != to.cpuTempCX10) {
+        dirty |= DIRTY_CPU;
+    }
+    if (from.ramPctX10 != to.ramPctX10 || from.ramUsedMB != to.ramUsedMB || from.ramTotalMB != to.ramTotalMB) {
+        dirty |= DIRTY_RAM;
+    }
+    if (from.gpuPctX10 != to.gpuPctX10 || from.gpuTempCX10 != to.gpuTempCX10 ||
+        from.gpuMemPctX10 != to.gpuMemPctX10 || from.gpuHotspotCX10 != to.gpuHotspotCX10 ||
+        from.gpuMemTempCX10 != to.gpuMemTempCX10) {
+        dirty |= DIRTY_GPU;
+    }
+    if (from.netRxKbps != to.netRxKbps || from.netTxKbps != to.netTxKbps) {
+        dirty |= DIRTY_NET;
+    }
+    if (from.diskReadKBps != to.diskReadKBps || from.diskWriteKBps != to.diskWriteKBps) {
+        dirty |= DIRTY_DISK;
+    }
+    return dirty;
+}
+
+// 接收端：解碼後交給 delta 狀態；解碼失敗也算需要 keyframe
+static MetricsDeltaResult receive(MetricsDeltaState& state, const uint8_t* buf, size_t len, MetricsFrameV2& out,
+                                  uint16_t& candidates) {
+    MetricsFrameV2 decoded;
+    MetricsV3Info info;
+    if (!decodeMetricsV3(buf, len, decoded, &info)) return DELTA_NEED_KEYFRAME;
+    return applyMetricsV3Frame(state, info, decoded, out, candidates);
+}
+
+// 模擬 sender：cpu / net 常變，gpu 偶爾變，ram / disk 很少變
+static void stepFrame(MetricsFrameV2& frame) {
+    frame.senderTsMs += 1000;
+    if (rand() % 4 != 0) frame.cpuPctX10 = (int16_t)(rand() % 1000);
+    if (rand() % 10 == 0) frame.cpuTempCX10 = (int16_t)(400 + rand() % 400);
+    if (rand() % 20 == 0) frame.ramUsedMB = (uint16_t)(8000 + rand() % 8000);
+    if (rand() % 5 == 0) frame.gpuPctX10 = (int16_t)(rand() % 1000);
+    if (rand() % 2 == 0) frame.netRxKbps = (uint16_t)rand();
+    if (rand() % 2 == 0) frame.netTxKbps = (uint16_t)rand();
+    if (rand() % 30 == 0) frame.diskWriteKBps = (uint16_t)(rand() % 4096);
+}
+
+void test_dirty_mask_for_fields() {
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_NONE, metricsDirtyMaskForFields(0));
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_CPU, metricsDirtyMaskForFields(1U << V3_CPU_TEMP));
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_RAM, metricsDirtyMaskForFields(1U << V3_RAM_TOTAL));
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_GPU, metricsDirtyMaskForFields(1U << V3_GPU_MEM_TEMP));
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_NET | DIRTY_DISK, metricsDirtyMaskForFields((1U << V3_NET_TX) | (1U << V3_DISK_READ)));
+    TEST_ASSERT_EQUAL_UINT16(DIRTY_CPU | DIRTY_RAM | DIRTY_GPU | DIRTY_NET | DIRTY_DISK,
+                             metricsDirtyMaskForFields(METRICS_V3_ALL_FIELDS));
+
+    // 只比對 candidates：不在 candidates 內的差異不回報
+    MetricsFrameV2 a = exampleFrame();
+    MetricsFrameV2 b = a;
+    b.cpuPctX10++;
+    b.diskWriteKBps++;
+    TEST_ASSERT_EQUAL_UINT16((1U << V3_CPU_PCT) | (1U << V3_DISK_WRITE), metricsDeltaFields(a, b));
+    TEST_ASSERT_EQUAL_UINT16(1U << V3_CPU_PCT, metricsChangedFields(a, b, METRICS_V3_CPU_FIELDS));
+}
+
+void test_encodes_delta_example_and_validates_flags() {
+    const MetricsFrameV2 keyframe = exampleFrame();
+    MetricsFrameV2 frame = keyframe;
+    frame.senderTsMs += 1000;
+    frame.cpuPctX10 = 431;
+    frame.netRxKbps = 2048;
+
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    const uint16_t present = metricsDeltaFields(keyframe, frame);
+    const size_t len = encodeMetricsV3(frame, present, buf, sizeof(buf), METRICS_V3_FLAG_DELTA, 8, 7);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(DOC_DELTA_EXAMPLE), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(DOC_DELTA_EXAMPLE, buf, len));
+
+    MetricsFrameV2 decoded;
+    MetricsV3Info info;
+    TEST_ASSERT_TRUE(decodeMetricsV3(buf, len, decoded, &info));
+    TEST_ASSERT_EQUAL_UINT8(METRICS_V3_FLAG_DELTA, info.flags);
+    TEST_ASSERT_EQUAL_UINT8(8, info.seq);
+    TEST_ASSERT_EQUAL_UINT8(7, info.keySeq);
+    TEST_ASSERT_EQUAL_UINT16(present, info.present);
+
+    // 沒有 info 的呼叫端（舊流程）不接受帶序號的 frame
+    TEST_ASSERT_FALSE(decodeMetricsV3(buf, len, decoded));
+
+    // keyframe 必須全送、keySeq 等於 seq；兩個旗標不能同時設
+    TEST_ASSERT_EQUAL_UINT32(0, encodeMetricsV3(frame, present, buf, sizeof(buf), METRICS_V3_FLAG_KEYFRAME, 1, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, encodeMetricsV3(frame, present, buf, sizeof(buf), 0x3, 1, 1));
+    TEST_ASSERT_EQUAL_UINT32(METRICS_V3_MAX_BYTES,
+                             encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(buf), METRICS_V3_FLAG_KEYFRAME, 9, 3));
+    TEST_ASSERT_EQUAL_UINT8(9, buf[8]);
+    TEST_ASSERT_TRUE(decodeMetricsV3(buf, METRICS_V3_MAX_BYTES, decoded, &info));
+    buf[8] = 3;
+    writeLe16(buf + METRICS_V3_MAX_BYTES - 2, metricsV3Crc(buf, METRICS_V3_MAX_BYTES - 2));
+    TEST_ASSERT_FALSE(decodeMetricsV3(buf, METRICS_V3_MAX_BYTES, decoded, &info));
+
+    // 任一 bit 翻轉都被拒絕
+    for (size_t bit = 0; bit < sizeof(DOC_DELTA_EXAMPLE) * 8; bit++) {
+        memcpy(buf, DOC_DELTA_EXAMPLE, sizeof(DOC_DELTA_EXAMPLE));
+        buf[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        TEST_ASSERT_FALSE(decodeMetricsV3(buf, sizeof(DOC_DELTA_EXAMPLE), decoded, &info));
+    }
+}
+
+// 無遺失時每個 frame 都完整重建，且由 candidates 得到的 dirty 與逐欄比對完全相同
+void test_stream_reconstructs_every_frame() {
+    srand(24);
+    MetricsV3DeltaEncoder encoder(10);
+    MetricsDeltaState state;
+    MetricsFrameV2 frame = exampleFrame();
+    MetricsFrameV2 shown;
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    size_t totalBytes = 0;
+    const int frames = 5000;
+
+    for (int i = 0; i < frames; i++) {
+        stepFrame(frame);
+        const size_t len = encoder.encode(frame, buf, sizeof(buf));
+        TEST_ASSERT_TRUE(len > 0);
+        TEST_ASSERT_EQUAL_UINT8(i % 10 == 0 ? 0x31 : 0x32, buf[0]);
+        totalBytes += len;
+
+        MetricsFrameV2 out;
+        uint16_t candidates = 0;
+        TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+        TEST_ASSERT_TRUE(sameFields(frame, out));
+        TEST_ASSERT_EQUAL_UINT16(fullCompareDirty(shown, out),
+                                 metricsDirtyMaskForFields(metricsChangedFields(shown, out, candidates)));
+        shown = out;
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, state.gapCount);
+    printf("keyframe every 10: %.1f B/frame avg (full frame %u B)\n", (double)totalBytes / frames,
+           (unsigned)metricsV3FrameBytes(METRICS_V3_ALL_FIELDS));
+}
+
+// 欄位在上一個 delta 改變、這次回到 keyframe 的值（不在 present 內）仍要標 dirty
+void test_field_reverting_to_keyframe_is_dirty() {
+    MetricsV3DeltaEncoder encoder(10);
+    MetricsDeltaState state;
+    MetricsFrameV2 frame = exampleFrame();
+    MetricsFrameV2 out;
+    uint16_t candidates = 0;
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+
+    size_t len = encoder.encode(frame, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+
+    frame.diskReadKBps = 9999;
+    len = encoder.encode(frame, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+    TEST_ASSERT_EQUAL_UINT16(1U << V3_DISK_READ, candidates);
+
+    frame.diskReadKBps = exampleFrame().diskReadKBps;
+    len = encoder.encode(frame, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT32(metricsV3FrameBytes(0, METRICS_V3_FLAG_DELTA), len);
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+    TEST_ASSERT_EQUAL_UINT16(1U << V3_DISK_READ, candidates);
+    TEST_ASSERT_EQUAL_UINT16(2048, out.diskReadKBps);
+
+    // 再下一個沒有任何變化：沒有 candidates
+    len = encoder.encode(frame, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+    TEST_ASSERT_EQUAL_UINT16(0, candidates);
+}
+
+// 掉 delta 只記一次 gap，下一個 delta 仍相對 keyframe 正確重建
+void test_lost_delta_counts_gap_and_keeps_applying() {
+    srand(5);
+    MetricsV3DeltaEncoder encoder(8);
+    MetricsDeltaState state;
+    MetricsFrameV2 frame = exampleFrame();
+    MetricsFrameV2 shown;
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    uint16_t dropped = 0;
+
+    for (int i = 0; i < 2000; i++) {
+        stepFrame(frame);
+        const size_t len = encoder.encode(frame, buf, sizeof(buf));
+        if (i % 8 != 0 && i % 5 == 0) {
+            dropped++;
+            continue;
+        }
+        MetricsFrameV2 out;
+        uint16_t candidates = 0;
+        TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+        TEST_ASSERT_TRUE(sameFields(frame, out));
+        TEST_ASSERT_EQUAL_UINT16(fullCompareDirty(shown, out),
+                                 metricsDirtyMaskForFields(metricsChangedFields(shown, out, candidates)));
+        shown = out;
+    }
+    TEST_ASSERT_EQUAL_UINT16(dropped, state.gapCount);
+}
+
+// 掉 keyframe 後的 delta 一律丟掉，直到下一個 keyframe；期間不會產生錯誤的 frame
+void test_lost_keyframe_waits_for_next_keyframe() {
+    srand(11);
+    MetricsV3DeltaEncoder encoder(6);
+    MetricsDeltaState state;
+    MetricsFrameV2 frame = exampleFrame();
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    MetricsFrameV2 out;
+    uint16_t candidates = 0;
+
+    for (int i = 0; i < 60; i++) {
+        stepFrame(frame);
+        const size_t len = encoder.encode(frame, buf, sizeof(buf));
+        const int phase = i % 6;
+        const bool keyframeLost = (i / 6) % 3 == 1;
+        if (phase == 0 && keyframeLost) continue;
+
+        const MetricsDeltaResult result = receive(state, buf, len, out, candidates);
+        if (keyframeLost) {
+            TEST_ASSERT_EQUAL_UINT8(DELTA_NEED_KEYFRAME, result);
+            TEST_ASSERT_FALSE(state.synced);
+        } else {
+            TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, result);
+            TEST_ASSERT_TRUE(sameFields(frame, out));
+        }
+    }
+}
+
+void test_delta_before_keyframe_and_plain_frames() {
+    const MetricsFrameV2 frame = exampleFrame();
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    MetricsDeltaState state;
+    MetricsFrameV2 out;
+    uint16_t candidates = 0;
+
+    // 開機後第一個收到的是 delta
+    TEST_ASSERT_EQUAL_UINT8(DELTA_NEED_KEYFRAME,
+                            receive(state, DOC_DELTA_EXAMPLE, sizeof(DOC_DELTA_EXAMPLE), out, candidates));
+
+    size_t len = encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(buf), METRICS_V3_FLAG_KEYFRAME, 7, 7);
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+    TEST_ASSERT_EQUAL_UINT16(METRICS_V3_ALL_FIELDS, candidates);
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED,
+                            receive(state, DOC_DELTA_EXAMPLE, sizeof(DOC_DELTA_EXAMPLE), out, candidates));
+    TEST_ASSERT_EQUAL_INT16(431, out.cpuPctX10);
+    TEST_ASSERT_EQUAL_UINT16(2048, out.netRxKbps);
+    TEST_ASSERT_EQUAL_UINT16(12288, out.ramUsedMB);
+    TEST_ASSERT_EQUAL_UINT8(METRICS_SCHEMA_V3, out.version);
+
+    // 一般 frame 結束 delta 序列，之後的 delta 要等新的 keyframe
+    len = encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(DELTA_APPLIED, receive(state, buf, len, out, candidates));
+    TEST_ASSERT_EQUAL_UINT16(METRICS_V3_ALL_FIELDS, candidates);
+    TEST_ASSERT_EQUAL_UINT8(DELTA_NEED_KEYFRAME,
+                            receive(state, DOC_DELTA_EXAMPLE, sizeof(DOC_DELTA_EXAMPLE), out, candidates));
+
+    // interval <= 1 的 encoder 只送一般 frame
+    MetricsV3DeltaEncoder plain(1);
+    TEST_ASSERT_EQUAL_UINT32(37, plain.encode(frame, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_UINT8(0x30, buf[0]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_dirty_mask_for_fields);
+    RUN_TEST(test_encodes_delta_example_and_validates_flags);
+    RUN_TEST(test_stream_reconstructs_every_frame);
+    RUN_TEST(test_field_reverting_to_keyframe_is_dirty);
+    RUN_TEST(test_lost_delta_counts_gap_and_keeps_applying);
+    RUN_TEST(test_lost_keyframe_waits_for_next_keyframe);
+    RUN_TEST(test_delta_before_keyframe_and_plain_frames);
+    return UNITY_END();
+}
@@ -0,0 +1,629 @@
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+#include <utility>
+#include <vector>
+
+#include "metrics_v2_stream.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// ---- 參考實作：舊的 ArduinoJson + float 流程 ----
+// native 環境沒有 ArduinoJson，這裡用一個小型 DOM 解析器重現它的語意：
+// 完整建樹、巢狀上限 10、as<float>() 後 lroundf 再夾範圍。
+struct RefNode {
+    enum Type { NUL, BOOL, INT, FLOAT, STR, ARR, OBJ } type = NUL;
+    bool b = false;
+    long long i = 0;
+    double d = 0;
+    std::string s;
+    bool escaped = false;
+    std::vector<RefNode> items;
+    std::vector<std::pair<std::string, RefNode>> members;
+
+    float asFloat() const {
+        if (type == BOOL) return b ? 1.0f : 0.0f;
+        if (type == INT) return (float)i;
+        if (type == FLOAT) return (float)d;
+        if (type == STR) return stringAsFloat();
+        return 0.0f;
+    }
+
+    // ArduinoJson 的 parseNumber：整段是數字才轉換，否則為 0
+    float stringAsFloat() const;
+
+    const RefNode* get(const char* key) const {
+        for (const auto& m : members) {
+            if (m.first == key) return &m.second;
+        }
+        return nullptr;
+    }
+};
+
+class RefParser {
+public:
+    RefParser(const uint8_t* data, size_t length) : _p((const char*)data), _end((const char*)data + length) {}
+
+    bool parse(RefNode& root) {
+        ws();
+        return value(root, 10);
+    }
+
+    bool parseWholeNumber(RefNode& node) { return number(node) && _p == _end; }
+
+private:
+    const char* _p;
+    const char* _end;
+
+    void ws() {
+        while (_p < _end && strchr(" \t\n\r", *_p) && *_p) _p++;
+    }
+
+    bool lit(const char* s) {
+        const size_t n = strlen(s);
+        if ((size_t)(_end - _p) < n || strncmp(_p, s, n) != 0) return false;
+        _p += n;
+        return true;
+    }
+
+    bool digit() const { return _p < _end && *_p >= '0' && *_p <= '9'; }
+
+    bool value(RefNode& node, int nesting) {
+        if (_p >= _end) return false;
+        const char c = *_p;
+        if (c == '{' || c == '[') {
+            if (nesting <= 0) return false;
+            _p++;
+            node.type = c == '{' ? RefNode::OBJ : RefNode::ARR;
+            ws();
+            if (lit(c == '{' ? "}" : "]")) return true;
+            while (true) {
+                RefNode child;
+                std::string key;
+                if (c == '{') {
+                    if (!str(key)) return false;
+                    ws();
+                    if (!lit(":")) return false;
+                    ws();
+                }
+                if (!value(child, nesting - 1)) return false;
+                if (c == '{') {
+                    node.members.emplace_back(key, child);
+                } else {
+                    node.items.push_back(child);
+                }
+                ws();
+                if (lit(",")) {
+                    ws();
+                    continue;
+                }
+                return lit(c == '{' ? "}" : "]");
+            }
+        }
+        if (c == '"') {
+            node.type = RefNode::STR;
+            return str(node.s, &node.escaped);
+        }
+        if (lit("null")) return true;
+        if (lit("true") || lit("false")) {
+            node.type = RefNode::BOOL;
+            node.b = _p[-1] == 'e' && _p[-2] == 'u';
+            return true;
+        }
+        return number(node);
+    }
+
+    bool str(std::string& out, bool* escaped = nullptr) {
+        if (!lit("\"")) return false;
+        while (_p < _end) {
+            const char c = *_p++;
+            if (c == '"') return true;
+            if ((uint8_t)c < 0x20) return false;
+            if (c == '\\') {
+                if (escaped) *escaped = true;
+                if (_p >= _end) return false;
+                const char e = *_p++;
+                if (e == 'u') {
+                    for (int i = 0; i < 4; i++) {
+                        if (_p >= _end || !isxdigit((unsigned char)*_p++)) return false;
+                    }
+                } else if (!e || !strchr("\"\\/bfnrt", e)) {
+                    return false;
+                }
+            }
+            out.push_back(c);
+        }
+        return false;
+    }
+
+    bool number(RefNode& node) {
+        const char* start = _p;
+        bool integral = true;
+        lit("-");
+        if (!digit()) return false;
+        if (*_p == '0') {
+            _p++;
+        } else {
+            while (digit()) _p++;
+        }
+        if (lit(".")) {
+            integral = false;
+            if (!digit()) return false;
+            while (digit()) _p++;
+        }
+        if (_p < _end && (*_p == 'e' || *_p == 'E')) {
+            _p++;
+            integral = false;
+            if (_p < _end && (*_p == '+' || *_p == '-')) _p++;
+            if (!digit()) return false;
+            while (digit()) _p++;
+        }
+        const std::string token(start, _p);
+        // ArduinoJson 把放得進 int64 的整數存成整數，其他存成浮點數
+        if (integral && token.size() < 19) {
+            node.type = RefNode::INT;
+            node.i = strtoll(token.c_str(), nullptr, 10);
+        } else {
+            node.type = RefNode::FLOAT;
+            node.d = strtod(token.c_str(), nullptr);
+        }
+        return true;
+    }
+};
+
+// 跳脫字元還原後才可能是數字，送出端不會這樣寫，這裡只當成非數字
+float RefNode::stringAsFloat() const {
+    RefNode number;
+    RefParser parser((const uint8_t*)s.data(), s.size());
+    if (escaped || !parser.parseWholeNumber(number)) return 0.0f;
+    return number.asFloat();
+}
+
+static bool refParse(const uint8_t* payload, size_t length, MetricsFrameV2& frame) {
+    RefNode doc;
+    RefParser parser(payload, length);
+    if (!parser.parse(doc) || doc.type != RefNode::OBJ) return false;
+    const RefNode* v = doc.get("v");
+    if (!v || v->type != RefNode::INT || v->i != METRICS_SCHEMA_V2) return false;
+    frame.version = METRICS_SCHEMA_V2;
+
+    struct Field {
+        const char* key;
+        uint8_t index;
+        int16_t* x10;
+        uint16_t* u16;
+    };
+    const Field fields[] = {
+        {"cpu", 0, &frame.cpuPctX10, nullptr},       {"cpu", 1, &frame.cpuTempCX10, nullptr},
+        {"ram", 0, &frame.ramPctX10, nullptr},       {"ram", 1, nullptr, &frame.ramUsedMB},
+        {"ram", 2, nullptr, &frame.ramTotalMB},      {"gpu", 0, &frame.gpuPctX10, nullptr},
+        {"gpu", 1, &frame.gpuTempCX10, nullptr},     {"gpu", 2, &frame.gpuMemPctX10, nullptr},
+        {"gpu", 3, &frame.gpuHotspotCX10, nullptr},  {"gpu", 4, &frame.gpuMemTempCX10, nullptr},
+        {"net", 0, nullptr, &frame.netRxKbps},       {"net", 1, nullptr, &frame.netTxKbps},
+        {"disk", 0, nullptr, &frame.diskReadKBps},   {"disk", 1, nullptr, &frame.diskWriteKBps},
+    };
+    for (const Field& f : fields) {
+        const RefNode* arr = doc.get(f.key);
+        if (!arr || arr->type != RefNode::ARR || arr->items.size() <= f.index) continue;
+        const RefNode& item = arr->items[f.index];
+        if (item.type == RefNode::NUL) continue;
+        const float value = item.asFloat();
+        if (f.x10) *f.x10 = clampI16(scaleX10(value));
+        if (f.u16) *f.u16 = clampU16(lroundf(value));
+    }
+    return true;
+}
+
+// ---- 共用工具 ----
+
+static bool streamParse(const char* json, MetricsFrameV2& frame) {
+    return parseMetricsV2Stream((const uint8_t*)json, strlen(json), frame);
+}
+
+static void assertFramesEqual(const MetricsFrameV2& a, const MetricsFrameV2& b, const char* payload) {
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.cpuPctX10, b.cpuPctX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.cpuTempCX10, b.cpuTempCX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.ramPctX10, b.ramPctX10, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.ramUsedMB, b.ramUsedMB, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.ramTotalMB, b.ramTotalMB, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.gpuPctX10, b.gpuPctX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.gpuTempCX10, b.gpuTempCX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.gpuMemPctX10, b.gpuMemPctX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.gpuHotspotCX10, b.gpuHotspotCX10, payload);
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(a.gpuMemTempCX10, b.gpuMemTempCX10, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.netRxKbps, b.netRxKbps, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.netTxKbps, b.netTxKbps, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.diskReadKBps, b.diskReadKBps, payload);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(a.diskWriteKBps, b.diskWriteKBps, payload);
+}
+
+static const char* DOC_EXAMPLE =
+    "{\n"
+    "  \"v\": 2,\n"
+    "  \"ts\": 1739999999000,\n"
+    "  \"h\": \"desk\",\n"
+    "  \"cpu\": [42.4, 58.2],\n"
+    "  \"ram\": [67.8, 12288, 32768],\n"
+    "  \"gpu\": [15.0, 52.0, 12.5, 0.0, 0.0],\n"
+    "  \"net\": [1024, 512],\n"
+    "  \"disk\": [2048, 1024]\n"
+    "}";
+
+// ---- 基本案例 ----
+
+void test_parses_protocol_example() {
+    MetricsFrameV2 frame;
+    TEST_ASSERT_TRUE(streamParse(DOC_EXAMPLE, frame));
+    TEST_ASSERT_EQUAL_UINT8(2, frame.version);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(1739999999000ULL & 0xFFFFFFFFUL), frame.senderTsMs);
+    TEST_ASSERT_EQUAL_INT16(424, frame.cpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(582, frame.cpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(678, frame.ramPctX10);
+    TEST_ASSERT_EQUAL_UINT16(12288, frame.ramUsedMB);
+    TEST_ASSERT_EQUAL_UINT16(32768, frame.ramTotalMB);
+    TEST_ASSERT_EQUAL_INT16(150, frame.gpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(520, frame.gpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(125, frame.gpuMemPctX10);
+    TEST_ASSERT_EQUAL_INT16(0, frame.gpuHotspotCX10);
+    TEST_ASSERT_EQUAL_UINT16(1024, frame.netRxKbps);
+    TEST_ASSERT_EQUAL_UINT16(512, frame.netTxKbps);
+    TEST_ASSERT_EQUAL_UINT16(2048, frame.diskReadKBps);
+    TEST_ASSERT_EQUAL_UINT16(1024, frame.diskWriteKBps);
+
+    MetricsFrameV2 ref;
+    TEST_ASSERT_TRUE(refParse((const uint8_t*)DOC_EXAMPLE, strlen(DOC_EXAMPLE), ref));
+    assertFramesEqual(ref, frame, DOC_EXAMPLE);
+}
+
+void test_nulls_short_arrays_and_non_numbers() {
+    MetricsFrameV2 frame;
+    frame.cpuTempCX10 = 123;
+    frame.ramTotalMB = 777;
+    frame.gpuMemTempCX10 = 55;
+    TEST_ASSERT_TRUE(streamParse(
+        "{\"v\":2,\"cpu\":[\"12.3\",null],\"ram\":[1,\"x\"],\"gpu\":[true,false,{\"a\":[1]},[2]],"
+        "\"net\":{\"rx\":1},\"disk\":[-5,70000.4,9]}",
+        frame));
+    TEST_ASSERT_EQUAL_INT16(123, frame.cpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(123, frame.cpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(10, frame.ramPctX10);
+    TEST_ASSERT_EQUAL_UINT16(0, frame.ramUsedMB);
+    TEST_ASSERT_EQUAL_UINT16(777, frame.ramTotalMB);
+    TEST_ASSERT_EQUAL_INT16(10, frame.gpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(0, frame.gpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(0, frame.gpuMemPctX10);
+    TEST_ASSERT_EQUAL_INT16(0, frame.gpuHotspotCX10);
+    TEST_ASSERT_EQUAL_INT16(55, frame.gpuMemTempCX10);
+    TEST_ASSERT_EQUAL_UINT16(0, frame.netRxKbps);
+    TEST_ASSERT_EQUAL_UINT16(0, frame.diskReadKBps);
+    TEST_ASSERT_EQUAL_UINT16(65535, frame.diskWriteKBps);
+}
+
+void test_rounding_and_saturation() {
+    MetricsFrameV2 frame;
+    TEST_ASSERT_TRUE(streamParse(
+        "{\"v\":2,\"cpu\":[0.05,-0.05],\"gpu\":[1e30,-1e30,4.25e1,0.00000000000000000000001,-3276.85],"
+        "\"net\":[2.5,1e-400]}",
+        frame));
+    TEST_ASSERT_EQUAL_INT16(1, frame.cpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(-1, frame.cpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(32767, frame.gpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(-32768, frame.gpuTempCX10);
+    TEST_ASSERT_EQUAL_INT16(425, frame.gpuMemPctX10);
+    TEST_ASSERT_EQUAL_INT16(0, frame.gpuHotspotCX10);
+    TEST_ASSERT_EQUAL_INT16(-32768, frame.gpuMemTempCX10);
+    TEST_ASSERT_EQUAL_UINT16(3, frame.netRxKbps);
+    TEST_ASSERT_EQUAL_UINT16(0, frame.netTxKbps);
+
+    // 超過 19 位有效數字的尾數
+    TEST_ASSERT_TRUE(streamParse("{\"v\":2,\"ram\":[12.3456789012345678901234,1234567890123456789012e-18]}", frame));
+    TEST_ASSERT_EQUAL_INT16(123, frame.ramPctX10);
+    TEST_ASSERT_EQUAL_UINT16(1235, frame.ramUsedMB);
+}
+
+void test_rejects_bad_version_and_syntax() {
+    const char* rejected[] = {
+        "",
+        "   ",
+        "[]",
+        "{}",
+        "2",
+        "{\"v\":3}",
+        "{\"v\":2.0}",
+        "{\"v\":\"2\"}",
+        "{\"v\":null}",
+        "{\"cpu\":[1,2]}",
+        "{\"v\":2,}",
+        "{\"v\":2",
+        "{\"v\":2,\"cpu\":[1,2}",
+        "{\"v\":2,\"cpu\":[01]}",
+        "{\"v\":2,\"cpu\":[1.]}",
+        "{\"v\":2,\"cpu\":[-]}",
+        "{\"v\":2,\"cpu\":[1e]}",
+        "{\"v\":2,\"cpu\":[nul]}",
+        "{\"v\":2,\"h\":\"a\\qb\"}",
+        "{\"v\":2,\"h\":\"a\\u12\"}",
+        "{\"v\":2,\"h\":\"tab\there\"}",
+        "{v:2}",
+    };
+    for (const char* json : rejected) {
+        MetricsFrameV2 frame;
+        TEST_ASSERT_FALSE_MESSAGE(streamParse(json, frame), json);
+        TEST_ASSERT_FALSE_MESSAGE(refParse((const uint8_t*)json, strlen(json), frame), json);
+    }
+
+    MetricsFrameV2 frame;
+    TEST_ASSERT_TRUE(streamParse(" {\"h\":\"\\\"d\\u00e9sk\\\"\",\"x\":{\"y\":[true,false,null,\"]\"]},\"v\":2} trailing", frame));
+}
+
+// 最外層 object 算一層，總共最多 10 層
+void test_nesting_limit() {
+    std::string ok = "{\"v\":2,\"x\":";
+    std::string tooDeep = ok;
+    for (int i = 0; i < 9; i++) ok += "[";
+    for (int i = 0; i < 9; i++) ok += "]";
+    ok += "}";
+    for (int i = 0; i < 10; i++) tooDeep += "[";
+    for (int i = 0; i < 10; i++) tooDeep += "]";
+    tooDeep += "}";
+
+    MetricsFrameV2 frame;
+    TEST_ASSERT_TRUE(streamParse(ok.c_str(), frame));
+    TEST_ASSERT_TRUE(refParse((const uint8_t*)ok.data(), ok.size(), frame));
+    TEST_ASSERT_FALSE(streamParse(tooDeep.c_str(), frame));
+    TEST_ASSERT_FALSE(refParse((const uint8_t*)tooDeep.data(), tooDeep.size(), frame));
+}
+
+// 只讀 length 個 bytes：緩衝區後面接著的內容不影響結果
+void test_reads_only_length_bytes() {
+    const char buffer[] = "{\"v\":2,\"cpu\":[42]}5]}";
+    MetricsFrameV2 frame;
+    TEST_ASSERT_TRUE(parseMetricsV2Stream((const uint8_t*)buffer, 18, frame));
+    TEST_ASSERT_EQUAL_INT16(420, frame.cpuPctX10);
+
+    const char cut[] = "{\"v\":2,\"cpu\":[425]}";
+    TEST_ASSERT_FALSE(parseMetricsV2Stream((const uint8_t*)cut, 16, frame));
+    TEST_ASSERT_FALSE(parseMetricsV2Stream(nullptr, 0, frame));
+}
+
+// ---- 隨機等價測試 ----
+
+static uint32_t rng = 1;
+
+static uint32_t nextRand() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static void appendWs(std::string& out) {
+    static const char* ws[] = {"", "", "", " ", "\n  ", "\t", "\r\n"};
+    out += ws[nextRand() % 7];
+}
+
+// units 為 10^decimals 倍的整數；用不同的寫法輸出同一個值
+static void appendNumber(std::string& out, long units, int decimals) {
+    char buf[48];
+    const bool negative = units < 0;
+    const unsigned long mag = (unsigned long)(negative ? -units : units);
+    unsigned long scale = 1;
+    for (int i = 0; i < decimals; i++) scale *= 10;
+    const char* sign = negative ? "-" : "";
+
+    switch (nextRand() % 4) {
+        case 0:
+            if (decimals == 0) {
+                snprintf(buf, sizeof(buf), "%s%lu", sign, mag);
+            } else {
+                snprintf(buf, sizeof(buf), "%s%lu.%0*lu", sign, mag / scale, decimals, mag % scale);
+            }
+            break;
+        case 1:  // 小數尾端補零
+            if (decimals == 0) {
+                snprintf(buf, sizeof(buf), "%s%lu.000", sign, mag);
+            } else {
+                snprintf(buf, sizeof(buf), "%s%lu.%0*lu00", sign, mag / scale, decimals, mag % scale);
+            }
+            break;
+        case 2:  // 整數尾數加負指數
+            snprintf(buf, sizeof(buf), "%s%lue-%d", sign, mag, decimals);
+            break;
+        default:  // 尾數多一個 0，指數再減一
+            snprintf(buf, sizeof(buf), "%s%lu0E-%d", sign, mag, decimals + 1);
+            break;
+    }
+    out += buf;
+}
+
+// float 在同值附近不會剛好落在 .5 上，舊流程與新流程的結果才一定相同；
+// 產生的值避開 x.x5（x10 欄位）與 x.5（u16 欄位）這種剛好的中點
+static void appendX10Value(std::string& out) {
+    const int decimals = (int)(nextRand() % 3);
+    long units;
+    do {
+        units = (long)(nextRand() % 8000000) - 4000000;
+        for (int i = decimals; i < 3; i++) units /= 10;
+    } while (decimals == 2 && labs(units) % 10 == 5);
+    appendNumber(out, units, decimals);
+}
+
+static void appendU16Value(std::string& out) {
+    const int decimals = (int)(nextRand() % 2);
+    long units;
+    do {
+        units = (long)(nextRand() % 1400000) - 400000;
+        if (decimals == 0) units /= 10;
+    } while (decimals == 1 && labs(units) % 10 == 5);
+    appendNumber(out, units, decimals);
+}
+
+static void appendArray(std::string& out, const char* kinds) {
+    out += "[";
+    const size_t n = strlen(kinds);
+    size_t count = n;
+    if (nextRand() % 10 == 0) count = nextRand() % (n + 1);
+    for (size_t i = 0; i < count + (nextRand() % 10 == 0 ? 1 : 0); i++) {
+        if (i) out += ",";
+        appendWs(out);
+        const uint32_t special = nextRand() % 20;
+        if (special == 0) {
+            out += "null";
+        } else if (special == 1) {
+            out += nextRand() % 2 ? "\"n/a\"" : "\"-12.5e1\"";
+        } else if (i < n && kinds[i] == 'x') {
+            appendX10Value(out);
+        } else {
+            appendU16Value(out);
+        }
+        appendWs(out);
+    }
+    out += "]";
+}
+
+static std::string randomPayload() {
+    static const char* keys[] = {"v", "ts", "h", "cpu", "ram", "gpu", "net", "disk", "extra", "cpu_"};
+    uint8_t order[10];
+    for (uint8_t i = 0; i < 10; i++) order[i] = i;
+    for (uint8_t i = 9; i > 0; i--) {
+        const uint8_t j = (uint8_t)(nextRand() % (i + 1));
+        const uint8_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    std::string out = "{";
+    bool first = true;
+    for (uint8_t k : order) {
+        if (k >= 8 && nextRand() % 2) continue;
+        if (!first) out += ",";
+        first = false;
+        appendWs(out);
+        out += "\"";
+        out += keys[k];
+        out += "\"";
+        appendWs(out);
+        out += ":";
+        appendWs(out);
+        switch (k) {
+            case 0: out += nextRand() % 50 ? "2" : "3"; break;
+            case 1: out += "1739999999000"; break;
+            case 2: out += "\"desk-\\u0041\\\"\""; break;
+            case 3: appendArray(out, "xx"); break;
+            case 4: appendArray(out, "xuu"); break;
+            case 5: appendArray(out, "xxxxx"); break;
+            case 6: appendArray(out, "uu"); break;
+            case 7: appendArray(out, "uu"); break;
+            case 8: out += "{\"a\":[1,{\"b\":null}],\"c\":true}"; break;
+            default: appendArray(out, "xx"); break;
+        }
+        appendWs(out);
+    }
+    out += "}";
+    return out;
+}
+
+static void checkAgainstReference(const std::string& payload) {
+    // 複製到剛好大小的緩衝區，越界讀取在 sanitizer 下會被抓到
+    std::vector<uint8_t> buf(payload.begin(), payload.end());
+    MetricsFrameV2 expected;
+    MetricsFrameV2 actual;
+    const bool refOk = refParse(buf.data(), buf.size(), expected);
+    const bool ok = parseMetricsV2Stream(buf.data(), buf.size(), actual);
+    TEST_ASSERT_EQUAL_MESSAGE(refOk, ok, payload.c_str());
+    if (refOk) assertFramesEqual(expected, actual, payload.c_str());
+}
+
+void test_random_payloads_match_reference() {
+    rng = 12345;
+    uint32_t accepted = 0;
+    for (int i = 0; i < 20000; i++) {
+        const std::string payload = randomPayload();
+        checkAgainstReference(payload);
+        MetricsFrameV2 frame;
+        if (parseMetricsV2Stream((const uint8_t*)payload.data(), payload.size(), frame)) accepted++;
+    }
+    // 大部分是合法的 v2 payload
+    TEST_ASSERT_GREATER_THAN_UINT32(18000, accepted);
+}
+
+// 隨機改字、刪字、插字與截斷：不當機，且接受/拒絕與參考實作一致
+void test_mutated_payloads_accept_and_reject_like_reference() {
+    static const char alphabet[] = "{}[]\",:.-+eE0123456789 \\ntrufalsv";
+    rng = 777;
+    uint32_t accepted = 0;
+    for (int i = 0; i < 20000; i++) {
+        std::string payload = randomPayload();
+        const uint32_t edits = 1 + nextRand() % 3;
+        for (uint32_t e = 0; e < edits && !payload.empty(); e++) {
+            const size_t pos = nextRand() % payload.size();
+            const char c = alphabet[nextRand() % (sizeof(alphabet) - 1)];
+            switch (nextRand() % 4) {
+                case 0: payload[pos] = c; break;
+                case 1: payload.erase(pos, 1); break;
+                case 2: payload.insert(pos, 1, c); break;
+                default: payload.resize(pos); break;
+            }
+        }
+
+        std::vector<uint8_t> buf(payload.begin(), payload.end());
+        MetricsFrameV2 expected;
+        MetricsFrameV2 actual;
+        const bool refOk = refParse(buf.data(), buf.size(), expected);
+        const bool ok = parseMetricsV2Stream(buf.data(), buf.size(), actual);
+        TEST_ASSERT_EQUAL_MESSAGE(refOk, ok, payload.c_str());
+        if (ok) accepted++;
+    }
+    printf("mutated payloads still accepted: %u / 20000\n", accepted);
+}
+
+void test_bench_messages_per_second() {
+    rng = 99;
+    std::vector<std::string> payloads;
+    payloads.push_back(DOC_EXAMPLE);
+    payloads.push_back("{\"v\":2,\"ts\":1739999999000,\"h\":\"desk\",\"cpu\":[42.4,58.2],\"ram\":[67.8,12288,32768],"
+                       "\"gpu\":[15.0,52.0,12.5,0.0,0.0],\"net\":[1024,512],\"disk\":[2048,1024]}");
+    for (int i = 0; i < 30; i++) payloads.push_back(randomPayload());
+
+    const uint32_t messages = 300000;
+    volatile int32_t sink = 0;
+    MetricsFrameV2 frame;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t m = 0; m < messages; m++) {
+        const std::string& p = payloads[m % payloads.size()];
+        sink += parseMetricsV2Stream((const uint8_t*)p.data(), p.size(), frame) ? frame.cpuPctX10 : 0;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t m = 0; m < messages / 10; m++) {
+        const std::string& p = payloads[m % payloads.size()];
+        sink += refParse((const uint8_t*)p.data(), p.size(), frame) ? frame.cpuPctX10 : 0;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    const double streamSec = std::chrono::duration<double>(t1 - t0).count();
+    const double refSec = std::chrono::duration<double>(t2 - t1).count();
+    printf("stream parser: %10.0f msgs/s   DOM + float reference: %10.0f msgs/s\n",
+           messages / streamSec, (messages / 10) / refSec);
+    (void)sink;
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_parses_protocol_example);
+    RUN_TEST(test_nulls_short_arrays_and_non_numbers);
+    RUN_TEST(test_rounding_and_saturation);
+    RUN_TEST(test_rejects_bad_version_and_syntax);
+    RUN_TEST(test_nesting_limit);
+    RUN_TEST(test_reads_only_length_bytes);
+    RUN_TEST(test_random_payloads_match_reference);
+    RUN_TEST(test_mutated_payloads_accept_and_reject_like_reference);
+    RUN_TEST(test_bench_messages_per_second);
+    return UNITY_END();
+}
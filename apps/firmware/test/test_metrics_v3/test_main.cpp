@@ -0,0 +1,138 @@
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "metrics_v2_stream.h"
+#include "metrics_v3.h"
+#include "../support/metrics_frames.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// docs/protocol/metrics-v3.md 的範例，與 sender 端 Python 測試共用同一組 bytes
+static const uint8_t DOC_EXAMPLE[] = {
+    0x30, 0xFF, 0x3F, 0x18, 0xF4, 0x14, 0x20, 0xA8, 0x01, 0x46, 0x02, 0xA6, 0x02, 0x00, 0x30, 0x00, 0x80, 0x96, 0x00,
+    0x08, 0x02, 0x7D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x08, 0x00, 0x04, 0x31, 0x79,
+};
+
+void test_encodes_protocol_example() {
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    const MetricsFrameV2 frame = exampleFrame();
+    TEST_ASSERT_EQUAL_UINT32(37, metricsV3FrameBytes(METRICS_V3_ALL_FIELDS));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(DOC_EXAMPLE), encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(DOC_EXAMPLE, buf, sizeof(DOC_EXAMPLE)));
+
+    MetricsFrameV2 decoded;
+    TEST_ASSERT_TRUE(decodeMetricsV3(DOC_EXAMPLE, sizeof(DOC_EXAMPLE), decoded));
+    TEST_ASSERT_EQUAL_UINT8(METRICS_SCHEMA_V3, decoded.version);
+    assertFieldsEqual(frame, decoded);
+}
+
+void test_random_frames_round_trip() {
+    srand(3);
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    for (int round = 0; round < 5000; round++) {
+        MetricsFrameV2 frame;
+        frame.senderTsMs = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        uint8_t* fields = metricsV3FieldBytes(frame);
+        for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT * 2; i++) fields[i] = (uint8_t)rand();
+        const uint16_t present = round % 4 == 0 ? METRICS_V3_ALL_FIELDS : (uint16_t)(rand() & METRICS_V3_ALL_FIELDS);
+
+        const size_t len = encodeMetricsV3(frame, present, buf, sizeof(buf));
+        TEST_ASSERT_EQUAL_UINT32(metricsV3FrameBytes(present), len);
+
+        MetricsFrameV2 decoded;
+        TEST_ASSERT_TRUE(decodeMetricsV3(buf, len, decoded));
+        TEST_ASSERT_EQUAL_UINT32(frame.senderTsMs, decoded.senderTsMs);
+
+        // 沒送的欄位保持新 frame 的 0
+        MetricsFrameV2 expected = frame;
+        uint8_t* expectedFields = metricsV3FieldBytes(expected);
+        for (uint8_t i = 0; i < METRICS_V3_FIELD_COUNT; i++) {
+            if (!(present & (1U << i))) memset(expectedFields + i * 2, 0, 2);
+        }
+        assertFieldsEqual(expected, decoded);
+    }
+}
+
+// 任一 bit 翻轉、截斷或多出 bytes 都被拒絕，且 frame 不變
+void test_rejects_corrupted_frames() {
+    uint8_t buf[METRICS_V3_MAX_BYTES + 1];
+    const MetricsFrameV2 untouched = exampleFrame();
+
+    for (size_t bit = 0; bit < sizeof(DOC_EXAMPLE) * 8; bit++) {
+        memcpy(buf, DOC_EXAMPLE, sizeof(DOC_EXAMPLE));
+        buf[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        MetricsFrameV2 frame = untouched;
+        TEST_ASSERT_FALSE(decodeMetricsV3(buf, sizeof(DOC_EXAMPLE), frame));
+        assertFieldsEqual(untouched, frame);
+    }
+
+    memcpy(buf, DOC_EXAMPLE, sizeof(DOC_EXAMPLE));
+    MetricsFrameV2 frame;
+    for (size_t len = 0; len < sizeof(DOC_EXAMPLE); len++) {
+        TEST_ASSERT_FALSE(decodeMetricsV3(buf, len, frame));
+    }
+    buf[sizeof(DOC_EXAMPLE)] = 0;
+    TEST_ASSERT_FALSE(decodeMetricsV3(buf, sizeof(DOC_EXAMPLE) + 1, frame));
+    TEST_ASSERT_FALSE(decodeMetricsV3(nullptr, 0, frame));
+
+    // JSON 送到 v3 topic
+    const char* json = "{\"v\":2,\"cpu\":[1,2]}";
+    TEST_ASSERT_FALSE(decodeMetricsV3((const uint8_t*)json, strlen(json), frame));
+}
+
+void test_encoder_rejects_bad_arguments() {
+    uint8_t buf[METRICS_V3_MAX_BYTES];
+    const MetricsFrameV2 frame = exampleFrame();
+    TEST_ASSERT_EQUAL_UINT32(0, encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, buf, sizeof(DOC_EXAMPLE) - 1));
+    TEST_ASSERT_EQUAL_UINT32(0, encodeMetricsV3(frame, 0x8000, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_UINT32(0, encodeMetricsV3(frame, METRICS_V3_ALL_FIELDS, nullptr, 0));
+
+    // 只送 CPU 的最小 frame
+    const uint16_t cpuOnly = (1U << V3_CPU_PCT) | (1U << V3_CPU_TEMP);
+    TEST_ASSERT_EQUAL_UINT32(13, encodeMetricsV3(frame, cpuOnly, buf, 13));
+    MetricsFrameV2 decoded;
+    TEST_ASSERT_TRUE(decodeMetricsV3(buf, 13, decoded));
+    TEST_ASSERT_EQUAL_INT16(424, decoded.cpuPctX10);
+    TEST_ASSERT_EQUAL_INT16(582, decoded.cpuTempCX10);
+    TEST_ASSERT_EQUAL_UINT16(0, decoded.ramTotalMB);
+}
+
+void test_bench_decode_vs_json() {
+    const char* json =
+        "{\"v\":2,\"ts\":1739999999000,\"h\":\"desk\",\"cpu\":[42.4,58.2],\"ram\":[67.8,12288,32768],"
+        "\"gpu\":[15.0,52.0,12.5,0.0,0.0],\"net\":[1024,512],\"disk\":[2048,1024]}";
+    const size_t jsonLen = strlen(json);
+    const uint32_t messages = 1000000;
+    volatile int32_t sink = 0;
+    MetricsFrameV2 frame;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t m = 0; m < messages; m++) {
+        sink += parseMetricsV2Stream((const uint8_t*)json, jsonLen, frame) ? frame.cpuPctX10 : 0;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t m = 0; m < messages; m++) {
+        sink += decodeMetricsV3(DOC_EXAMPLE, sizeof(DOC_EXAMPLE), frame) ? frame.cpuPctX10 : 0;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("v2 JSON (%u B): %6.1f ns/msg   v3 binary (%u B): %6.1f ns/msg\n", (unsigned)jsonLen,
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / messages, (unsigned)sizeof(DOC_EXAMPLE),
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / messages);
+    (void)sink;
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_encodes_protocol_example);
+    RUN_TEST(test_random_frames_round_trip);
+    RUN_TEST(test_rejects_corrupted_frames);
+    RUN_TEST(test_encoder_rejects_bad_arguments);
+    RUN_TEST(test_bench_decode_vs_json);
+    return UNITY_END();
+}
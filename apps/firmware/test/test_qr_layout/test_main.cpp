@@ -0,0 +1,83 @@
+#include <string.h>
+#include <unity.h>
+
+#include "connection_policy.h"
+#include "qr_layout.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_capacity_grows_with_version_and_shrinks_with_ecc() {
+    for (uint8_t version = 1; version <= QR_MAX_VERSION; version++) {
+        for (uint8_t ecc = 1; ecc < QR_ECC_LEVELS; ecc++) {
+            TEST_ASSERT_TRUE(qrByteCapacity(version, ecc) < qrByteCapacity(version, ecc - 1));
+        }
+        if (version > 1) {
+            TEST_ASSERT_TRUE(qrByteCapacity(version, 0) > qrByteCapacity(version - 1, 0));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, qrByteCapacity(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, qrByteCapacity(QR_MAX_VERSION + 1, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, qrByteCapacity(1, QR_ECC_LEVELS));
+}
+
+void test_selects_smallest_version_then_highest_ecc() {
+    // 10 字元：版本 1 的 QUARTILE 放得下（11），HIGH 放不下（7）
+    QrSymbol symbol = selectQrSymbol(10);
+    TEST_ASSERT_EQUAL_UINT8(1, symbol.version);
+    TEST_ASSERT_EQUAL_UINT8(2, symbol.ecc);
+
+    symbol = selectQrSymbol(strlen("http://192.168.1.50/monitor"));
+    TEST_ASSERT_EQUAL_UINT8(2, symbol.version);
+    TEST_ASSERT_EQUAL_UINT8(0, symbol.ecc);
+
+    symbol = selectQrSymbol(qrByteCapacity(3, 0) + 1);
+    TEST_ASSERT_EQUAL_UINT8(4, symbol.version);
+}
+
+void test_longest_wifi_payload_fits() {
+    const size_t longest = strlen("WIFI:T:WPA;S:;P:;;") + WIFI_MAX_SSID_LENGTH + WIFI_MAX_PASSWORD_LENGTH;
+    QrSymbol symbol = selectQrSymbol(longest);
+    TEST_ASSERT_TRUE(symbol.version >= 1);
+    TEST_ASSERT_TRUE(longest <= qrByteCapacity(symbol.version, symbol.ecc));
+}
+
+void test_payload_too_long_is_rejected() {
+    TEST_ASSERT_EQUAL_UINT8(0, selectQrSymbol(qrByteCapacity(QR_MAX_VERSION, 0) + 1).version);
+    TEST_ASSERT_EQUAL_UINT8(0, selectQrSymbol(qrByteCapacity(3, 0) + 1, 3).version);
+}
+
+void test_module_size_fits_shorter_side_with_quiet_zone() {
+    // 設定畫面的 QR 區域 240x145
+    TEST_ASSERT_EQUAL_UINT8(5, fitQrModuleSize(1, 240, 145));  // 25 模組寬
+    TEST_ASSERT_EQUAL_UINT8(4, fitQrModuleSize(3, 240, 145));  // 33
+    TEST_ASSERT_EQUAL_UINT8(2, fitQrModuleSize(7, 240, 145));  // 49
+    TEST_ASSERT_EQUAL_UINT8(QR_MAX_MODULE_SIZE, fitQrModuleSize(1, 240, 240));
+    TEST_ASSERT_EQUAL_UINT8(0, fitQrModuleSize(7, 240, 48));
+    TEST_ASSERT_EQUAL_UINT8(0, fitQrModuleSize(0, 240, 240));
+
+    for (uint8_t version = 1; version <= QR_MAX_VERSION; version++) {
+        uint8_t moduleSize = fitQrModuleSize(version, 240, 145);
+        TEST_ASSERT_TRUE((qrModuleCount(version) + QR_QUIET_MODULES * 2) * moduleSize <= 145);
+    }
+}
+
+void test_static_buffer_covers_largest_version() {
+    TEST_ASSERT_EQUAL_UINT8(45, qrModuleCount(QR_MAX_VERSION));
+    TEST_ASSERT_EQUAL_UINT16((45 * 45 + 7) / 8, QR_MAX_BUFFER_BYTES);
+    for (uint8_t version = 1; version < QR_MAX_VERSION; version++) {
+        TEST_ASSERT_TRUE(qrBufferBytes(version) < QR_MAX_BUFFER_BYTES);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_capacity_grows_with_version_and_shrinks_with_ecc);
+    RUN_TEST(test_selects_smallest_version_then_highest_ecc);
+    RUN_TEST(test_longest_wifi_payload_fits);
+    RUN_TEST(test_payload_too_long_is_rejected);
+    RUN_TEST(test_module_size_fits_shorter_side_with_quiet_zone);
+    RUN_TEST(test_static_buffer_covers_largest_version);
+    return UNITY_END();
+}
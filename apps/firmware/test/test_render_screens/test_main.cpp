@@ -0,0 +1,306 @@
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+#include "monitor_screens.h"
+#include "qr_display.h"
+#include "setup_screens.h"
+
+// 監控畫面的渲染成本與 golden image。
+// 定義 RENDER_SNAPSHOT_DIR 時（env:native_render）會輸出每個畫面的 PNG/PPM，
+// golden 不符時也會輸出，方便直接比對。
+
+static VirtualTFT tft;
+static const ThresholdConfig kThresholds = {70, 90, 70, 90, 70, 90, 60, 80};
+
+static MetricsFrameV2 sampleFrame() {
+    MetricsFrameV2 frame;
+    frame.cpuPctX10 = 423;
+    frame.cpuTempCX10 = 612;
+    frame.ramPctX10 = 715;
+    frame.ramUsedMB = 22891;
+    frame.ramTotalMB = 32000;
+    frame.gpuPctX10 = 38;
+    frame.gpuTempCX10 = 455;
+    frame.gpuMemPctX10 = 121;
+    frame.gpuHotspotCX10 = 530;
+    frame.gpuMemTempCX10 = 480;
+    frame.netRxKbps = 1280;
+    frame.netTxKbps = 96;
+    frame.diskReadKBps = 2048;
+    frame.diskWriteKBps = 512;
+    return frame;
+}
+
+static void resetCounters() {
+    tft.bus().resetCounters();
+    tft.resetAddrCommandsElided();
+}
+
+void setUp() {
+    tft.bus().clear(COLOR_BLACK);
+    tft.invalidateAddrWindow();
+    tft.resetAddrCommandsElided();
+}
+
+void tearDown() {}
+
+static void snapshot(const char* name) {
+#ifdef RENDER_SNAPSHOT_DIR
+    char path[192];
+    mkdir(RENDER_SNAPSHOT_DIR, 0755);
+    snprintf(path, sizeof(path), "%s/%s.png", RENDER_SNAPSHOT_DIR, name);
+    tft.bus().writePng(path);
+    snprintf(path, sizeof(path), "%s/%s.ppm", RENDER_SNAPSHOT_DIR, name);
+    tft.bus().writePpm(path);
+#else
+    (void)name;
+#endif
+}
+
+static void report(const char* name) {
+    const VirtualPanelBus& bus = tft.bus();
+    char line[160];
+    snprintf(line, sizeof(line), "%-22s tx=%6lu cs=%5lu cmd=%5lu elided=%4lu win=%5lu ramwr=%4lu spiBytes=%7lu",
+             name,
+             (unsigned long)bus.transactions,
+             (unsigned long)bus.csCycles,
+             (unsigned long)bus.commands,
+             (unsigned long)tft.addrCommandsElided(),
+             (unsigned long)bus.windowChanges,
+             (unsigned long)bus.ramWrites,
+             (unsigned long)bus.spiBytes);
+    TEST_MESSAGE(line);
+}
+
+static void checkGolden(const char* name, uint32_t expected) {
+    snapshot(name);
+    uint32_t actual = tft.bus().hash();
+    if (actual != expected) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s golden mismatch: 0x%08lX", name, (unsigned long)actual);
+        TEST_FAIL_MESSAGE(msg);
+    }
+}
+
+void test_device_screen_full_redraw() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    MetricsFrameV2 frame = sampleFrame();
+
+    screens.drawDeviceFrame("desk", 0, 2);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", true, 1);
+    screens.present();
+
+    report("showDevice full");
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().unframedWrites);
+    checkGolden("device_full", 0x154F3D3AUL);
+}
+
+void test_device_screen_steady_update() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    MetricsFrameV2 frame = sampleFrame();
+
+    screens.drawDeviceFrame("desk", 0, 2);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", true, 1);
+    screens.present();
+
+    resetCounters();
+    frame.cpuPctX10 = 431;
+    frame.netRxKbps = 1300;
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_CPU | DIRTY_NET);
+    screens.drawFooter("192.168.1.50", true, 2);
+    screens.present();
+
+    report("showDevice update");
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    checkGolden("device_update", 0xD48EBFC6UL);
+}
+
+// 設備頁加上 CPU/GPU 歷史圖；新取樣只補畫變動的欄，且切到離線頁時圖會被清掉
+void test_device_screen_with_history() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    MetricsFrameV2 frame = sampleFrame();
+    PercentSeries cpu;
+    PercentSeries gpu;
+    for (uint8_t i = 0; i < DEVICE_HISTORY_SAMPLES; i++) {
+        cpu.push((30 + (i * 7) % 40) * 10);
+        gpu.push(i < 20 ? 50 : 850);
+    }
+
+    screens.drawDeviceFrame("desk", 0, 2);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", true, 1);
+    screens.present();
+    screens.drawHistory(cpu, gpu);
+    report("showDevice history");
+    checkGolden("device_history", 0x539A82A2UL);
+
+    resetCounters();
+    cpu.push(950);
+    gpu.push(850);
+    screens.drawFooter("192.168.1.50", true, 2);
+    screens.present();
+    screens.drawHistory(cpu, gpu);
+    report("history append");
+    TEST_ASSERT_TRUE(tft.bus().pixelBytes < 4000);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().unframedWrites);
+
+    screens.drawOfflineDevice("desk", true);
+    screens.present();
+    for (int16_t y = 142; y < 170; y++) {
+        for (int16_t x = 168; x < 232; x++) {
+            TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(x, y));
+        }
+    }
+}
+
+// 輪播到同版面的另一台：只重畫不同的元素，結果與整頁重畫相同
+void test_device_carousel_switch() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    MetricsFrameV2 frame = sampleFrame();
+
+    screens.drawDeviceFrame("desk", 0, 2);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", true, 1);
+    screens.present();
+
+    resetCounters();
+    frame.cpuPctX10 = 915;
+    frame.gpuPctX10 = 0;
+    frame.gpuTempCX10 = 381;
+    screens.drawDeviceFrame("nas-01", 1, 2);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", true, 0);
+    screens.present();
+
+    report("carousel switch");
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_LESS_THAN_UINT32((uint32_t)TFT_WIDTH * TFT_HEIGHT * 2 / 4, tft.bus().pixelBytes);
+    uint32_t switched = tft.bus().hash();
+
+    tft.bus().clear(COLOR_MAGENTA);
+    MonitorScreens<VirtualTFT> fresh(tft);
+    fresh.drawDeviceFrame("nas-01", 1, 2);
+    fresh.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    fresh.drawFooter("192.168.1.50", true, 0);
+    fresh.present();
+    TEST_ASSERT_EQUAL_HEX32(tft.bus().hash(), switched);
+}
+
+// 上線頁面 -> 離線頁面：移除的元素以背景補回，結果與直接畫離線頁相同
+void test_device_to_offline_transition() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    MetricsFrameV2 frame = sampleFrame();
+
+    screens.drawDeviceFrame("nas-01", 0, 1);
+    screens.drawDeviceRows(frame, kThresholds, DIRTY_ALL);
+    screens.drawFooter("192.168.1.50", false, 1);
+    screens.present();
+
+    resetCounters();
+    screens.drawOfflineDevice("nas-01", false);
+    screens.present();
+
+    report("device -> offline");
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    checkGolden("device_offline", 0xA3568CD5UL);
+}
+
+void test_offline_device_screen() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    screens.drawOfflineDevice("nas-01", false);
+    screens.present();
+
+    report("showOfflineDevice");
+    checkGolden("device_offline", 0xA3568CD5UL);
+}
+
+void test_no_device_screen() {
+    MonitorScreens<VirtualTFT> screens(tft);
+    screens.drawNoDevice("192.168.1.50", false);
+    screens.present();
+
+    report("showNoDevice");
+    checkGolden("no_device", 0x43F25CD8UL);
+}
+
+// QR 內容取決於 QRCode 函式庫，這裡只檢查版面：白色留白框與左上角定位圖樣都落在文字之間
+static void assertQrLayout(const QRDisplay<VirtualTFT>& qr) {
+    TEST_ASSERT_TRUE(qr.version() >= 1);
+    TEST_ASSERT_TRUE(qr.moduleSize() >= 2);
+
+    const int16_t qrSize = qrModuleCount(qr.version()) * qr.moduleSize();
+    const int16_t padding = QR_QUIET_MODULES * qr.moduleSize();
+    const int16_t totalSize = qrSize + padding * 2;
+    const int16_t left = (TFT_WIDTH - totalSize) / 2;
+    const int16_t top = SETUP_QR_TOP + (SETUP_QR_BOTTOM - SETUP_QR_TOP - totalSize) / 2;
+
+    TEST_ASSERT_TRUE(top >= SETUP_QR_TOP);
+    TEST_ASSERT_TRUE(top + totalSize <= SETUP_QR_BOTTOM);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_WHITE, tft.bus().pixelAt(left, top));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_WHITE, tft.bus().pixelAt(left + totalSize - 1, top + totalSize - 1));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(left + padding, top + padding));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(left - 1, top));
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().unframedWrites);
+}
+
+void test_ap_setup_qr_screen() {
+    QRDisplay<VirtualTFT> qr(tft);
+    drawApSetupScreen(tft, qr, "ESP12-Monitor-1A2B", "192.168.4.1");
+
+    report("AP setup QR");
+    snapshot("ap_setup");
+    assertQrLayout(qr);
+}
+
+void test_connected_qr_screen() {
+    QRDisplay<VirtualTFT> qr(tft);
+    drawWifiConnectedScreen(tft, qr, "home-wifi", "192.168.1.50");
+
+    report("connected QR");
+    snapshot("connected");
+    assertQrLayout(qr);
+}
+
+// 再次顯示同一個畫面：沿用快取的模組圖，整個 QR（含留白框）只開一個視窗
+void test_qr_reshow_is_single_blit() {
+    QRDisplay<VirtualTFT> qr(tft);
+    drawWifiConnectedScreen(tft, qr, "home-wifi", "192.168.1.50");
+    const uint32_t first = tft.bus().hash();
+    TEST_ASSERT_EQUAL_STRING("http://192.168.1.50/monitor", qr.cachedText());
+
+    tft.bus().clear(COLOR_BLACK);
+    resetCounters();
+    qr.drawURLQR("http://192.168.1.50/monitor", SETUP_QR_TOP, SETUP_QR_BOTTOM);
+    report("QR reshow (QR only)");
+
+    const uint32_t side = (qrModuleCount(qr.version()) + QR_QUIET_MODULES * 2) * qr.moduleSize();
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+    TEST_ASSERT_EQUAL_UINT32(side * side * 2UL, tft.bus().pixelBytes);
+    assertQrLayout(qr);
+
+    drawWifiConnectedScreen(tft, qr, "home-wifi", "192.168.1.50");
+    TEST_ASSERT_EQUAL_HEX32(first, tft.bus().hash());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_device_screen_full_redraw);
+    RUN_TEST(test_device_screen_steady_update);
+    RUN_TEST(test_device_screen_with_history);
+    RUN_TEST(test_device_carousel_switch);
+    RUN_TEST(test_device_to_offline_transition);
+    RUN_TEST(test_offline_device_screen);
+    RUN_TEST(test_no_device_screen);
+    RUN_TEST(test_ap_setup_qr_screen);
+    RUN_TEST(test_connected_qr_screen);
+    RUN_TEST(test_qr_reshow_is_single_blit);
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+#include "damage_region.h"
+#include "scene_compositor.h"
+
+static VirtualTFT tft;
+static VirtualTFT reference;
+
+void setUp() {
+    tft.bus().clear(COLOR_BLACK);
+    reference.bus().clear(COLOR_BLACK);
+}
+
+void tearDown() {}
+
+void test_damage_merges_overlapping_and_adjacent_rects() {
+    DamageRegion<4> damage;
+    damage.add(10, 10, 16, 16);
+    damage.add(20, 10, 16, 16);  // 重疊
+    damage.add(36, 10, 8, 16);   // 緊鄰
+
+    TEST_ASSERT_EQUAL_UINT8(1, damage.count());
+    TEST_ASSERT_EQUAL_INT16(10, damage.rect(0).x0);
+    TEST_ASSERT_EQUAL_INT16(44, damage.rect(0).x1);
+
+    damage.add(12, 12, 4, 4);  // 已包含
+    TEST_ASSERT_EQUAL_UINT8(1, damage.count());
+    TEST_ASSERT_EQUAL_INT32(34 * 16, damage.area());
+}
+
+void test_damage_keeps_distant_rects_apart() {
+    DamageRegion<4> damage;
+    damage.add(0, 0, 16, 16);
+    damage.add(200, 200, 16, 16);
+    TEST_ASSERT_EQUAL_UINT8(2, damage.count());
+    TEST_ASSERT_EQUAL_INT32(2 * 16 * 16, damage.area());
+}
+
+void test_damage_clips_and_merges_when_full() {
+    DamageRegion<2> damage;
+    damage.add(-10, -10, 20, 20);
+    TEST_ASSERT_EQUAL_INT32(100, damage.area());
+
+    damage.add(100, 0, 10, 10);
+    damage.add(0, 200, 10, 10);
+    TEST_ASSERT_EQUAL_UINT8(2, damage.count());
+
+    // 每個原本的矩形都必須仍被覆蓋
+    const DamageRect probes[3] = {
+        damageRect(0, 0, 10, 10), damageRect(100, 0, 10, 10), damageRect(0, 200, 10, 10)};
+    for (uint8_t p = 0; p < 3; p++) {
+        bool covered = false;
+        for (uint8_t i = 0; i < damage.count(); i++) {
+            covered |= damageIntersect(damage.rect(i), probes[p]).area() == probes[p].area();
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+}
+
+void test_first_flush_paints_whole_screen() {
+    tft.bus().clear(COLOR_MAGENTA);
+    SceneCompositor<VirtualTFT, 4> scene(tft);
+    scene.setText(0, 8, 8, "HI", COLOR_WHITE, COLOR_BLACK, 2);
+    scene.flush();
+
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)TFT_WIDTH * TFT_HEIGHT * 2, tft.bus().pixelBytes);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(239, 239));
+}
+
+void test_text_update_damages_only_changed_cells() {
+    SceneCompositor<VirtualTFT, 4> scene(tft);
+    scene.setText(0, 64, 36, " 42%", COLOR_GREEN, COLOR_BLACK, 2, 80);
+    scene.flush();
+
+    tft.bus().resetCounters();
+    scene.setText(0, 64, 36, " 43%", COLOR_GREEN, COLOR_BLACK, 2, 80);
+    TEST_ASSERT_EQUAL_UINT8(1, scene.damage().count());
+    TEST_ASSERT_EQUAL_INT32(16 * 32, scene.damage().area());
+    scene.flush();
+
+    TEST_ASSERT_EQUAL_UINT32(16 * 32 * 2, tft.bus().pixelBytes);
+    TEST_ASSERT_EQUAL_UINT8(0, scene.damage().count());
+}
+
+void test_unchanged_scene_sends_nothing() {
+    SceneCompositor<VirtualTFT, 4> scene(tft);
+    scene.setFill(0, 0, 0, TFT_WIDTH, 28, 0x1082);
+    scene.setText(1, 8, 6, "desk", COLOR_WHITE, 0x1082, 2);
+    scene.flush();
+
+    tft.bus().resetCounters();
+    scene.beginScene();
+    scene.setFill(0, 0, 0, TFT_WIDTH, 28, 0x1082);
+    scene.setText(1, 8, 6, "desk", COLOR_WHITE, 0x1082, 2);
+    scene.flush();
+
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+void test_begin_scene_removes_unused_items() {
+    SceneCompositor<VirtualTFT, 4> scene(tft);
+    scene.setFill(0, 0, 0, TFT_WIDTH, 28, COLOR_RED);
+    scene.setText(1, 100, 100, "gone", COLOR_WHITE, COLOR_BLUE, 1);
+    scene.flush();
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLUE, tft.bus().pixelAt(100, 100));
+
+    tft.bus().resetCounters();
+    scene.beginScene();
+    scene.setFill(0, 0, 0, TFT_WIDTH, 28, COLOR_RED);
+    scene.flush();
+
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(100, 100));
+    TEST_ASSERT_EQUAL_HEX16(COLOR_RED, tft.bus().pixelAt(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(32 * 16 * 2, tft.bus().pixelBytes);
+}
+
+// 測試端記下的元素內容，用來在新面板上重建同一個場景
+struct ModelItem {
+    uint8_t kind;
+    bool stale;
+    int16_t x, y, w, h, minWidth;
+    uint16_t color, bg;
+    uint8_t size;
+    const char* text;
+};
+
+// 隨機增修刪元素後的增量結果，必須與同一場景在新面板上整頁合成的結果一致
+void test_incremental_flush_matches_full_composition() {
+    static const char* words[] = {"", "1", "42%", "100%", "MQTT OK", "HSP:53C", "v1.2M", "~\x7f\x01", "nas-01"};
+    static const uint16_t colors[] = {COLOR_WHITE, COLOR_RED, COLOR_GREEN, COLOR_CYAN, 0x1082};
+    ModelItem model[8] = {};
+    srand(7);
+
+    SceneCompositor<VirtualTFT, 8, 6> scene(tft);
+    for (int round = 0; round < 300; round++) {
+        if (rand() % 5 == 0) {
+            scene.beginScene();
+            for (uint8_t i = 0; i < 8; i++) model[i].stale = model[i].kind != SCENE_ITEM_NONE;
+        }
+
+        int edits = 1 + rand() % 4;
+        for (int e = 0; e < edits; e++) {
+            ModelItem& m = model[rand() % 8];
+            uint8_t id = (uint8_t)(&m - model);
+            int16_t x = (int16_t)(rand() % 280 - 20);
+            int16_t y = (int16_t)(rand() % 280 - 20);
+            m.stale = false;
+            switch (rand() % 4) {
+                case 0:
+                    m = {SCENE_ITEM_FILL, false, x, y, (int16_t)(rand() % 120), (int16_t)(rand() % 60), 0,
+                         colors[rand() % 5], 0, 0, nullptr};
+                    scene.setFill(id, m.x, m.y, m.w, m.h, m.color);
+                    break;
+                case 1:
+                    m.kind = SCENE_ITEM_NONE;
+                    scene.remove(id);
+                    break;
+                default:
+                    // 一半機率沿用原本位置與顏色只換字，走逐字元格比對的路徑
+                    if (m.kind == SCENE_ITEM_TEXT && rand() % 2) {
+                        m.text = words[rand() % 9];
+                        scene.setText(id, m.x, m.y, m.text, m.color, m.bg, m.size, m.minWidth);
+                        break;
+                    }
+                    m = {SCENE_ITEM_TEXT, false, (int16_t)(x & ~7), (int16_t)(y & ~15), 0, 0,
+                         (int16_t)(rand() % 3 * 40), colors[rand() % 5], colors[rand() % 5],
+                         (uint8_t)(1 + rand() % 3), words[rand() % 9]};
+                    scene.setText(id, m.x, m.y, m.text, m.color, m.bg, m.size, m.minWidth);
+                    break;
+            }
+        }
+        scene.flush();
+        for (uint8_t i = 0; i < 8; i++) {
+            if (model[i].stale) model[i].kind = SCENE_ITEM_NONE;
+            model[i].stale = false;
+        }
+        TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+
+        if (round % 10 != 9) continue;
+
+        reference.bus().clear(COLOR_MAGENTA);
+        SceneCompositor<VirtualTFT, 8, 6> full(reference);
+        for (uint8_t i = 0; i < 8; i++) {
+            const ModelItem& m = model[i];
+            if (m.kind == SCENE_ITEM_FILL) full.setFill(i, m.x, m.y, m.w, m.h, m.color);
+            if (m.kind == SCENE_ITEM_TEXT) full.setText(i, m.x, m.y, m.text, m.color, m.bg, m.size, m.minWidth);
+        }
+        full.flush();
+        TEST_ASSERT_EQUAL_HEX32(reference.bus().hash(), tft.bus().hash());
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_damage_merges_overlapping_and_adjacent_rects);
+    RUN_TEST(test_damage_keeps_distant_rects_apart);
+    RUN_TEST(test_damage_clips_and_merges_when_full);
+    RUN_TEST(test_first_flush_paints_whole_screen);
+    RUN_TEST(test_text_update_damages_only_changed_cells);
+    RUN_TEST(test_unchanged_scene_sends_nothing);
+    RUN_TEST(test_begin_scene_removes_unused_items);
+    RUN_TEST(test_incremental_flush_matches_full_composition);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+#include "metric_history.h"
+#include "ui_components.h"
+
+static VirtualTFT tft;
+static VirtualTFT reference;
+
+void setUp() {
+    tft.bus().clear(COLOR_BLACK);
+    tft.invalidateAddrWindow();
+    reference.bus().clear(COLOR_BLACK);
+    reference.invalidateAddrWindow();
+}
+
+void tearDown() {}
+
+void test_first_draw_fills_block_right_aligned() {
+    MetricSeries<8, PercentX10Codec> history;
+    history.push(1000);
+    history.push(500);
+
+    Sparkline<VirtualTFT, 8> spark(tft, 10, 20, 2, 10, COLOR_GREEN, COLOR_BLUE);
+    spark.draw(history);
+
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(16 * 10 * 2, tft.bus().pixelBytes);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLUE, tft.bus().pixelAt(10, 29));   // 沒有資料的欄
+    TEST_ASSERT_EQUAL_HEX16(COLOR_GREEN, tft.bus().pixelAt(22, 20));  // 100%
+    TEST_ASSERT_EQUAL_HEX16(COLOR_GREEN, tft.bus().pixelAt(25, 25));  // 50%
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLUE, tft.bus().pixelAt(25, 24));
+}
+
+// 一筆一筆接上去的增量結果，必須與同一份歷史在新面板上整塊重畫的結果一致
+void test_incremental_append_matches_full_draw() {
+    PercentSeries history;
+    Sparkline<VirtualTFT, DEVICE_HISTORY_SAMPLES> spark(tft, 100, 100, 2, 12, COLOR_MAGENTA);
+    srand(3);
+
+    for (int round = 0; round < 80; round++) {
+        history.push(rand() % 1001);
+        spark.draw(history);
+        TEST_ASSERT_EQUAL_UINT32(0, tft.bus().overflowPixels);
+        TEST_ASSERT_EQUAL_UINT32(0, tft.bus().unframedWrites);
+
+        if (round % 8 != 7) continue;
+        Sparkline<VirtualTFT, DEVICE_HISTORY_SAMPLES> full(reference, 100, 100, 2, 12, COLOR_MAGENTA);
+        full.draw(history);
+        TEST_ASSERT_EQUAL_HEX32(reference.bus().hash(), tft.bus().hash());
+    }
+}
+
+void test_steady_append_sends_only_changed_columns() {
+    PercentSeries history;
+    Sparkline<VirtualTFT, DEVICE_HISTORY_SAMPLES> spark(tft, 168, 142, 2, 12, COLOR_GREEN);
+    for (uint8_t i = 0; i < DEVICE_HISTORY_SAMPLES; i++) {
+        history.push(400);
+    }
+    spark.draw(history);
+
+    // 平穩的負載：只有最右一欄長高
+    tft.bus().resetCounters();
+    history.push(900);
+    spark.draw(history);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(2 * 6 * 2, tft.bus().pixelBytes);
+
+    // 同一份歷史再畫一次不送任何東西
+    tft.bus().resetCounters();
+    spark.draw(history);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+
+    // 尖峰往左移一欄：兩欄各補一段，遠少於整塊 64x12
+    tft.bus().resetCounters();
+    history.push(400);
+    spark.draw(history);
+    TEST_ASSERT_EQUAL_UINT32(2, tft.bus().ramWrites);
+    TEST_ASSERT_EQUAL_UINT32(2 * 2 * 6 * 2, tft.bus().pixelBytes);
+}
+
+void test_invalidate_redraws_whole_block() {
+    MetricSeries<8, PercentX10Codec> history;
+    history.push(300);
+    Sparkline<VirtualTFT, 8> spark(tft, 0, 0, 1, 8, COLOR_GREEN);
+    spark.draw(history);
+
+    tft.bus().clear(COLOR_RED);
+    tft.bus().resetCounters();
+    spark.invalidate();
+    spark.draw(history);
+    TEST_ASSERT_EQUAL_UINT32(8 * 8 * 2, tft.bus().pixelBytes);
+    TEST_ASSERT_EQUAL_HEX16(COLOR_BLACK, tft.bus().pixelAt(0, 0));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_draw_fills_block_right_aligned);
+    RUN_TEST(test_incremental_append_matches_full_draw);
+    RUN_TEST(test_steady_append_sends_only_changed_columns);
+    RUN_TEST(test_invalidate_redraws_whole_block);
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+
+#include "spi_clock_policy.h"
+
+// 在 limitHz 以下才穩定；flakyHz 這一階第 flakyTrial 次驗證會失敗
+struct FakePanelProbe {
+    bool readable = true;
+    uint32_t limitHz = 0;
+    uint32_t flakyHz = 0;
+    uint8_t flakyTrial = 0;
+    uint8_t calls = 0;
+    uint8_t flakyCalls = 0;
+
+    bool canReadBack() { return readable; }
+
+    bool verifyClock(uint32_t hz) {
+        calls++;
+        if (hz == flakyHz && ++flakyCalls == flakyTrial) {
+            return false;
+        }
+        return hz <= limitHz;
+    }
+};
+
+void test_picks_fastest_stable_clock() {
+    FakePanelProbe probe;
+    probe.limitHz = 40000000UL;
+
+    SpiClockState state = calibrateSpiClock(probe);
+    TEST_ASSERT_EQUAL_UINT32(40000000UL, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_VERIFIED, state.status);
+    TEST_ASSERT_EQUAL_UINT8(1, state.fallbacks);
+    TEST_ASSERT_EQUAL_STRING("verified", spiClockStatusToString(state.status));
+}
+
+void test_respects_max_clock() {
+    FakePanelProbe probe;
+    probe.limitHz = 80000000UL;
+
+    SpiClockState state = calibrateSpiClock(probe, 30000000UL);
+    TEST_ASSERT_EQUAL_UINT32(26666666UL, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(0, state.fallbacks);
+    TEST_ASSERT_EQUAL_UINT8(TFT_SPI_CALIBRATION_TRIALS, probe.calls);
+}
+
+void test_single_corrupt_trial_rejects_clock() {
+    FakePanelProbe probe;
+    probe.limitHz = 80000000UL;
+    probe.flakyHz = 80000000UL;
+    probe.flakyTrial = 3;
+
+    SpiClockState state = calibrateSpiClock(probe);
+    TEST_ASSERT_EQUAL_UINT32(40000000UL, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_VERIFIED, state.status);
+}
+
+void test_without_readback_uses_safe_clock() {
+    FakePanelProbe probe;
+    probe.readable = false;
+    probe.limitHz = 80000000UL;
+
+    SpiClockState state = calibrateSpiClock(probe);
+    TEST_ASSERT_EQUAL_UINT32(TFT_SPI_SAFE_HZ, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_UNVERIFIED, state.status);
+    TEST_ASSERT_EQUAL_UINT8(0, probe.calls);
+}
+
+void test_all_clocks_failing_reports_failure_at_safe_clock() {
+    FakePanelProbe probe;
+    probe.limitHz = 1000000UL;
+
+    SpiClockState state = calibrateSpiClock(probe);
+    TEST_ASSERT_EQUAL_UINT32(TFT_SPI_SAFE_HZ, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_FAILED, state.status);
+    TEST_ASSERT_EQUAL_UINT8(TFT_SPI_CLOCK_STEP_COUNT, state.fallbacks);
+}
+
+void test_runtime_fault_steps_down_until_safe_clock() {
+    SpiClockState state = {40000000UL, SPI_CLOCK_VERIFIED, 0};
+
+    TEST_ASSERT_TRUE(applySpiClockFault(state));
+    TEST_ASSERT_EQUAL_UINT32(26666666UL, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_DEGRADED, state.status);
+
+    while (applySpiClockFault(state)) {
+    }
+    TEST_ASSERT_EQUAL_UINT32(TFT_SPI_SAFE_HZ, state.hz);
+    TEST_ASSERT_EQUAL_UINT8(SPI_CLOCK_FAILED, state.status);
+    TEST_ASSERT_EQUAL_UINT8(5, state.fallbacks);
+}
+
+void test_next_lower_clock() {
+    TEST_ASSERT_EQUAL_UINT32(40000000UL, nextLowerSpiClockHz(80000000UL));
+    TEST_ASSERT_EQUAL_UINT32(20000000UL, nextLowerSpiClockHz(25000000UL));
+    TEST_ASSERT_EQUAL_UINT32(0, nextLowerSpiClockHz(TFT_SPI_SAFE_HZ));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_picks_fastest_stable_clock);
+    RUN_TEST(test_respects_max_clock);
+    RUN_TEST(test_single_corrupt_trial_rejects_clock);
+    RUN_TEST(test_without_readback_uses_safe_clock);
+    RUN_TEST(test_all_clocks_failing_reports_failure_at_safe_clock);
+    RUN_TEST(test_runtime_fault_steps_down_until_safe_clock);
+    RUN_TEST(test_next_lower_clock);
+    return UNITY_END();
+}
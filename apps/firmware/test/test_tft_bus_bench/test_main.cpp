@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <unity.h>
+
+#include "tft_core.h"
+
+// 統計匯流排交易：每次 writeCommand/writeData/writeColor/writePixels 是一段 SPI 傳輸，
+// csCycles 為 CS 實際拉低的次數
+struct CountingBus {
+    uint32_t transactions = 0;
+    uint32_t csCycles = 0;
+    uint8_t csDepth = 0;
+    uint32_t commands = 0;
+    uint32_t dataBytes = 0;
+    uint32_t pixelBytes = 0;
+
+    void startWrite() {
+        if (csDepth++ == 0) csCycles++;
+    }
+
+    void endWrite() {
+        csDepth--;
+    }
+
+    void writeCommand(uint8_t) {
+        transactions++;
+        commands++;
+    }
+
+    void writeData(const uint8_t*, uint16_t len) {
+        transactions++;
+        dataBytes += len;
+    }
+
+    void writeColor(uint16_t, uint32_t count) {
+        transactions++;
+        pixelBytes += count * 2;
+    }
+
+    void writePixels(const uint16_t*, uint32_t count) {
+        transactions++;
+        pixelBytes += count * 2;
+    }
+
+    void yieldCpu() {}
+
+    void reset() {
+        *this = CountingBus();
+    }
+};
+
+typedef TFTCore<CountingBus> CountingTFT;
+
+// 舊實作：setAddrWindow 11 次 transfer，每個像素 2 次 transfer
+static uint32_t legacyWindowTransfers() {
+    return 11;
+}
+
+static uint32_t legacyFillTransfers(uint32_t pixels) {
+    return legacyWindowTransfers() + pixels * 2;
+}
+
+static void report(const char* name, uint32_t legacy, uint32_t now) {
+    char line[128];
+    snprintf(line, sizeof(line), "%-14s legacy=%7lu bulk=%5lu", name, (unsigned long)legacy, (unsigned long)now);
+    TEST_MESSAGE(line);
+}
+
+void test_fill_screen_is_single_burst() {
+    CountingTFT tft;
+    tft.fillScreen(COLOR_BLACK);
+
+    const CountingBus& bus = tft.bus();
+    TEST_ASSERT_EQUAL_UINT32(6, bus.transactions);
+    TEST_ASSERT_EQUAL_UINT32(3, bus.commands);
+    TEST_ASSERT_EQUAL_UINT32(8, bus.dataBytes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)TFT_WIDTH * TFT_HEIGHT * 2, bus.pixelBytes);
+
+    report("fillScreen", legacyFillTransfers((uint32_t)TFT_WIDTH * TFT_HEIGHT), bus.transactions);
+}
+
+void test_fill_rect_is_single_burst_and_clipped() {
+    CountingTFT tft;
+    tft.fillRect(0, 0, 240, 28, COLOR_BLUE);
+    TEST_ASSERT_EQUAL_UINT32(6, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(240 * 28 * 2, tft.bus().pixelBytes);
+    report("fillRect 240x28", legacyFillTransfers(240 * 28), tft.bus().transactions);
+
+    tft.bus().reset();
+    tft.fillRect(-10, 230, 20, 20, COLOR_RED);
+    TEST_ASSERT_EQUAL_UINT32(6, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(10 * 10 * 2, tft.bus().pixelBytes);
+
+    tft.bus().reset();
+    tft.fillRect(240, 0, 10, 10, COLOR_RED);
+    tft.fillRect(-20, 0, 10, 10, COLOR_RED);
+    tft.fillRect(0, 0, 0, 10, COLOR_RED);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+void test_draw_pixel_uses_one_data_burst() {
+    CountingTFT tft;
+    tft.drawPixel(5, 5, COLOR_WHITE);
+    TEST_ASSERT_EQUAL_UINT32(6, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(2, tft.bus().pixelBytes);
+    report("drawPixel", legacyFillTransfers(1), tft.bus().transactions);
+
+    tft.bus().reset();
+    tft.drawPixel(-1, 5, COLOR_WHITE);
+    tft.drawPixel(5, TFT_HEIGHT, COLOR_WHITE);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+void test_push_pixels_streams_buffer_once() {
+    static uint16_t pixels[32 * 16];
+    for (uint16_t i = 0; i < 32 * 16; i++) {
+        pixels[i] = tftPanelOrder(i);
+    }
+
+    CountingTFT tft;
+    tft.pushPixels(10, 10, 32, 16, pixels);
+    TEST_ASSERT_EQUAL_UINT32(6, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(32 * 16 * 2, tft.bus().pixelBytes);
+    report("pushPixels 32x16", legacyFillTransfers(32 * 16), tft.bus().transactions);
+
+    // 水平裁切時逐列送出可見區段
+    tft.bus().reset();
+    tft.pushPixels(220, 0, 32, 16, pixels);
+    TEST_ASSERT_EQUAL_UINT32(5 + 16, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(20 * 16 * 2, tft.bus().pixelBytes);
+}
+
+// 舊 drawChar：size 1 每像素一次 drawPixel，size 2 每像素一次 fillRect
+static uint32_t legacyCharTransfers(uint8_t size) {
+    return (uint32_t)FONT_WIDTH * FONT_HEIGHT * legacyFillTransfers((uint32_t)size * size);
+}
+
+void test_draw_char_uses_one_window() {
+    CountingTFT tft;
+    tft.drawChar(10, 10, 'A', COLOR_WHITE, COLOR_BLACK, 1);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(6, tft.bus().transactions);
+    TEST_ASSERT_EQUAL_UINT32(FONT_WIDTH * FONT_HEIGHT * 2, tft.bus().pixelBytes);
+    report("drawChar x1", legacyCharTransfers(1), tft.bus().transactions);
+
+    tft.bus().reset();
+    tft.drawChar(10, 10, 'A', COLOR_WHITE, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(FONT_WIDTH * FONT_HEIGHT * 4 * 2, tft.bus().pixelBytes);
+    report("drawChar x2", legacyCharTransfers(2), tft.bus().transactions);
+
+    tft.bus().reset();
+    tft.drawChar(10, 10, '\n', COLOR_WHITE, COLOR_BLACK, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().transactions);
+}
+
+void test_draw_string_uses_one_window() {
+    CountingTFT tft;
+    tft.drawString(8, 36, "CPU 100%", COLOR_WHITE, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(8 * FONT_WIDTH * FONT_HEIGHT * 4 * 2, tft.bus().pixelBytes);
+    report("drawString x2", 8 * legacyCharTransfers(2), tft.bus().transactions);
+
+    tft.bus().reset();
+    tft.drawString(8, 222, "MQTT OK", COLOR_GREEN, COLOR_BLACK, 1);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(7 * FONT_WIDTH * FONT_HEIGHT * 2, tft.bus().pixelBytes);
+    report("drawString x1", 7 * legacyCharTransfers(1), tft.bus().transactions);
+
+    // 超出右緣的部分被裁切
+    tft.bus().reset();
+    tft.drawString(232, 0, "AB", COLOR_WHITE, COLOR_BLACK, 1);
+    TEST_ASSERT_EQUAL_UINT32(8 * FONT_HEIGHT * 2, tft.bus().pixelBytes);
+}
+
+// 舊 setAddrWindow 每個 byte 都拉一次 CS；現在每個繪圖函式只拉一次，且可包成一批
+void test_cs_held_low_per_primitive_and_batch() {
+    CountingTFT tft;
+    tft.fillRect(0, 0, 240, 28, COLOR_BLUE);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+    TEST_ASSERT_EQUAL_UINT8(0, tft.bus().csDepth);
+
+    tft.bus().reset();
+    tft.drawString(8, 36, "CPU 100%", COLOR_WHITE, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+
+    tft.bus().reset();
+    tft.startWrite();
+    tft.fillRect(0, 0, 240, 28, COLOR_BLUE);
+    tft.drawString(8, 6, "desk", COLOR_WHITE, COLOR_BLUE, 2);
+    tft.drawPixel(5, 5, COLOR_WHITE);
+    tft.endWrite();
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().csCycles);
+    TEST_ASSERT_EQUAL_UINT8(0, tft.bus().csDepth);
+
+    char line[96];
+    snprintf(line, sizeof(line), "%-14s transfers=%lu CS cycles=%lu", "batch of 3",
+             (unsigned long)tft.bus().transactions, (unsigned long)tft.bus().csCycles);
+    TEST_MESSAGE(line);
+}
+
+// 視窗快取：同一列文字接續畫時只送 CASET，完全相同的視窗只送 RAMWR
+void test_addr_window_cache_skips_unchanged_axis() {
+    CountingTFT tft;
+    tft.drawString(8, 36, "CPU", COLOR_WHITE, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.addrCommandsElided());
+
+    tft.bus().reset();
+    tft.drawString(64, 36, " 42%", COLOR_GREEN, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(2, tft.bus().commands);  // CASET + RAMWR
+    TEST_ASSERT_EQUAL_UINT32(4, tft.bus().dataBytes);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.addrCommandsElided());
+
+    tft.bus().reset();
+    tft.drawString(64, 36, " 43%", COLOR_GREEN, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(1, tft.bus().commands);  // 只有 RAMWR
+    TEST_ASSERT_EQUAL_UINT32(0, tft.bus().dataBytes);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.addrCommandsElided());
+
+    tft.bus().reset();
+    tft.invalidateAddrWindow();
+    tft.drawString(64, 36, " 44%", COLOR_GREEN, COLOR_BLACK, 2);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+    TEST_ASSERT_EQUAL_UINT32(3, tft.addrCommandsElided());
+
+    char line[96];
+    snprintf(line, sizeof(line), "%-14s elided=%lu of 9 CASET/RASET", "same-row text",
+             (unsigned long)tft.addrCommandsElided());
+    TEST_MESSAGE(line);
+}
+
+// 時脈驗證：讀回時設的視窗與測試圖樣相同，圖樣仍必須每次都帶 CASET/RASET 送出
+void test_clock_pattern_always_sends_window() {
+    static uint16_t pattern[16];
+    CountingTFT tft;
+    for (uint8_t trial = 0; trial < 3; trial++) {
+        tft.bus().reset();
+        tft.pushPixelsUncached(0, 0, 16, 1, pattern);
+        TEST_ASSERT_EQUAL_UINT32(3, tft.bus().commands);
+        TEST_ASSERT_EQUAL_UINT32(8, tft.bus().dataBytes);
+
+        // readPixels 以同一個視窗讀回
+        tft.startWrite();
+        tft.openWindow(0, 0, 16, 1);
+        tft.endWrite();
+    }
+}
+
+void test_panel_order_swaps_bytes() {
+    TEST_ASSERT_EQUAL_HEX16(0x00F8, tftPanelOrder(COLOR_RED));
+    TEST_ASSERT_EQUAL_HEX16(0xE007, tftPanelOrder(COLOR_GREEN));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, tftPanelOrder(COLOR_WHITE));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_screen_is_single_burst);
+    RUN_TEST(test_fill_rect_is_single_burst_and_clipped);
+    RUN_TEST(test_draw_pixel_uses_one_data_burst);
+    RUN_TEST(test_push_pixels_streams_buffer_once);
+    RUN_TEST(test_draw_char_uses_one_window);
+    RUN_TEST(test_draw_string_uses_one_window);
+    RUN_TEST(test_cs_held_low_per_primitive_and_batch);
+    RUN_TEST(test_addr_window_cache_skips_unchanged_axis);
+    RUN_TEST(test_clock_pattern_always_sends_window);
+    RUN_TEST(test_panel_order_swaps_bytes);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include <unity.h>
+
+#include "../support/virtual_panel.h"
+
+static VirtualTFT runTft;
+static VirtualTFT legacyTft;
+
+// 舊版逐像素實作，作為像素比對基準
+static void legacyDrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if ((uint8_t)c < FONT_FIRST_CHAR || (uint8_t)c > FONT_LAST_CHAR) return;
+
+    uint16_t index = ((uint8_t)c - FONT_FIRST_CHAR) * FONT_HEIGHT;
+    for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
+        uint8_t line = pgm_read_byte(&font_8x16[index + row]);
+        for (uint8_t col = 0; col < FONT_WIDTH; col++) {
+            uint16_t px_color = (line & (0x80 >> col)) ? color : bg;
+            if (size == 1) {
+                legacyTft.drawPixel(x + col, y + row, px_color);
+            } else {
+                legacyTft.fillRect(x + col * size, y + row * size, size, size, px_color);
+            }
+        }
+    }
+}
+
+static void legacyDrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    while (*str) {
+        legacyDrawChar(x, y, *str, color, bg, size);
+        x += FONT_WIDTH * size;
+        str++;
+    }
+}
+
+static void legacyDrawStringPadded(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg,
+                                   uint8_t size, int16_t totalWidth) {
+    int16_t strWidth = strlen(str) * FONT_WIDTH * size;
+    legacyDrawString(x, y, str, color, bg, size);
+    if (strWidth < totalWidth) {
+        legacyTft.fillRect(x + strWidth, y, totalWidth - strWidth, FONT_HEIGHT * size, bg);
+    }
+}
+
+static void resetPanels() {
+    runTft.bus().clear(0x1234);
+    legacyTft.bus().clear(0x1234);
+}
+
+static void assertPanelsEqual() {
+    TEST_ASSERT_EQUAL_UINT32(0, runTft.bus().overflowPixels);
+    TEST_ASSERT_EQUAL_MEMORY(legacyTft.bus().pixels, runTft.bus().pixels, sizeof(runTft.bus().pixels));
+}
+
+void setUp() {
+    resetPanels();
+}
+
+void tearDown() {}
+
+void test_padded_labels_match_legacy() {
+    struct Label {
+        int16_t x, y;
+        const char* text;
+        uint8_t size;
+        int16_t width;
+    };
+    const Label labels[] = {
+        {64, 36, " 42%", 2, 80},
+        {152, 36, "61C", 2, 80},
+        {64, 72, "100%", 2, 70},
+        {136, 72, "12034/32000M", 1, 100},
+        {8, 140, "HSP:71C", 1, 72},
+        {8, 156, "VRAM: 35%", 1, 120},
+        {40, 172, "v12.5M", 1, 70},
+        {168, 222, "12s ago", 1, 70},
+        {168, 222, "", 1, 70},
+    };
+
+    for (const Label& l : labels) {
+        runTft.bus().resetCounters();
+        runTft.resetAddrCommandsElided();
+        runTft.drawStringPadded(l.x, l.y, l.text, COLOR_GREEN, COLOR_BLACK, l.size, l.width);
+        legacyDrawStringPadded(l.x, l.y, l.text, COLOR_GREEN, COLOR_BLACK, l.size, l.width);
+        assertPanelsEqual();
+        // CASET + RASET + RAMWR，與上一個視窗相同的軸由快取省略
+        TEST_ASSERT_EQUAL_UINT32(3, runTft.bus().commands + runTft.addrCommandsElided());
+    }
+}
+
+void test_text_wider_than_padding_matches_legacy() {
+    runTft.drawStringPadded(10, 10, "1234567890", COLOR_WHITE, COLOR_BLUE, 1, 40);
+    legacyDrawStringPadded(10, 10, "1234567890", COLOR_WHITE, COLOR_BLUE, 1, 40);
+    assertPanelsEqual();
+}
+
+void test_clipped_runs_match_legacy() {
+    runTft.drawStringPadded(200, 230, "ABCDEFG", COLOR_RED, COLOR_GRAY, 2, 120);
+    legacyDrawStringPadded(200, 230, "ABCDEFG", COLOR_RED, COLOR_GRAY, 2, 120);
+    runTft.drawString(-13, -5, "clip", COLOR_YELLOW, COLOR_BLACK, 3);
+    legacyDrawString(-13, -5, "clip", COLOR_YELLOW, COLOR_BLACK, 3);
+    assertPanelsEqual();
+}
+
+void test_random_runs_match_legacy() {
+    static const char* const texts[] = {"CPU", "RAM", " 7%", "100%", "HSP:0C", "MQTT OK", "~!@#$%^&*()_+", ""};
+    srand(12345);
+
+    for (int i = 0; i < 500; i++) {
+        const char* text = texts[rand() % (sizeof(texts) / sizeof(texts[0]))];
+        int16_t x = (int16_t)(rand() % 280 - 20);
+        int16_t y = (int16_t)(rand() % 280 - 20);
+        uint8_t size = (uint8_t)(1 + rand() % 3);
+        int16_t width = (int16_t)(rand() % 160);
+        uint16_t color = (uint16_t)rand();
+        uint16_t bg = (uint16_t)rand();
+
+        runTft.drawStringPadded(x, y, text, color, bg, size, width);
+        legacyDrawStringPadded(x, y, text, color, bg, size, width);
+    }
+    assertPanelsEqual();
+}
+
+void test_atlas_rows_are_stretched_font_rows() {
+    TEST_ASSERT_EQUAL_HEX16(0xCF00, font2xStretchBits(0xB0));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, font2xStretchBits(0xFF));
+
+    for (uint16_t c = FONT_FIRST_CHAR; c <= FONT_LAST_CHAR; c++) {
+        const uint8_t glyph = font2xGlyph((char)c);
+        if (!strchr(FONT_2X_CHARSET, (char)c)) {
+            TEST_ASSERT_EQUAL_UINT8(FONT_2X_NONE, glyph);
+            continue;
+        }
+        TEST_ASSERT_EQUAL_UINT8(c, (uint8_t)FONT_2X_CHARSET[glyph]);
+        for (uint8_t row = 0; row < FONT_HEIGHT; row++) {
+            uint8_t bits = pgm_read_byte(&font_8x16[(c - FONT_FIRST_CHAR) * FONT_HEIGHT + row]);
+            TEST_ASSERT_EQUAL_HEX16(font2xStretchBits(bits), font2xRow(glyph, row));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(FONT_2X_NONE, font2xGlyph('\x1f'));
+    TEST_ASSERT_EQUAL_UINT8(FONT_2X_NONE, font2xGlyph((char)0x80));
+}
+
+// 表內與表外的字元混在一起，每一個都要與逐像素放大結果相同
+void test_every_char_at_size_two_matches_legacy() {
+    char line[13] = {};
+    uint16_t c = FONT_FIRST_CHAR;
+    for (int16_t y = 0; c <= FONT_LAST_CHAR; y += 32) {
+        uint8_t n = 0;
+        while (n < 12 && c <= FONT_LAST_CHAR) line[n++] = (char)c++;
+        line[n] = '\0';
+        runTft.drawString(24, y % 224, line, COLOR_CYAN, COLOR_BLUE, 2);
+        legacyDrawString(24, y % 224, line, COLOR_CYAN, COLOR_BLUE, 2);
+        assertPanelsEqual();
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_padded_labels_match_legacy);
+    RUN_TEST(test_text_wider_than_padding_matches_legacy);
+    RUN_TEST(test_clipped_runs_match_legacy);
+    RUN_TEST(test_random_runs_match_legacy);
+    RUN_TEST(test_atlas_rows_are_stretched_font_rows);
+    RUN_TEST(test_every_char_at_size_two_matches_legacy);
+    return UNITY_END();
+}
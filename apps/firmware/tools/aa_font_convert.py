@@ -0,0 +1,195 @@
+"""把 TrueType/OpenType 字型轉成韌體用的 2-bit alpha 比例字型（include/aa_font.h 格式）。
+
+用法：
+    python3 tools/aa_font_convert.py --size 14 --name sans14 -o include/aa_font_sans14.h
+    python3 tools/aa_font_convert.py --font MyFont.ttf --size 18 --name my18 --first 32 --last 126 -o ...
+
+不指定 --font 時使用 Pillow 內建的 Aileron Regular（CC0）。需要 Pillow >= 10.1。
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+
+from PIL import Image, ImageDraw, ImageFont
+
+# 字格左右多留的像素，讓超出字格的筆畫也畫得出來再裁掉
+_PAD = 8
+
+
+@dataclass
+class Glyph:
+    char: str
+    offset: int
+    width: int
+    height: int
+    x_offset: int
+    y_offset: int
+    advance: int
+
+
+def quantize(value: int) -> int:
+    """0..255 灰階 -> 0..3 alpha（Image.point 會對每個灰階值呼叫一次）。"""
+    return (value * 3 + 127) // 255
+
+
+def load_font(path: str | None, size: int) -> ImageFont.FreeTypeFont:
+    if path is None:
+        font = ImageFont.load_default(size=size)
+        if not isinstance(font, ImageFont.FreeTypeFont):
+            raise SystemExit("Pillow >= 10.1 with FreeType is required for the built-in font")
+        return font
+    return ImageFont.truetype(path, size)
+
+
+def render_glyph(font: ImageFont.FreeTypeFont, char: str, line_height: int) -> tuple[int, bool, list[list[int]]]:
+    """回傳 (advance, 是否加寬, 字格內的 alpha 列)。
+
+    筆畫超出 [0, advance) 時把字格加寬到包住整個筆畫，寧可字距多 1 像素也不裁掉筆畫，
+    這樣字格之間永遠不重疊。
+    """
+    advance = max(0, round(font.getlength(char)))
+    image = Image.new("L", (advance + _PAD * 2, line_height), 0)
+    ImageDraw.Draw(image).text((_PAD, 0), char, fill=255, font=font, anchor="la")
+    alpha = image.point(quantize)
+
+    left, right = _PAD, _PAD + advance
+    box = alpha.getbbox()
+    if box:
+        left = min(left, box[0])
+        right = max(right, box[2])
+    widened = right - left != advance
+
+    rows = []
+    for y in range(line_height):
+        rows.append([alpha.getpixel((x, y)) for x in range(left, right)])
+    return right - left, widened, rows
+
+
+def pack_alpha(rows: list[list[int]]) -> bytes:
+    out = bytearray()
+    acc = 0
+    bits = 0
+    for row in rows:
+        for alpha in row:
+            acc = (acc << 2) | alpha
+            bits += 2
+            if bits == 8:
+                out.append(acc)
+                acc = 0
+                bits = 0
+    if bits:
+        out.append(acc << (8 - bits))
+    return bytes(out)
+
+
+def convert(font: ImageFont.FreeTypeFont, first: int, last: int) -> tuple[int, list[Glyph], bytes]:
+    ascent, descent = font.getmetrics()
+    line_height = ascent + descent
+    if line_height > 255:
+        raise SystemExit(f"line height {line_height} does not fit in uint8_t")
+
+    glyphs: list[Glyph] = []
+    bitmap = bytearray()
+    widened = []
+    for code in range(first, last + 1):
+        char = chr(code)
+        advance, grew, rows = render_glyph(font, char, line_height)
+        if advance > 255:
+            raise SystemExit(f"advance of {char!r} is {advance}, does not fit in uint8_t")
+        if grew:
+            widened.append(char)
+
+        ink = [(x, y) for y, row in enumerate(rows) for x, alpha in enumerate(row) if alpha]
+        if ink:
+            x0 = min(x for x, _ in ink)
+            x1 = max(x for x, _ in ink) + 1
+            y0 = min(y for _, y in ink)
+            y1 = max(y for _, y in ink) + 1
+            cropped = [row[x0:x1] for row in rows[y0:y1]]
+        else:
+            x0 = x1 = y0 = y1 = 0
+            cropped = []
+
+        if len(bitmap) > 0xFFFF:
+            raise SystemExit("bitmap larger than 64 KB, reduce the size or the character range")
+        glyphs.append(Glyph(char, len(bitmap), x1 - x0, y1 - y0, x0, y0, advance))
+        bitmap += pack_alpha(cropped)
+
+    if widened:
+        print(f"note: widened the cell of {''.join(widened)!r} to keep overhanging strokes", file=sys.stderr)
+    return line_height, glyphs, bytes(bitmap)
+
+
+def c_char_comment(char: str) -> str:
+    if char == "\\":
+        return "backslash"
+    return repr(char)
+
+
+def emit_header(name: str, source: str, size: int, first: int, last: int,
+                line_height: int, glyphs: list[Glyph], bitmap: bytes) -> str:
+    guard = f"AA_FONT_{name.upper()}_H"
+    symbol = f"aa_font_{name}"
+    lines = [
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        '#include "aa_font.h"',
+        "",
+        "// 由 tools/aa_font_convert.py 產生，請勿手動修改",
+        f"// 來源：{source}，{size} px，字元 {first}..{last}，行高 {line_height}，點陣 {len(bitmap)} bytes",
+        "",
+        f"const uint8_t {symbol}_bitmap[] PROGMEM = {{",
+    ]
+    for i in range(0, len(bitmap), 16):
+        chunk = ",".join(f"0x{b:02X}" for b in bitmap[i:i + 16])
+        lines.append(f"    {chunk},")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"const AAGlyph {symbol}_glyphs[] PROGMEM = {{")
+    for g in glyphs:
+        lines.append(
+            f"    {{{g.offset}, {g.width}, {g.height}, {g.x_offset}, {g.y_offset}, {g.advance}, 0}},"
+            f"  // {c_char_comment(g.char)}"
+        )
+    lines.append("};")
+    lines.append("")
+    lines.append(f"const AAFont AA_FONT_{name.upper()} = {{{symbol}_bitmap, {symbol}_glyphs, {first}, {last}, {line_height}}};")
+    lines.append("")
+    lines.append("#endif")
+    lines.append("")
+    return "\n".join(lines)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--font", help="TTF/OTF path (default: Pillow built-in Aileron Regular)")
+    parser.add_argument("--size", type=int, required=True, help="pixel size passed to FreeType")
+    parser.add_argument("--name", required=True, help="symbol suffix, e.g. sans14 -> AA_FONT_SANS14")
+    parser.add_argument("--first", type=int, default=32, help="first character code (rendered as fallback glyph)")
+    parser.add_argument("--last", type=int, default=126, help="last character code")
+    parser.add_argument("-o", "--output", type=Path, required=True)
+    args = parser.parse_args()
+
+    if not (0 <= args.first <= args.last <= 255):
+        parser.error("--first/--last must satisfy 0 <= first <= last <= 255")
+    if not args.name.isidentifier():
+        parser.error("--name must be a valid C identifier suffix")
+
+    font = load_font(args.font, args.size)
+    source = Path(args.font).name if args.font else "Aileron Regular (CC0, Pillow built-in)"
+    line_height, glyphs, bitmap = convert(font, args.first, args.last)
+    args.output.write_text(
+        emit_header(args.name, source, args.size, args.first, args.last, line_height, glyphs, bitmap),
+        encoding="utf-8",
+    )
+    print(f"{args.output}: {len(glyphs)} glyphs, line height {line_height}, {len(bitmap)} bytes bitmap")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Forward per-host metrics v3 frames to the display as batches on one collector topic.
+
+Hosts (e.g. VMs) run sender_v2.py with METRICS_PROTOCOL=v3 against a broker the
+collector subscribes to (SOURCE_MQTT_*). Every SEND_INTERVAL_SEC the collector
+publishes the frames it received on sys/agents/<COLLECTOR_NAME>/metrics/batch on
+the display's broker (MQTT_*). See docs/protocol/metrics-v3.md.
+"""
+
+from __future__ import annotations
+
+import socket
+import threading
+import time
+
+from paho.mqtt import client as mqtt
+
+import metrics_v3
+from sender_v2 import connect_and_start, create_mqtt_client, parse_interval, parse_qos, read_env
+
+SOURCE_TOPIC = "sys/agents/+/metrics/v3"
+
+
+def hostname_from_topic(topic: str) -> str | None:
+    parts = topic.split("/")
+    if len(parts) != 5 or parts[:2] != ["sys", "agents"] or parts[3:] != ["metrics", "v3"] or not parts[2]:
+        return None
+    return parts[2]
+
+
+class BatchCollector:
+    """Queues v3 frames per host and packs them into batch messages.
+
+    Frames are forwarded unchanged, so keyframe/delta sequences reach the display
+    as the hosts sent them. After the upstream connection drops, each host's last
+    forwarded keyframe is resent ahead of its next deltas, since the display may
+    have missed the original.
+    """
+
+    def __init__(self) -> None:
+        self._lock = threading.Lock()
+        self._pending: list[tuple[str, int, bytes]] = []
+        self._keyframes: dict[str, bytes] = {}
+        self._resend_keyframes = False
+
+    def add(self, topic: str, payload: bytes) -> bool:
+        hostname = hostname_from_topic(topic)
+        if hostname is None or not metrics_v3.is_valid_batch_hostname(hostname):
+            return False
+        try:
+            flags = metrics_v3.decode_frame(payload)["flags"]
+        except metrics_v3.FrameError:
+            return False
+        with self._lock:
+            self._pending.append((hostname, flags, bytes(payload)))
+        return True
+
+    def resend_keyframes(self) -> None:
+        """Call after (re)connecting upstream or when a publish fails."""
+        with self._lock:
+            self._resend_keyframes = True
+
+    def flush(self, topic: str) -> list[bytes]:
+        with self._lock:
+            pending, self._pending = self._pending, []
+            resend, self._resend_keyframes = self._resend_keyframes, False
+
+        entries: list[tuple[str, bytes]] = []
+        if resend:
+            # Only hosts that are still sending; a stale keyframe would bring a gone host back online.
+            started: set[str] = set()
+            for hostname, flags, _frame in pending:
+                if hostname in started:
+                    continue
+                started.add(hostname)
+                keyframe = self._keyframes.get(hostname)
+                if keyframe is not None and flags != metrics_v3.FLAG_KEYFRAME:
+                    entries.append((hostname, keyframe))
+        for hostname, flags, frame in pending:
+            if flags == metrics_v3.FLAG_KEYFRAME:
+                self._keyframes[hostname] = frame
+            elif flags == 0:
+                self._keyframes.pop(hostname, None)
+            entries.append((hostname, frame))
+        return metrics_v3.encode_batch(entries, topic)
+
+
+def main() -> int:
+    collector_name = read_env("COLLECTOR_NAME", socket.gethostname())
+    interval = parse_interval(read_env("SEND_INTERVAL_SEC", "1.0"))
+    qos = parse_qos(read_env("MQTT_QOS", "0"))
+    topic = metrics_v3.topic_for_collector(collector_name)
+    collector = BatchCollector()
+
+    upstream, mqtt_host, mqtt_port = create_mqtt_client(f"collector-{collector_name}")
+    upstream.on_connect = lambda *_args: collector.resend_keyframes()
+
+    source, source_host, source_port = create_mqtt_client(f"collector-source-{collector_name}", "SOURCE_MQTT")
+
+    def on_source_connect(client: mqtt.Client, *_args) -> None:
+        client.subscribe(SOURCE_TOPIC, qos=qos)
+
+    def on_source_message(_client: mqtt.Client, _userdata, message: mqtt.MQTTMessage) -> None:
+        collector.add(message.topic, message.payload)
+
+    source.on_connect = on_source_connect
+    source.on_message = on_source_message
+
+    connect_and_start(upstream, mqtt_host, mqtt_port)
+    connect_and_start(source, source_host, source_port)
+    print(
+        f"Collector started: {SOURCE_TOPIC} on {source_host}:{source_port} -> "
+        f"{topic} on {mqtt_host}:{mqtt_port} interval={interval}s"
+    )
+
+    try:
+        while True:
+            time.sleep(interval)
+            for payload in collector.flush(topic):
+                info = upstream.publish(topic, payload=payload, qos=qos, retain=False)
+                if info.rc != mqtt.MQTT_ERR_SUCCESS:
+                    print(f"publish failed rc={info.rc}")
+                    collector.resend_keyframes()
+    except KeyboardInterrupt:
+        print("Collector stopped")
+    finally:
+        for client in (source, upstream):
+            client.loop_stop()
+            client.disconnect()
+
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
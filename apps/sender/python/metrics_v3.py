@@ -0,0 +1,289 @@
+"""Metrics v3 binary frame encoder/decoder (see docs/protocol/metrics-v3.md)."""
+
+from __future__ import annotations
+
+import binascii
+import math
+import struct
+
+SCHEMA_V3 = 3
+HEADER_BYTE = SCHEMA_V3 << 4
+HEADER_FORMAT = "<BHI"
+HEADER_BYTES = struct.calcsize(HEADER_FORMAT)
+SEQ_BYTES = 2
+CRC_BYTES = 2
+
+# Low nibble of the header byte. Keyframes carry every field; deltas carry only the
+# fields that differ from the keyframe named by key_seq.
+FLAG_KEYFRAME = 0x1
+FLAG_DELTA = 0x2
+
+# Batch messages (one collector, many hosts) use header 0x38 on .../metrics/batch.
+BATCH_FLAG = 0x8
+BATCH_HEADER = HEADER_BYTE | BATCH_FLAG
+BATCH_MAX_HOSTS = 32
+BATCH_MAX_HOSTNAME = 31
+# Firmware MQTT client buffer (MQTT_MAX_PAYLOAD_BYTES). It must hold the whole PUBLISH
+# packet: fixed header, up to 4 remaining-length bytes, the topic length and the topic.
+CLIENT_BUFFER_BYTES = 1024
+PUBLISH_HEADER_BYTES = 1 + 4 + 2
+
+# (v2 array key, index, x10 scaled) in wire order; x10 fields are int16, the rest uint16.
+FIELDS: tuple[tuple[str, int, bool], ...] = (
+    ("cpu", 0, True),
+    ("cpu", 1, True),
+    ("ram", 0, True),
+    ("ram", 1, False),
+    ("ram", 2, False),
+    ("gpu", 0, True),
+    ("gpu", 1, True),
+    ("gpu", 2, True),
+    ("gpu", 3, True),
+    ("gpu", 4, True),
+    ("net", 0, False),
+    ("net", 1, False),
+    ("disk", 0, False),
+    ("disk", 1, False),
+)
+ALL_FIELDS = (1 << len(FIELDS)) - 1
+MAX_BYTES = HEADER_BYTES + SEQ_BYTES + 2 * len(FIELDS) + CRC_BYTES
+
+_ARRAY_LENGTHS = {"cpu": 2, "ram": 3, "gpu": 5, "net": 2, "disk": 2}
+
+
+class FrameError(ValueError):
+    pass
+
+
+def topic_for_host(hostname: str) -> str:
+    return f"sys/agents/{hostname}/metrics/v3"
+
+
+def topic_for_collector(collector: str) -> str:
+    return f"sys/agents/{collector}/metrics/batch"
+
+
+def payload_budget(topic: str, buffer_size: int = CLIENT_BUFFER_BYTES) -> int:
+    """Largest payload the firmware can receive on `topic` (see mqttPublishPayloadBudget)."""
+    return max(0, buffer_size - PUBLISH_HEADER_BYTES - len(topic.encode("utf-8")))
+
+
+def crc16_ccitt(data: bytes) -> int:
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), same as the firmware."""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def _round_half_away(value: float) -> int:
+    return int(math.copysign(math.floor(abs(value) + 0.5), value))
+
+
+def _to_wire(value: float, x10: bool) -> int:
+    if x10:
+        return max(-32768, min(32767, _round_half_away(float(value) * 10)))
+    return max(0, min(65535, _round_half_away(float(value))))
+
+
+def wire_values(payload: dict) -> tuple[list[int], int]:
+    """Wire values for every field (missing ones as 0) and the bitmap of fields that are set."""
+    values = []
+    present = 0
+    for bit, (key, index, x10) in enumerate(FIELDS):
+        array = payload.get(key) or []
+        value = array[index] if index < len(array) else None
+        if value is not None:
+            present |= 1 << bit
+        values.append(_to_wire(value or 0, x10))
+    return values, present
+
+
+def encode_frame(
+    payload: dict, present: int | None = None, *, flags: int = 0, seq: int = 0, key_seq: int = 0
+) -> bytes:
+    """Encode a v2-shaped payload dict (see metrics_payload.build_payload) as a v3 frame.
+
+    Fields that are missing or None are left out of the presence bitmap unless
+    `present` is given explicitly. Keyframes always carry every field.
+    """
+    values, auto_present = wire_values(payload)
+    if flags == FLAG_KEYFRAME:
+        present = ALL_FIELDS
+        key_seq = seq
+    elif present is None:
+        present = auto_present
+    if present & ~ALL_FIELDS:
+        raise FrameError(f"undefined presence bits: {present:#x}")
+    if flags not in (0, FLAG_KEYFRAME, FLAG_DELTA):
+        raise FrameError(f"bad flags {flags:#x}")
+
+    body = bytearray(
+        struct.pack(HEADER_FORMAT, HEADER_BYTE | flags, present, int(payload.get("ts", 0)) & 0xFFFFFFFF)
+    )
+    if flags:
+        body += struct.pack("<BB", seq & 0xFF, key_seq & 0xFF)
+    for bit, (_, _, x10) in enumerate(FIELDS):
+        if present & (1 << bit):
+            body += struct.pack("<h" if x10 else "<H", values[bit])
+    body += struct.pack("<H", crc16_ccitt(bytes(body)))
+    return bytes(body)
+
+
+def decode_frame(data: bytes) -> dict:
+    """Decode a v3 frame back into a v2-shaped dict; absent fields are None."""
+    if len(data) < HEADER_BYTES + CRC_BYTES or len(data) > MAX_BYTES:
+        raise FrameError(f"bad frame length {len(data)}")
+    header, present, ts = struct.unpack_from(HEADER_FORMAT, data)
+    flags = header & 0x0F
+    if header >> 4 != SCHEMA_V3 or flags not in (0, FLAG_KEYFRAME, FLAG_DELTA):
+        raise FrameError(f"bad header byte {header:#x}")
+    if present & ~ALL_FIELDS:
+        raise FrameError(f"undefined presence bits: {present:#x}")
+    if flags == FLAG_KEYFRAME and present != ALL_FIELDS:
+        raise FrameError("keyframe must carry every field")
+    seq_bytes = SEQ_BYTES if flags else 0
+    if len(data) != HEADER_BYTES + seq_bytes + 2 * bin(present).count("1") + CRC_BYTES:
+        raise FrameError("length does not match presence bitmap")
+    (crc,) = struct.unpack_from("<H", data, len(data) - CRC_BYTES)
+    if crc != crc16_ccitt(data[:-CRC_BYTES]):
+        raise FrameError("crc mismatch")
+
+    result: dict = {"v": SCHEMA_V3, "ts": ts, "present": present, "flags": flags}
+    if flags:
+        result["seq"], result["key_seq"] = struct.unpack_from("<BB", data, HEADER_BYTES)
+        if flags == FLAG_KEYFRAME and result["seq"] != result["key_seq"]:
+            raise FrameError("keyframe key_seq must equal seq")
+    for key, length in _ARRAY_LENGTHS.items():
+        result[key] = [None] * length
+    offset = HEADER_BYTES + seq_bytes
+    for bit, (key, index, x10) in enumerate(FIELDS):
+        if not present & (1 << bit):
+            continue
+        (raw,) = struct.unpack_from("<h" if x10 else "<H", data, offset)
+        offset += 2
+        result[key][index] = raw / 10 if x10 else raw
+    return result
+
+
+class DeltaEncoder:
+    """Sends a keyframe every `keyframe_interval` frames and deltas against it in between.
+
+    An interval of 1 or less sends plain frames only.
+    """
+
+    def __init__(self, keyframe_interval: int = 10) -> None:
+        self.keyframe_interval = keyframe_interval
+        self._keyframe: list[int] | None = None
+        self._key_seq = 0
+        self._next_seq = 0
+        self._since_keyframe = 0
+
+    def force_keyframe(self) -> None:
+        self._since_keyframe = 0
+
+    def encode(self, payload: dict) -> bytes:
+        if self.keyframe_interval <= 1:
+            return encode_frame(payload)
+
+        seq = self._next_seq
+        values, _ = wire_values(payload)
+        if self._since_keyframe == 0 or self._keyframe is None:
+            data = encode_frame(payload, flags=FLAG_KEYFRAME, seq=seq)
+            self._keyframe = values
+            self._key_seq = seq
+            self._since_keyframe = 0
+        else:
+            changed = 0
+            for bit, (value, base) in enumerate(zip(values, self._keyframe)):
+                if value != base:
+                    changed |= 1 << bit
+            data = encode_frame(payload, changed, flags=FLAG_DELTA, seq=seq, key_seq=self._key_seq)
+        self._next_seq = (seq + 1) & 0xFF
+        self._since_keyframe = (self._since_keyframe + 1) % self.keyframe_interval
+        return data
+
+
+def _batch_hostname(hostname: str) -> bytes:
+    name = hostname.encode("utf-8")
+    if not 1 <= len(name) <= BATCH_MAX_HOSTNAME or any(c in name for c in b"/+#\0"):
+        raise FrameError(f"bad batch hostname {hostname!r}")
+    return name
+
+
+def is_valid_batch_hostname(hostname: str) -> bool:
+    try:
+        _batch_hostname(hostname)
+    except FrameError:
+        return False
+    return True
+
+
+def encode_batch(
+    entries: list[tuple[str, bytes]], topic: str, *, buffer_size: int = CLIENT_BUFFER_BYTES
+) -> list[bytes]:
+    """Pack (hostname, v3 frame) pairs into as few batch messages for `topic` as possible.
+
+    Each message plus its MQTT header and topic fits in the firmware's client buffer.
+    Frames are the output of encode_frame / DeltaEncoder.encode; their own CRC is
+    dropped and one CRC covers the whole message.
+    """
+    max_bytes = payload_budget(topic, buffer_size)
+    messages: list[bytes] = []
+    body = bytearray()
+    count = 0
+
+    def flush() -> None:
+        nonlocal body, count
+        if count:
+            data = bytes([BATCH_HEADER, count]) + body
+            messages.append(data + struct.pack("<H", crc16_ccitt(data)))
+        body = bytearray()
+        count = 0
+
+    for hostname, frame in entries:
+        decode_frame(frame)
+        name = _batch_hostname(hostname)
+        entry = bytes([len(name)]) + name + frame[:-CRC_BYTES]
+        if 2 + len(entry) + CRC_BYTES > max_bytes:
+            raise FrameError(f"entry for {hostname!r} does not fit in {max_bytes} bytes")
+        if count == BATCH_MAX_HOSTS or 2 + len(body) + len(entry) + CRC_BYTES > max_bytes:
+            flush()
+        body += entry
+        count += 1
+    flush()
+    return messages
+
+
+def decode_batch(data: bytes) -> list[tuple[str, dict]]:
+    """Decode a batch message into (hostname, decode_frame result) pairs."""
+    if len(data) < 2 + CRC_BYTES or data[0] != BATCH_HEADER:
+        raise FrameError("bad batch header")
+    count = data[1]
+    if not 1 <= count <= BATCH_MAX_HOSTS:
+        raise FrameError(f"bad batch count {count}")
+    (crc,) = struct.unpack_from("<H", data, len(data) - CRC_BYTES)
+    if crc != crc16_ccitt(data[:-CRC_BYTES]):
+        raise FrameError("crc mismatch")
+
+    body = data[:-CRC_BYTES]
+    entries = []
+    offset = 2
+    for _ in range(count):
+        if offset >= len(body):
+            raise FrameError("batch truncated")
+        host_len = body[offset]
+        hostname = body[offset + 1 : offset + 1 + host_len].decode("utf-8", errors="replace")
+        _batch_hostname(hostname)
+        offset += 1 + host_len
+        if offset + HEADER_BYTES > len(body):
+            raise FrameError("batch truncated")
+        header, present, _ = struct.unpack_from(HEADER_FORMAT, body, offset)
+        if present & ~ALL_FIELDS:
+            raise FrameError(f"undefined presence bits: {present:#x}")
+        frame_len = HEADER_BYTES + (SEQ_BYTES if header & 0x0F else 0) + 2 * bin(present).count("1")
+        frame = bytes(body[offset : offset + frame_len])
+        if len(frame) != frame_len:
+            raise FrameError("batch truncated")
+        entries.append((hostname, decode_frame(frame + struct.pack("<H", crc16_ccitt(frame)))))
+        offset += frame_len
+    if offset != len(body):
+        raise FrameError("trailing bytes in batch")
+    return entries
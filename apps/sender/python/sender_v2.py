@@ -26,6 +26,7 @@ from metrics_payload import (
     build_payload,
     topic_for_host,
 )
+import metrics_v3
 
 _NVIDIA_SMI = shutil.which("nvidia-smi")
 _ROCM_SMI = shutil.which("rocm-smi")
@@ -406,11 +407,11 @@ def read_env(name: str, default: str) -> str:
     return value if value is not None and value != "" else default
 
 
-def create_mqtt_client(client_id: str) -> tuple[mqtt.Client, str, int]:
-    mqtt_host = read_env("MQTT_HOST", "127.0.0.1")
-    mqtt_port = int(read_env("MQTT_PORT", "1883"))
-    mqtt_user = read_env("MQTT_USER", "")
-    mqtt_pass = read_env("MQTT_PASS", "")
+def create_mqtt_client(client_id: str, env_prefix: str = "MQTT") -> tuple[mqtt.Client, str, int]:
+    mqtt_host = read_env(f"{env_prefix}_HOST", "127.0.0.1")
+    mqtt_port = int(read_env(f"{env_prefix}_PORT", "1883"))
+    mqtt_user = read_env(f"{env_prefix}_USER", "")
+    mqtt_pass = read_env(f"{env_prefix}_PASS", "")
 
     client_kwargs: dict = {"client_id": client_id, "protocol": mqtt.MQTTv311}
     if hasattr(mqtt, "CallbackAPIVersion"):
@@ -455,6 +456,38 @@ def parse_qos(raw: str) -> int:
     return max(0, min(qos, 2))
 
 
+def parse_protocol(raw: str) -> str:
+    protocol = raw.strip().lower()
+    return protocol if protocol in ("v2", "v3") else "v2"
+
+
+def parse_keyframe_interval(raw: str) -> int:
+    try:
+        interval = int(raw)
+    except ValueError:
+        return 10
+    return max(1, min(interval, 255))
+
+
+def encode_payload(payload: dict, protocol: str, encoder: metrics_v3.DeltaEncoder | None = None) -> bytes | str:
+    if protocol == "v3":
+        return encoder.encode(payload) if encoder else metrics_v3.encode_frame(payload)
+    return json.dumps(payload, separators=(",", ":"), ensure_ascii=False)
+
+
+def force_keyframe_on_connect(client: mqtt.Client, encoder: metrics_v3.DeltaEncoder) -> None:
+    """Start every broker session with a keyframe.
+
+    Deltas only make sense against a keyframe the display has received, and the one
+    sent before a disconnect may never have been delivered.
+    """
+
+    def on_connect(*_args) -> None:
+        encoder.force_keyframe()
+
+    client.on_connect = on_connect
+
+
 def connect_and_start(client: mqtt.Client, mqtt_host: str, mqtt_port: int) -> None:
     connect_mqtt_with_retry(client, mqtt_host, mqtt_port)
     client.loop_start()
@@ -464,10 +497,13 @@ def main() -> int:
     hostname = read_env("SENDER_HOSTNAME", socket.gethostname())
     interval = parse_interval(read_env("SEND_INTERVAL_SEC", "1.0"))
     qos = parse_qos(read_env("MQTT_QOS", "0"))
+    protocol = parse_protocol(read_env("METRICS_PROTOCOL", "v2"))
+    v3_encoder = metrics_v3.DeltaEncoder(parse_keyframe_interval(read_env("METRICS_V3_KEYFRAME_INTERVAL", "10")))
 
-    topic = topic_for_host(hostname)
+    topic = metrics_v3.topic_for_host(hostname) if protocol == "v3" else topic_for_host(hostname)
     rate_sampler = RateSampler()
     client, mqtt_host, mqtt_port = create_mqtt_client(f"sender-v2-{hostname}")
+    force_keyframe_on_connect(client, v3_encoder)
     connect_and_start(client, mqtt_host, mqtt_port)
 
     print(
@@ -482,10 +518,11 @@ def main() -> int:
         while True:
             snapshot = build_snapshot(hostname, rate_sampler)
             payload = build_payload(snapshot)
-            encoded = json.dumps(payload, separators=(",", ":"), ensure_ascii=False)
+            encoded = encode_payload(payload, protocol, v3_encoder)
             info = client.publish(topic, payload=encoded, qos=qos, retain=False)
             if info.rc != mqtt.MQTT_ERR_SUCCESS:
                 print(f"publish failed rc={info.rc}")
+                v3_encoder.force_keyframe()
             time.sleep(interval)
     except KeyboardInterrupt:
         print("Sender v2 stopped")
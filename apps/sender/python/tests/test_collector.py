@@ -0,0 +1,68 @@
+from __future__ import annotations
+
+import metrics_v3
+from collector import BatchCollector, hostname_from_topic
+
+TOPIC = metrics_v3.topic_for_collector("rack")
+
+
+def frames(flags_by_host: dict[str, list[int]]) -> dict[str, list[bytes]]:
+    payload = {"ts": 0, "cpu": [1.0, 2.0]}
+    result = {}
+    for hostname, flags in flags_by_host.items():
+        encoder = metrics_v3.DeltaEncoder(keyframe_interval=100)
+        result[hostname] = []
+        for flag in flags:
+            if flag == metrics_v3.FLAG_KEYFRAME:
+                encoder.force_keyframe()
+            result[hostname].append(encoder.encode(payload))
+            assert metrics_v3.decode_frame(result[hostname][-1])["flags"] == flag
+    return result
+
+
+def batch_hosts(messages: list[bytes]) -> list[tuple[str, int]]:
+    return [(name, frame["flags"]) for m in messages for name, frame in metrics_v3.decode_batch(m)]
+
+
+def test_hostname_from_topic():
+    assert hostname_from_topic("sys/agents/vm-1/metrics/v3") == "vm-1"
+    assert hostname_from_topic("sys/agents/vm-1/metrics/v2") is None
+    assert hostname_from_topic("sys/agents//metrics/v3") is None
+
+
+def test_forwards_frames_in_order():
+    f = frames({"a": [metrics_v3.FLAG_KEYFRAME, metrics_v3.FLAG_DELTA], "b": [metrics_v3.FLAG_KEYFRAME]})
+    collector = BatchCollector()
+    assert collector.add("sys/agents/a/metrics/v3", f["a"][0])
+    assert collector.add("sys/agents/b/metrics/v3", f["b"][0])
+    assert collector.add("sys/agents/a/metrics/v3", f["a"][1])
+    assert not collector.add("sys/agents/a/metrics/v3", b"\x30")
+    assert not collector.add("sys/agents/" + "x" * 32 + "/metrics/v3", f["b"][0])
+
+    assert batch_hosts(collector.flush(TOPIC)) == [
+        ("a", metrics_v3.FLAG_KEYFRAME),
+        ("b", metrics_v3.FLAG_KEYFRAME),
+        ("a", metrics_v3.FLAG_DELTA),
+    ]
+    assert collector.flush(TOPIC) == []
+
+
+def test_resends_keyframe_after_upstream_reconnect():
+    k, d = metrics_v3.FLAG_KEYFRAME, metrics_v3.FLAG_DELTA
+    f = frames({"a": [k, d, d], "b": [k, k], "gone": [k]})
+    collector = BatchCollector()
+    for hostname in ("a", "b", "gone"):
+        collector.add(f"sys/agents/{hostname}/metrics/v3", f[hostname][0])
+    collector.flush(TOPIC)
+
+    collector.add("sys/agents/a/metrics/v3", f["a"][1])
+    collector.resend_keyframes()
+    collector.add("sys/agents/a/metrics/v3", f["a"][2])
+    collector.add("sys/agents/b/metrics/v3", f["b"][1])
+    messages = collector.flush(TOPIC)
+    # a gets its last keyframe ahead of the deltas, b already sends one, an idle host gets nothing.
+    assert batch_hosts(messages) == [("a", k), ("a", d), ("a", d), ("b", k)]
+    assert metrics_v3.decode_batch(messages[0])[0][1] == metrics_v3.decode_frame(f["a"][0])
+
+    collector.add("sys/agents/a/metrics/v3", f["a"][2])
+    assert batch_hosts(collector.flush(TOPIC)) == [("a", d)]
@@ -0,0 +1,234 @@
+import random
+
+import pytest
+
+from metrics_payload import (
+    CpuSnapshot,
+    DiskSnapshot,
+    GpuSnapshot,
+    MetricsSnapshot,
+    NetSnapshot,
+    RamSnapshot,
+    build_payload,
+)
+from metrics_v3 import (
+    ALL_FIELDS,
+    BATCH_MAX_HOSTS,
+    CLIENT_BUFFER_BYTES,
+    FLAG_DELTA,
+    FLAG_KEYFRAME,
+    DeltaEncoder,
+    FrameError,
+    crc16_ccitt,
+    decode_batch,
+    decode_frame,
+    encode_batch,
+    encode_frame,
+    payload_budget,
+    topic_for_collector,
+    topic_for_host,
+)
+
+# Same bytes as DOC_EXAMPLE in apps/firmware/test/test_metrics_v3.
+DOC_EXAMPLE = bytes(
+    [
+        0x30, 0xFF, 0x3F, 0x18, 0xF4, 0x14, 0x20, 0xA8, 0x01, 0x46, 0x02, 0xA6, 0x02, 0x00, 0x30, 0x00, 0x80, 0x96, 0x00,
+        0x08, 0x02, 0x7D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x08, 0x00, 0x04, 0x31, 0x79,
+    ]
+)
+
+# Same bytes as DOC_DELTA_EXAMPLE in apps/firmware/test/test_metrics_delta.
+DOC_DELTA_EXAMPLE = bytes([0x32, 0x01, 0x04, 0x00, 0xF8, 0x14, 0x20, 0x08, 0x07, 0xAF, 0x01, 0x00, 0x08, 0xAB, 0x48])
+
+# Same bytes as DOC_BATCH_EXAMPLE in apps/firmware/test/test_metrics_batch.
+DOC_BATCH_EXAMPLE = bytes(
+    [
+        0x38, 0x02, 0x04, 0x64, 0x65, 0x73, 0x6B, 0x30, 0x03, 0x00, 0x18, 0xF4, 0x14, 0x20, 0xA8, 0x01, 0x46, 0x02, 0x03,
+        0x6E, 0x61, 0x73, 0x32, 0x01, 0x04, 0x00, 0xF8, 0x14, 0x20, 0x08, 0x07, 0xAF, 0x01, 0x00, 0x08, 0x6F, 0x4E,
+    ]
+)
+
+
+def example_payload() -> dict:
+    return build_payload(
+        MetricsSnapshot(
+            hostname="desk",
+            ts_ms=1739999999000,
+            cpu=CpuSnapshot(percent=42.4, temp_c=58.2),
+            ram=RamSnapshot(percent=67.8, used_mb=12288, total_mb=32768),
+            gpu=GpuSnapshot(percent=15.0, temp_c=52.0, mem_percent=12.5, hotspot_c=0.0, mem_temp_c=0.0),
+            net=NetSnapshot(rx_kbps=1024, tx_kbps=512),
+            disk=DiskSnapshot(read_kBps=2048, write_kBps=1024),
+        )
+    )
+
+
+def test_topic_for_host_v3():
+    assert topic_for_host("desk") == "sys/agents/desk/metrics/v3"
+
+
+def test_encode_matches_firmware_example():
+    assert encode_frame(example_payload()) == DOC_EXAMPLE
+    assert len(DOC_EXAMPLE) == 37
+
+
+def test_decode_example():
+    frame = decode_frame(DOC_EXAMPLE)
+    assert frame["present"] == ALL_FIELDS
+    assert frame["ts"] == 1739999999000 & 0xFFFFFFFF
+    assert frame["cpu"] == [42.4, 58.2]
+    assert frame["ram"] == [67.8, 12288, 32768]
+    assert frame["gpu"] == [15.0, 52.0, 12.5, 0.0, 0.0]
+    assert frame["net"] == [1024, 512]
+    assert frame["disk"] == [2048, 1024]
+
+
+def test_random_round_trip():
+    rng = random.Random(7)
+    for _ in range(2000):
+        payload = {
+            "ts": rng.randrange(0, 2**41),
+            "cpu": [round(rng.uniform(-3276.8, 3276.7), 1) for _ in range(2)],
+            "ram": [round(rng.uniform(0, 100), 1), rng.randrange(65536), rng.randrange(65536)],
+            "gpu": [round(rng.uniform(-3276.8, 3276.7), 1) for _ in range(5)],
+            "net": [rng.randrange(65536) for _ in range(2)],
+            "disk": [rng.randrange(65536) for _ in range(2)],
+        }
+        for key in ("cpu", "ram", "gpu", "net", "disk"):
+            payload[key] = [None if rng.random() < 0.1 else v for v in payload[key]]
+
+        frame = decode_frame(encode_frame(payload))
+        assert frame["ts"] == payload["ts"] & 0xFFFFFFFF
+        for key in ("cpu", "ram", "gpu", "net", "disk"):
+            assert frame[key] == payload[key]
+
+
+def test_values_are_rounded_and_clamped():
+    frame = decode_frame(encode_frame({"cpu": [0.05, 99999], "net": [-5, 70000.4]}))
+    assert frame["cpu"] == [0.1, 3276.7]
+    assert frame["net"] == [0, 65535]
+    assert frame["ram"] == [None, None, None]
+
+
+def test_rejects_corruption():
+    for bit in range(len(DOC_EXAMPLE) * 8):
+        data = bytearray(DOC_EXAMPLE)
+        data[bit // 8] ^= 1 << (bit % 8)
+        with pytest.raises(FrameError):
+            decode_frame(bytes(data))
+    for length in range(len(DOC_EXAMPLE)):
+        with pytest.raises(FrameError):
+            decode_frame(DOC_EXAMPLE[:length])
+    with pytest.raises(FrameError):
+        encode_frame(example_payload(), present=1 << 15)
+
+
+def test_delta_matches_firmware_example():
+    payload = example_payload()
+    payload["ts"] += 1000
+    payload["cpu"][0] = 43.1
+    payload["net"][0] = 2048
+    assert encode_frame(payload, 0b100_0000_0001, flags=FLAG_DELTA, seq=8, key_seq=7) == DOC_DELTA_EXAMPLE
+
+    frame = decode_frame(DOC_DELTA_EXAMPLE)
+    assert (frame["flags"], frame["seq"], frame["key_seq"]) == (FLAG_DELTA, 8, 7)
+    assert frame["cpu"] == [43.1, None]
+    assert frame["net"] == [2048, None]
+
+
+def test_delta_encoder_sends_changed_fields_against_keyframe():
+    encoder = DeltaEncoder(keyframe_interval=3)
+    payload = example_payload()
+    frames = []
+    for step in range(7):
+        payload = {**payload, "ts": payload["ts"] + 1000, "cpu": [40.0 + step, 58.2]}
+        frames.append(decode_frame(encoder.encode(payload)))
+
+    assert [f["flags"] for f in frames] == [FLAG_KEYFRAME, FLAG_DELTA, FLAG_DELTA] * 2 + [FLAG_KEYFRAME]
+    assert [f["seq"] for f in frames] == list(range(7))
+    assert [f["key_seq"] for f in frames] == [0, 0, 0, 3, 3, 3, 6]
+    assert frames[0]["present"] == ALL_FIELDS
+    assert frames[1]["present"] == 1 and frames[1]["cpu"] == [41.0, None]
+
+    # Reverting to the keyframe value leaves the field out of the delta.
+    encoder = DeltaEncoder(keyframe_interval=10)
+    encoder.encode(example_payload())
+    assert decode_frame(encoder.encode(example_payload()))["present"] == 0
+
+
+def test_rejects_bad_sequenced_frames():
+    with pytest.raises(FrameError):
+        encode_frame(example_payload(), flags=FLAG_KEYFRAME | FLAG_DELTA)
+    keyframe = bytearray(encode_frame(example_payload(), flags=FLAG_KEYFRAME, seq=9))
+    assert decode_frame(bytes(keyframe))["key_seq"] == 9
+    keyframe[8] = 3
+    keyframe[-2:] = crc16_ccitt(bytes(keyframe[:-2])).to_bytes(2, "little")
+    with pytest.raises(FrameError):
+        decode_frame(bytes(keyframe))
+
+
+def test_batch_matches_firmware_example():
+    assert topic_for_collector("rack") == "sys/agents/rack/metrics/batch"
+    desk = encode_frame(example_payload(), present=0b11)
+    batch = encode_batch([("desk", desk), ("nas", DOC_DELTA_EXAMPLE)], topic_for_collector("rack"))
+    assert batch == [DOC_BATCH_EXAMPLE]
+
+    entries = decode_batch(DOC_BATCH_EXAMPLE)
+    assert [name for name, _ in entries] == ["desk", "nas"]
+    assert entries[0][1] == decode_frame(desk)
+    assert entries[1][1] == decode_frame(DOC_DELTA_EXAMPLE)
+
+
+def publish_packet_size(topic: str, payload: bytes) -> int:
+    remaining = 2 + len(topic.encode("utf-8")) + len(payload)
+    length_bytes = 1
+    while remaining >= 128 ** length_bytes:
+        length_bytes += 1
+    return 1 + length_bytes + remaining
+
+
+def test_batch_splits_to_fit_client_buffer():
+    topic = topic_for_collector("rack")
+    assert payload_budget(topic) == CLIENT_BUFFER_BYTES - 7 - len(topic)
+    full = encode_frame(example_payload())
+    entries = [(f"host-{i:02}", full) for i in range(40)]
+    messages = encode_batch(entries, topic)
+    assert len(messages) == 2
+    assert all(publish_packet_size(topic, m) <= CLIENT_BUFFER_BYTES for m in messages)
+    decoded = [entry for m in messages for entry in decode_batch(m)]
+    assert [name for name, _ in decoded] == [name for name, _ in entries]
+    assert all(frame == decode_frame(full) for _, frame in decoded)
+
+    assert [m[1] for m in encode_batch(entries, topic, buffer_size=200 + 7 + len(topic))] == [4] * 10
+    assert len(encode_batch([("h", DOC_DELTA_EXAMPLE)] * (BATCH_MAX_HOSTS + 1), topic)) == 2
+    assert encode_batch([], topic) == []
+    with pytest.raises(FrameError):
+        encode_batch([("a/b", full)], topic)
+    with pytest.raises(FrameError):
+        encode_batch([("desk", full)], topic, buffer_size=40 + 7 + len(topic))
+
+
+def test_full_batch_fits_client_buffer():
+    # Longest collector name and keyframes with 31-byte hostnames fill the buffer exactly as the firmware sees it.
+    topic = topic_for_collector("c" * 31)
+    keyframe = encode_frame(example_payload(), flags=FLAG_KEYFRAME, seq=1)
+    entries = [(f"{i:02}" + "h" * 29, keyframe) for i in range(BATCH_MAX_HOSTS)]
+    messages = encode_batch(entries, topic)
+    assert len(messages) > 1
+    entry_bytes = 1 + 31 + len(keyframe) - 2
+    for m in messages:
+        size = publish_packet_size(topic, m)
+        assert size <= CLIENT_BUFFER_BYTES
+        if m is not messages[-1]:
+            assert size + entry_bytes > CLIENT_BUFFER_BYTES
+
+
+def test_batch_rejects_corruption():
+    for bit in range(len(DOC_BATCH_EXAMPLE) * 8):
+        data = bytearray(DOC_BATCH_EXAMPLE)
+        data[bit // 8] ^= 1 << (bit % 8)
+        with pytest.raises(FrameError):
+            decode_batch(bytes(data))
+    for length in range(len(DOC_BATCH_EXAMPLE)):
+        with pytest.raises(FrameError):
+            decode_batch(DOC_BATCH_EXAMPLE[:length])
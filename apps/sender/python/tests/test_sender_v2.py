@@ -0,0 +1,24 @@
+from __future__ import annotations
+
+import metrics_v3
+import sender_v2
+
+
+class FakeClient:
+    on_connect = None
+
+
+def test_reconnect_forces_keyframe():
+    encoder = metrics_v3.DeltaEncoder(keyframe_interval=10)
+    client = FakeClient()
+    sender_v2.force_keyframe_on_connect(client, encoder)
+
+    payload = {"ts": 0, "cpu": [1.0, 2.0]}
+    flags = [metrics_v3.decode_frame(encoder.encode(payload))["flags"] for _ in range(3)]
+    assert flags == [metrics_v3.FLAG_KEYFRAME, metrics_v3.FLAG_DELTA, metrics_v3.FLAG_DELTA]
+
+    # paho v1 and v2 pass different callback arguments.
+    client.on_connect(client, None, {}, 0)
+    assert metrics_v3.decode_frame(encoder.encode(payload))["flags"] == metrics_v3.FLAG_KEYFRAME
+    client.on_connect(client, None, {}, 0, None)
+    assert metrics_v3.decode_frame(encoder.encode(payload))["flags"] == metrics_v3.FLAG_KEYFRAME